@@ -0,0 +1,1338 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Benchmark.cpp
+ * Benchmarks of the Systolic library.
+ * Usage: systolic_bench [--small] [SECTION…], running every section when none is given.
+ * --small divides the sizes by 64, as to check the results quickly; any failed check makes the run fail.
+ */
+
+#include "Systolic/Systolic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	/* Seconds elapsed while running the given function. */
+	double measure(const std::function<void()> &func)
+	{
+		Clock::time_point start = Clock::now();
+
+		func();
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	/* Checks that failed, any of them failing the run. */
+	std::size_t failures = 0;
+
+	/* Set by --small, dividing the sizes as to only check the results. */
+	bool small = false;
+
+	std::size_t scaled(const std::size_t size)
+	{
+		return (small ? std::max<std::size_t>(size / 64, 1) : size);
+	}
+
+	/* Mark ending a line of results, counting a failed check. */
+	const char *mark(const bool passed)
+	{
+		failures += !passed;
+		return (passed ? "" : "  MISMATCH");
+	}
+
+	/* Outcome of a check printed on its own. */
+	const char *verdict(const bool passed)
+	{
+		failures += !passed;
+		return (passed ? "ok" : "MISMATCH");
+	}
+
+	std::vector<int> randomValues(const std::size_t count, const int min, const int max)
+	{
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<int> dist(min, max);
+		std::vector<int> res(count);
+
+		for (int &value : res) {
+			value = dist(gen);
+		}
+		return res;
+	}
+
+	std::queue<int> toQueue(const std::vector<int> &values)
+	{
+		std::queue<int> res;
+
+		for (int value : values) {
+			res.push(value);
+		}
+		return res;
+	}
+
+	std::shared_ptr<Systolic::CellArrayBuilder> polynomial(const std::vector<int> &coefs)
+	{
+		return Systolic::CellArrayBuilder::getNew()->fromPolynomialCoefs(toQueue(coefs));
+	}
+
+	/* Cycles of inputs going through cells which hold their results until the next cell takes them, cycle by cycle. */
+	std::size_t simulateCycles(const std::vector<Systolic::CellCost> &costs, const std::size_t inputs)
+	{
+		std::vector<std::deque<std::size_t>> held(costs.size()); // Cycle each X held by a cell is ready, oldest first.
+		std::vector<std::size_t> next(costs.size(), 0); // First cycle each cell takes an X at.
+		std::size_t offered = 0;
+		std::size_t done = 0;
+		std::size_t last = 0;
+
+		for (std::size_t cycle = 0; done != inputs; cycle++) {
+			for (std::size_t i = costs.size(); i-- != 0;) { // From the last cell, as an X leaving a cell frees it for the previous one.
+				const std::size_t capacity = (costs[i].latency + costs[i].interval - 1) / costs[i].interval;
+
+				for (; i + 1 == costs.size() && !held[i].empty() && held[i].front() <= cycle; done++) {
+					held[i].pop_front();
+					last = cycle;
+				}
+				if (cycle < next[i] || held[i].size() == capacity) {
+					continue;
+				}
+				if (i == 0 && offered != inputs && offered <= cycle) { // One X offered to the chain per cycle.
+					offered++;
+				} else if (i != 0 && !held[i - 1].empty() && held[i - 1].front() <= cycle) {
+					held[i - 1].pop_front();
+				} else {
+					continue;
+				}
+				held[i].push_back(cycle + costs[i].latency);
+				next[i] = cycle + costs[i].interval;
+			}
+		}
+		return last;
+	}
+
+	/* Time needed to drain every input, without the cost of logging. */
+	template <typename C>
+	double run(C &container, const std::size_t inputs)
+	{
+		return measure([&]{
+				while (container.getOutputView().size() != inputs) {
+					container.step();
+				}
+			});
+	}
+
+	/* Number of steps until the first output. */
+	template <typename C>
+	std::size_t latencyOf(C &container)
+	{
+		std::size_t steps = 0;
+
+		while (container.getOutputView().empty()) {
+			container.step();
+			steps++;
+		}
+		return steps;
+	}
+
+	/* Linear Horner's array against the Estrin's scheme tree. */
+	void benchEstrin()
+	{
+		const std::size_t inputCount = 256;
+		std::vector<int> xs = randomValues(inputCount, -3, 3);
+
+		std::cout << "== estrin: linear Horner's array vs Estrin's tree (" << inputCount << " inputs)" << std::endl
+			  << std::setw(8) << "degree"
+			  << std::setw(16) << "linear steps" << std::setw(16) << "tree steps"
+			  << std::setw(18) << "linear x/s" << std::setw(18) << "tree x/s" << std::endl;
+		for (std::size_t degree : {15, 63, 255}) {
+			std::vector<int> coefs = randomValues(degree + 1, -9, 9);
+			Systolic::Container linearProbe({xs[0]});
+			Systolic::TreeContainer treeProbe({xs[0]});
+			Systolic::Container linear(toQueue(xs));
+			Systolic::TreeContainer tree(toQueue(xs));
+
+			linearProbe.setCells(polynomial(coefs));
+			treeProbe.setCells(polynomial(coefs));
+			linear.setCells(polynomial(coefs));
+			tree.setCells(polynomial(coefs));
+
+			double linearSeconds = run(linear, inputCount);
+			double treeSeconds = run(tree, inputCount);
+
+			std::cout << std::setw(8) << degree
+				  << std::setw(16) << latencyOf(linearProbe) << std::setw(16) << latencyOf(treeProbe)
+				  << std::setw(18) << std::fixed << std::setprecision(0) << inputCount / linearSeconds
+				  << std::setw(18) << inputCount / treeSeconds
+				  << mark(linear.getOutputs() == tree.getOutputs())
+				  << std::endl;
+		}
+	}
+
+	/* Horner's method against the multipoint evaluation, checked against the simulation. */
+	void benchMultipoint()
+	{
+		using Systolic::Backend::PolynomialEvaluator;
+
+		std::vector<int> checkCoefs = randomValues(101, -1000000, 1000000);
+		std::vector<int> checkXs = randomValues(300, -100000, 100000);
+		Systolic::Container simulation(toQueue(checkXs));
+		std::vector<int> simulated;
+
+		simulation.setCells(polynomial(checkCoefs));
+		run(simulation, checkXs.size());
+		for (std::queue<int> outputs = simulation.getOutputs(); !outputs.empty(); outputs.pop()) {
+			simulated.push_back(outputs.front());
+		}
+		std::cout << "== multipoint: Horner's method vs subproduct tree" << std::endl
+			  << "simulation check (degree 100, 300 X): "
+			  << verdict(PolynomialEvaluator::evaluateMultipoint(checkCoefs, checkXs) == simulated)
+			  << std::endl
+			  << std::setw(10) << "degree" << std::setw(10) << "X count"
+			  << std::setw(14) << "horner s" << std::setw(14) << "multipoint s" << std::endl;
+		for (std::size_t size : {scaled(2048), scaled(16384), scaled(131072), scaled(262144)}) {
+			std::vector<int> coefs = randomValues(size + 1, -1000000, 1000000);
+			std::vector<int> xs = randomValues(size, -1000000, 1000000);
+			std::vector<int> horner;
+			std::vector<int> multipoint;
+			double hornerSeconds = measure([&]{ horner = PolynomialEvaluator::evaluateHorner(coefs, xs); });
+			double multipointSeconds = measure([&]{ multipoint = PolynomialEvaluator::evaluateMultipoint(coefs, xs); });
+
+			std::cout << std::setw(10) << size << std::setw(10) << xs.size()
+				  << std::setw(14) << std::fixed << std::setprecision(3) << hornerSeconds
+				  << std::setw(14) << multipointSeconds
+				  << mark(horner == multipoint)
+				  << std::endl;
+		}
+	}
+
+	std::vector<std::vector<int>> randomMatrix(const std::size_t rows, const std::size_t cols)
+	{
+		std::vector<int> values = randomValues(rows * cols, -100, 100);
+		std::vector<std::vector<int>> res;
+
+		for (std::size_t i = 0; i != rows; i++) {
+			res.emplace_back(values.begin() + i * cols, values.begin() + (i + 1) * cols);
+		}
+		return res;
+	}
+
+	/* Matrix multiplication on both grid dataflows, simulated and batched, in GOPS. */
+	void benchGemm()
+	{
+		const std::vector<std::size_t> sizes = (small ? std::vector<std::size_t>{16, 64} : std::vector<std::size_t>{16, 64, 512});
+
+		std::cout << "== gemm: output and weight stationary grids" << std::endl
+			  << std::setw(8) << "size" << std::setw(10) << "dataflow"
+			  << std::setw(16) << "simulated GOPS" << std::setw(14) << "batch GOPS" << std::endl;
+		for (std::size_t size : sizes) {
+			std::vector<std::vector<int>> lhs = randomMatrix(size, size);
+			std::vector<std::vector<int>> rhs = randomMatrix(size, size);
+			std::vector<std::vector<int>> reference(size, std::vector<int>(size, 0));
+			const double ops = 2.0 * size * size * size;
+
+			for (std::size_t i = 0; i != size; i++) {
+				for (std::size_t k = 0; k != size; k++) {
+					for (std::size_t j = 0; j != size; j++) {
+						reference[i][j] += lhs[i][k] * rhs[k][j];
+					}
+				}
+			}
+			for (bool weightStationary : {false, true}) {
+				auto builder = [&]{
+					return (weightStationary ? Systolic::GridBuilder::getNew()->weightStationary(rhs)
+						: Systolic::GridBuilder::getNew()->outputStationary(size, size));
+				};
+				Systolic::Grid simulated(lhs, rhs);
+				Systolic::Grid batch(lhs, rhs);
+				std::string simulatedGops = "-";
+				bool valid = true;
+
+				if (size <= 64) { // The simulation starts a thread per row and step.
+					simulated.setCells(builder());
+					double seconds = measure([&]{ while (!simulated.isDone()) { simulated.step(); } });
+					std::stringstream ss;
+
+					ss << std::fixed << std::setprecision(4) << ops / seconds / 1e9;
+					simulatedGops = ss.str();
+					valid = (simulated.getResult() == reference);
+				}
+				batch.setCells(builder());
+				double seconds = measure([&]{ batch.computeBatch(); });
+
+				std::cout << std::setw(8) << size << std::setw(10) << (weightStationary ? "WS" : "OS")
+					  << std::setw(16) << simulatedGops
+					  << std::setw(14) << std::fixed << std::setprecision(2) << ops / seconds / 1e9
+					  << mark(valid && batch.getResult() == reference)
+					  << std::endl;
+			}
+		}
+	}
+
+	/* Each sample fed through every cell of the chain, one virtual call per tap and sample. */
+	std::vector<int> cellByCell(std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells, const std::vector<int> &samples)
+	{
+		std::vector<int> res;
+
+		for (int sample : samples) {
+			std::tuple<std::optional<int>, std::optional<int>> token = std::make_tuple(std::nullopt, sample);
+
+			for (std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+				cell->feed(token);
+				token = cell->compute();
+			}
+			res.push_back(std::get<0>(token).value());
+		}
+		return res;
+	}
+
+	/* FIR chains run cell by cell against the streaming filter, in millions of samples per second. */
+	void benchFir()
+	{
+		std::vector<int> checkTaps = randomValues(16, -1000, 1000);
+		std::vector<int> checkSamples = randomValues(200, -100000, 100000);
+		Systolic::Container simulation(toQueue(checkSamples));
+		Systolic::Backend::FirFilter checkFilter(checkTaps);
+		std::vector<int> simulated;
+		std::vector<int> streamed = checkFilter.process(std::vector<int>(checkSamples.begin(), checkSamples.begin() + 77));
+		std::vector<int> tail = checkFilter.process(std::vector<int>(checkSamples.begin() + 77, checkSamples.end()));
+
+		simulation.setCells(Systolic::CellArrayBuilder::getNew()->fromFirTaps(toQueue(checkTaps)));
+		run(simulation, checkSamples.size());
+		for (std::queue<int> outputs = simulation.getOutputs(); !outputs.empty(); outputs.pop()) {
+			simulated.push_back(outputs.front());
+		}
+		streamed.insert(streamed.end(), tail.begin(), tail.end());
+		std::cout << "== fir: chain of FIR cells vs streaming filter" << std::endl
+			  << "simulation check (16 taps, 200 samples in 2 chunks): "
+			  << verdict(streamed == simulated) << std::endl
+			  << std::setw(8) << "taps"
+			  << std::setw(16) << "cells MS/s" << std::setw(16) << "filter MS/s" << std::setw(14) << "filter GMAC/s"
+			  << std::endl;
+		for (std::size_t tapCount : {8, 64, 512, 4096}) {
+			std::vector<int> taps = randomValues(tapCount, -1000, 1000);
+			std::vector<int> samples = randomValues(scaled(std::min<std::size_t>(1 << 20, (1 << 28) / tapCount)), -100000, 100000);
+			std::vector<int> prefix(samples.begin(), samples.begin() + std::min(samples.size(), scaled((1 << 22) / tapCount)));
+			std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells =
+				Systolic::CellArrayBuilder::getNew()->fromFirTaps(toQueue(taps))->build();
+			Systolic::Backend::FirFilter filter(taps);
+			std::vector<int> byCell;
+			std::vector<int> filtered;
+			double cellSeconds = measure([&]{ byCell = cellByCell(cells, prefix); });
+			double filterSeconds = measure([&]{ filtered = filter.process(samples); });
+
+			std::cout << std::setw(8) << tapCount
+				  << std::setw(16) << std::fixed << std::setprecision(2) << prefix.size() / cellSeconds / 1e6
+				  << std::setw(16) << samples.size() / filterSeconds / 1e6
+				  << std::setw(14) << samples.size() * tapCount / filterSeconds / 1e9
+				  << mark(std::equal(byCell.begin(), byCell.end(), filtered.begin()))
+				  << std::endl;
+		}
+	}
+
+	/* Both sorting arrays, simulated and batched, against std::sort and std::partial_sort. */
+	void benchSort()
+	{
+		std::vector<int> small = randomValues(256, -1000, 1000);
+		std::vector<int> sortedSmall = small;
+
+		std::sort(sortedSmall.begin(), sortedSmall.end());
+		std::cout << "== sort: sorting arrays vs std::sort" << std::endl;
+		for (Systolic::Sorting sorting : {Systolic::Sorting::OddEvenTransposition, Systolic::Sorting::PriorityQueue}) {
+			Systolic::SortArray simulated(toQueue(small), sorting);
+			std::vector<int> outputs;
+			double seconds = measure([&]{ while (!simulated.isDone()) { simulated.step(); } });
+
+			for (std::queue<int> queue = simulated.getOutputs(); !queue.empty(); queue.pop()) {
+				outputs.push_back(queue.front());
+			}
+			std::cout << (sorting == Systolic::Sorting::PriorityQueue ? "priority queue" : "odd-even transposition")
+				  << " simulation (256 entries): " << std::fixed << std::setprecision(3) << seconds << " s"
+				  << mark(outputs == sortedSmall) << std::endl;
+		}
+		std::cout << std::setw(10) << "entries" << std::setw(8) << "k"
+			  << std::setw(14) << "batch ME/s" << std::setw(14) << "std ME/s" << std::endl;
+		for (std::size_t count : {scaled(100000), scaled(1000000), scaled(10000000)}) {
+			std::vector<int> values = randomValues(count, -1000000000, 1000000000);
+
+			for (std::size_t k : {std::size_t(0), std::size_t(100)}) {
+				Systolic::SortArray batch(toQueue(values), Systolic::Sorting::PriorityQueue, k);
+				std::vector<int> reference = values;
+				std::vector<int> outputs;
+				double batchSeconds = measure([&]{ batch.computeBatch(); });
+				double stdSeconds = measure([&]{
+						if (k == 0) {
+							std::sort(reference.begin(), reference.end());
+						} else {
+							std::partial_sort(reference.begin(), reference.begin() + k, reference.end());
+							reference.resize(k);
+						}
+					});
+
+				for (std::queue<int> queue = batch.getOutputs(); !queue.empty(); queue.pop()) {
+					outputs.push_back(queue.front());
+				}
+				std::cout << std::setw(10) << count << std::setw(8) << (k == 0 ? "all" : std::to_string(k))
+					  << std::setw(14) << std::fixed << std::setprecision(2) << count / batchSeconds / 1e6
+					  << std::setw(14) << count / stdSeconds / 1e6
+					  << mark(outputs == reference) << std::endl;
+			}
+		}
+	}
+
+	std::vector<std::vector<int>> denseProduct(const std::vector<std::vector<int>> &matrix,
+						   const std::vector<std::vector<int>> &vectors)
+	{
+		std::vector<std::vector<int>> res(vectors.size(), std::vector<int>(matrix.size(), 0));
+
+		for (std::size_t v = 0; v != vectors.size(); v++) {
+			for (std::size_t i = 0; i != matrix.size(); i++) {
+				for (std::size_t j = 0; j != matrix[i].size(); j++) {
+					res[v][i] += matrix[i][j] * vectors[v][j];
+				}
+			}
+		}
+		return res;
+	}
+
+	/* Band matrix-vector products, simulated and batched, checked against dense products. */
+	void benchBand()
+	{
+		std::cout << "== band: bidirectional array for band matrix-vector products" << std::endl;
+		for (std::size_t lower : {0, 1, 3}) {
+			std::vector<std::vector<int>> matrix = randomMatrix(24, 20);
+			std::vector<std::vector<int>> vectors = {randomValues(20, -100, 100), randomValues(20, -50, 50)};
+
+			for (std::size_t i = 0; i != matrix.size(); i++) { // Keeps lower diagonals below and 2 above the main one.
+				for (std::size_t j = 0; j != matrix[i].size(); j++) {
+					if (i > j + lower || j > i + 2) {
+						matrix[i][j] = 0;
+					}
+				}
+			}
+
+			Systolic::BidirectionalContainer simulated(vectors);
+			Systolic::BidirectionalContainer batch(vectors);
+			std::vector<std::vector<int>> reference = denseProduct(matrix, vectors);
+
+			simulated.setCells(Systolic::BandBuilder::getNew()->fromDense(matrix));
+			batch.setCells(Systolic::BandBuilder::getNew()->fromDense(matrix));
+			while (!simulated.isDone()) {
+				simulated.step();
+			}
+			batch.computeBatch();
+			std::cout << "dense check (24x20, " << lower + 3 << " diagonals): "
+				  << verdict(simulated.getResult() == reference && batch.getResult() == reference)
+				  << std::endl;
+		}
+		std::cout << std::setw(10) << "rows" << std::setw(10) << "width" << std::setw(10) << "vectors"
+			  << std::setw(14) << "batch GOPS" << std::endl;
+		for (std::size_t rows : {scaled(4096), scaled(65536)}) {
+			for (std::size_t width : {3, 15, 63}) {
+				std::vector<std::vector<int>> diagonals;
+				std::vector<std::vector<int>> vectors;
+				const std::size_t count = 64;
+
+				for (std::size_t k = 0; k != width; k++) {
+					diagonals.push_back(randomValues(rows, -100, 100));
+				}
+				for (std::size_t v = 0; v != count; v++) {
+					vectors.push_back(randomValues(rows, -100, 100));
+				}
+
+				Systolic::BidirectionalContainer batch(vectors);
+
+				batch.setCells(Systolic::BandBuilder::getNew()->fromDiagonals(diagonals, static_cast<int>(width / 2)));
+				double seconds = measure([&]{ batch.computeBatch(); });
+
+				std::cout << std::setw(10) << rows << std::setw(10) << width << std::setw(10) << count
+					  << std::setw(14) << std::fixed << std::setprecision(2)
+					  << 2.0 * rows * width * count / seconds / 1e9 << std::endl;
+			}
+		}
+	}
+
+	/* Changing one coefficient of a large polynomial, evaluated again or updated from the kept results. */
+	void benchIncremental()
+	{
+		const std::size_t degree = scaled(16384);
+		std::vector<int> coefs = randomValues(degree + 1, -1000000, 1000000);
+		std::vector<int> xs = randomValues(scaled(65536), -1000000, 1000000);
+		std::vector<int> changes = randomValues(8, 0, degree);
+		Systolic::Container container(toQueue(xs));
+		double fullSeconds = 0;
+		double updateSeconds = 0;
+		bool valid = true;
+
+		container.setCells(polynomial(coefs));
+		container.setIncremental(true);
+		container.computeBatch();
+		std::cout << "== incremental: coefficient change on degree " << degree << ", " << xs.size() << " X" << std::endl
+			  << std::setw(8) << "index" << std::setw(14) << "full s" << std::setw(14) << "update s" << std::endl;
+		for (std::size_t i = 0; i != changes.size() * 2; i++) {
+			const std::size_t index = changes[i % changes.size()]; // Each index is changed twice, the second time with cached powers.
+			std::vector<int> full;
+			std::vector<int> updated;
+
+			coefs[index] = randomValues(i + 1, -1000000, 1000000).back();
+			double seconds = measure([&]{ container.setCoef(index, coefs[index]); });
+			double evaluation = measure([&]{ full = Systolic::Backend::PolynomialEvaluator::evaluate(coefs, xs); });
+
+			fullSeconds += evaluation;
+			updateSeconds += seconds;
+			for (std::queue<int> outputs = container.getOutputs(); !outputs.empty(); outputs.pop()) {
+				updated.push_back(outputs.front());
+			}
+			valid = valid && (updated == full);
+			std::cout << std::setw(8) << index << std::setw(14) << std::fixed << std::setprecision(5)
+				  << evaluation << std::setw(14) << seconds << mark(updated == full)
+				  << std::endl;
+		}
+		std::cout << "mean speedup: " << std::setprecision(1) << fullSeconds / updateSeconds
+			  << mark(valid) << std::endl;
+	}
+
+	/* Streams of quantized values, with and without the result cache. */
+	void benchMemo()
+	{
+		const std::size_t count = scaled(1000000);
+		std::vector<int> levels = randomValues(4096, -2000000000, 2000000000);
+		std::vector<int> indexes = randomValues(count, 0, 4095);
+		std::vector<int> dense(count);
+		std::vector<int> sparse(count);
+		auto arithmetic = []{
+			return Systolic::CellArrayBuilder::getNew()
+				->add(Systolic::Cell::Types::Addition, 3)
+				->add(Systolic::Cell::Types::Multiplication, 7)
+				->add(Systolic::Cell::Types::Power, 3)
+				->add(Systolic::Cell::Types::Custom, [](const int x) { return x ^ (x >> 3); })
+				->add(Systolic::Cell::Types::Division, 5);
+		};
+
+		for (std::size_t i = 0; i != count; i++) {
+			dense[i] = indexes[i] - 2048; // 4096 levels around 0.
+			sparse[i] = levels[indexes[i]]; // 4096 levels over the whole range of int.
+		}
+		std::cout << "== memo: " << count << " inputs over 4096 distinct values" << std::endl
+			  << std::setw(12) << "chain" << std::setw(10) << "domain"
+			  << std::setw(14) << "plain s" << std::setw(14) << "cached s" << std::setw(12) << "hit rate" << std::endl;
+		for (bool polynomialChain : {false, true}) {
+			for (bool wide : {false, true}) {
+				const std::vector<int> &xs = (wide ? sparse : dense);
+				Systolic::Container plain(toQueue(xs));
+				Systolic::Container cached(toQueue(xs));
+
+				plain.setCells(polynomialChain ? polynomial(randomValues(64, -9, 9)) : arithmetic());
+				cached.setCells(polynomialChain ? polynomial(randomValues(64, -9, 9)) : arithmetic());
+				cached.setCache(std::make_shared<Systolic::ResultCache>());
+
+				double plainSeconds = measure([&]{ plain.computeBatch(); });
+				double cachedSeconds = measure([&]{ cached.computeBatch(); });
+
+				std::cout << std::setw(12) << (polynomialChain ? "polynomial" : "arithmetic")
+					  << std::setw(10) << (wide ? "wide" : "dense")
+					  << std::setw(14) << std::fixed << std::setprecision(4) << plainSeconds
+					  << std::setw(14) << cachedSeconds
+					  << std::setw(12) << std::setprecision(4) << cached.getStats().getHitRate()
+					  << mark(plain.getOutputs() == cached.getOutputs()) << std::endl;
+			}
+		}
+	}
+
+	void benchNewton()
+	{
+		const std::size_t count = scaled(1000000);
+		const std::size_t degree = 32;
+		const std::vector<int> coefs = randomValues(degree + 1, -9, 9);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		std::vector<int> derivativeCoefs;
+
+		for (std::size_t i = 0; i != degree; i++) {
+			derivativeCoefs.push_back(coefs[i] * static_cast<int>(degree - i));
+		}
+
+		Systolic::Container values(toQueue(xs));
+		Systolic::Container derivatives(toQueue(xs));
+		Systolic::Container dual(toQueue(xs));
+
+		values.setCells(polynomial(coefs));
+		derivatives.setCells(polynomial(derivativeCoefs));
+		dual.setCells(Systolic::CellArrayBuilder::getNew()->fromPolynomialCoefs(toQueue(coefs), true));
+
+		double twoPasses = measure([&]{ values.computeBatch(); derivatives.computeBatch(); });
+		double onePass = measure([&]{ dual.computeBatch(); });
+
+		std::cout << "== newton: p and p' of degree " << degree << " over " << count << " X" << std::endl
+			  << std::setw(12) << "two chains" << std::setw(12) << "dual chain" << std::endl
+			  << std::setw(12) << std::fixed << std::setprecision(4) << twoPasses
+			  << std::setw(12) << onePass
+			  << mark(values.getOutputs() == dual.getOutputs() && derivatives.getOutputs() == dual.getAuxiliaryOutputs()) << std::endl;
+
+		/* (X - 7)(X + 3)(X - 100), from starting points small enough for p not to wrap around. */
+		const std::vector<int> cubic = {1, -104, 379, 2100};
+		const std::vector<int> starts = randomValues(count, -1000, 1000);
+		Systolic::Backend::NewtonSolver solver(cubic);
+		std::vector<Systolic::Backend::NewtonRoot> roots;
+		double seconds = measure([&]{ roots = solver.solve(starts); });
+		std::size_t converged = std::count_if(roots.begin(), roots.end(),
+						      [](const Systolic::Backend::NewtonRoot &root) { return root.converged; });
+		std::size_t iterations = 0;
+
+		for (const Systolic::Backend::NewtonRoot &root : roots) {
+			iterations += root.iterations;
+		}
+		std::cout << std::setw(12) << "starts" << std::setw(12) << "solve s"
+			  << std::setw(12) << "converged" << std::setw(12) << "mean iter" << std::endl
+			  << std::setw(12) << count << std::setw(12) << std::setprecision(4) << seconds
+			  << std::setw(12) << converged
+			  << std::setw(12) << std::setprecision(2) << static_cast<double>(iterations) / count << std::endl;
+	}
+
+	void benchWide()
+	{
+		const std::size_t count = scaled(200000);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+
+		std::cout << "== wide: M polynomials of degree 16 over " << count << " X" << std::endl
+			  << std::setw(6) << "M" << std::setw(16) << "containers s" << std::setw(12) << "wide s" << std::endl;
+		for (std::size_t width : {4, 16, 64}) {
+			const std::vector<int> all = randomValues(width * 17, -9, 9);
+			std::vector<std::vector<int>> matrix;
+			std::vector<std::queue<int>> separateOutputs;
+
+			for (std::size_t m = 0; m != width; m++) {
+				matrix.emplace_back(all.begin() + m * 17, all.begin() + (m + 1) * 17);
+			}
+
+			double separate = measure([&]{
+					for (const std::vector<int> &coefs : matrix) {
+						Systolic::Container container(toQueue(xs));
+
+						container.setCells(polynomial(coefs));
+						container.computeBatch();
+						separateOutputs.push_back(container.getOutputs());
+					}
+				});
+			Systolic::WideContainer wide(toQueue(xs));
+
+			wide.setCells(Systolic::CellArrayBuilder::getNew()->fromPolynomialMatrix(matrix));
+
+			double together = measure([&]{ wide.computeBatch(); });
+
+			std::cout << std::setw(6) << width
+				  << std::setw(16) << std::fixed << std::setprecision(4) << separate
+				  << std::setw(12) << together
+				  << mark(wide.getOutputs() == separateOutputs) << std::endl;
+		}
+	}
+
+	void benchHash()
+	{
+		const std::size_t size = scaled(std::size_t(64) << 20);
+		const std::size_t window = 48;
+		const std::string path = "systolic_bench_hash.bin";
+		std::vector<unsigned char> data(size);
+		std::vector<std::uint64_t> hashes(scaled(std::size_t(1) << 22));
+		std::mt19937 gen(42);
+
+		for (unsigned char &byte : data) {
+			byte = static_cast<unsigned char>(gen());
+		}
+		std::cout << "== hash: " << (size >> 20) << " MiB, windows of " << window << " bytes" << std::endl
+			  << std::setw(12) << "reduction" << std::setw(8) << "bits"
+			  << std::setw(14) << "scan GB/s" << std::setw(18) << "fingerprint GB/s" << std::endl;
+		for (Systolic::Backend::Reduction reduction : {Systolic::Backend::Reduction::Montgomery, Systolic::Backend::Reduction::Barrett}) {
+			for (std::uint64_t modulus : {std::uint64_t(2147483647), (std::uint64_t(1) << 61) - 1}) {
+				Systolic::Backend::RollingHash hash(257, modulus, window, reduction);
+				std::uint64_t fingerprint = 0;
+				double scanSeconds = measure([&]{
+						for (std::size_t first = 0; first < hash.getHashCount(size); first += hashes.size()) {
+							const std::size_t count = std::min(hashes.size(), hash.getHashCount(size) - first);
+
+							hash.scan(data.data() + first, count + window - 1, hashes.data());
+						}
+					});
+				double fingerprintSeconds = measure([&]{ fingerprint = hash.fingerprint(data.data(), size); });
+
+				std::cout << std::setw(12) << (reduction == Systolic::Backend::Reduction::Montgomery ? "montgomery" : "barrett")
+					  << std::setw(8) << (modulus >> 31 == 0 ? 32 : 64)
+					  << std::setw(14) << std::fixed << std::setprecision(3) << size / scanSeconds / 1e9
+					  << std::setw(18) << size / fingerprintSeconds / 1e9
+					  << mark(fingerprint < modulus) << std::endl;
+			}
+		}
+
+		/* Same scan, from a memory-mapped file. */
+		std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), size);
+
+		Systolic::Backend::RollingHash hash(257, (std::uint64_t(1) << 61) - 1, window);
+		std::uint64_t checksum = 0;
+		double fileSeconds = measure([&]{
+				hash.scanFile(path, [&](const std::size_t, const std::uint64_t *hashes, const std::size_t count) {
+						for (std::size_t i = 0; i != count; i++) {
+							checksum ^= hashes[i];
+						}
+					});
+			});
+
+		std::remove(path.c_str());
+		std::cout << std::setw(20) << "mapped file GB/s" << std::setw(14) << std::setprecision(3) << size / fileSeconds / 1e9
+			  << "  (checksum " << std::hex << checksum << std::dec << ")" << std::endl;
+	}
+
+	/* Ring buffers against std::queue, then the logged simulation they serve. */
+	void benchQueues()
+	{
+		const std::size_t count = scaled(1 << 22);
+		long long checksum = 0;
+
+		std::cout << "== queues: " << count << " pushes then pops" << std::endl;
+
+		double queueSeconds = measure([&]{
+				std::queue<int> queue;
+
+				for (std::size_t i = 0; i != count; i++) {
+					queue.push(static_cast<int>(i));
+				}
+				for (; !queue.empty(); queue.pop()) {
+					checksum += queue.front();
+				}
+			});
+		double ringSeconds = measure([&]{
+				Util::RingBuffer<int> ring(count);
+
+				for (std::size_t i = 0; i != count; i++) {
+					ring.push(static_cast<int>(i));
+				}
+				for (; !ring.empty(); ring.pop()) {
+					checksum -= ring.front();
+				}
+			});
+
+		std::cout << std::setw(20) << "std::queue s" << std::setw(12) << std::fixed << std::setprecision(4) << queueSeconds << std::endl
+			  << std::setw(20) << "RingBuffer s" << std::setw(12) << ringSeconds
+			  << mark(checksum == 0) << std::endl;
+
+		const std::vector<int> xs = randomValues(2000, -9, 9);
+		Systolic::Container logged(toQueue(xs));
+
+		logged.setCells(polynomial(randomValues(9, -9, 9)));
+
+		double loggedSeconds = measure([&]{ logged.compute(); });
+
+		std::cout << std::setw(20) << "logged compute s" << std::setw(12) << loggedSeconds
+			  << "  (" << xs.size() << " X, degree 8)" << std::endl;
+	}
+
+	/* Buffered writer against the standard streams, writing to the null device. */
+	void benchOutput()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::vector<int> values = randomValues(count, -1000000000, 1000000000);
+		const Util::RingView<int> view(values.data(), values.size(), nullptr, 0);
+#ifdef _WIN32
+		const std::string path = "NUL"; // Null device, as to measure the formatting rather than the disk.
+#else
+		const std::string path = "/dev/null";
+#endif
+
+		std::cout << "== output: " << count << " results" << std::endl
+			  << std::setw(14) << "writer" << std::setw(12) << "seconds" << std::setw(12) << "M val/s"
+			  << std::setw(10) << "MB/s" << std::endl;
+
+		const auto report = [&](const char *name, const double seconds, const std::size_t bytes) {
+			std::cout << std::setw(14) << name << std::setw(12) << std::fixed << std::setprecision(4) << seconds
+				  << std::setw(12) << std::setprecision(1) << count / seconds / 1e6
+				  << std::setw(10) << bytes / seconds / 1e6 << std::endl;
+		};
+		std::size_t streamBytes = 0;
+		double streamSeconds = measure([&]{
+				std::ofstream stream(path);
+
+				for (std::size_t i = 0; i != count; i++) {
+					stream << values[i] << (i + 1 != count ? "," : "");
+				}
+				stream << std::endl;
+				streamBytes = static_cast<std::size_t>(stream.tellp());
+				streamBytes = (streamBytes == static_cast<std::size_t>(-1) ? 0 : streamBytes); // Unknown on some devices.
+			});
+
+		report("ofstream <<", streamSeconds, streamBytes);
+		for (const char *format : {"comma", "newline", "csv", "binary"}) {
+			std::size_t bytes = 0;
+			double seconds = measure([&]{
+					Util::OutputWriter writer(Util::OutputWriter::parseFormat(format), path);
+
+					writer.write(view, view);
+					writer.flush();
+					bytes = writer.getWrittenBytes();
+				});
+
+			report(format, seconds, bytes);
+		}
+	}
+
+	/* Many small jobs, one after the other against the JobRunner. */
+	void benchJobs()
+	{
+		const std::size_t jobCount = scaled(2000);
+		std::vector<Systolic::Job> jobs(jobCount);
+		std::vector<std::vector<int>> sequential;
+
+		for (std::size_t j = 0; j != jobCount; j++) {
+			jobs[j].coefs = toQueue(randomValues(9, -9, static_cast<int>(j % 9)));
+			jobs[j].inputs = toQueue(randomValues(512, -1000, static_cast<int>(j)));
+		}
+		std::cout << "== jobs: " << jobCount << " jobs of degree 8 over 512 X" << std::endl;
+
+		double sequentialSeconds = measure([&]{
+				for (const Systolic::Job &job : jobs) {
+					Systolic::Container container(job.inputs);
+
+					container.setCells(Systolic::CellArrayBuilder::getNew()->fromPolynomialCoefs(job.coefs));
+					container.computeBatch();
+					sequential.push_back(container.getOutputView().toVector());
+				}
+			});
+		const Systolic::JobRunner runner;
+		std::vector<Systolic::JobResult> results;
+		double runnerSeconds = measure([&]{ results = runner.run(jobs); });
+		bool same = true;
+
+		for (std::size_t j = 0; j != jobCount; j++) {
+			same = same && results[j].outputs == sequential[j];
+		}
+		std::cout << std::setw(20) << "sequential s" << std::setw(12) << std::fixed << std::setprecision(4) << sequentialSeconds << std::endl
+			  << std::setw(20) << "runner s" << std::setw(12) << runnerSeconds
+			  << "  (" << runner.getWorkers() << " workers)" << mark(same) << std::endl;
+	}
+
+	/* Ticks dispatched by one std::async per cell against the scheduler, then many containers stepping at once. */
+	void benchScheduler()
+	{
+		Systolic::Backend::Scheduler &scheduler = Systolic::Backend::Scheduler::getInstance();
+		const std::vector<int> coefs = randomValues(17, -8, 8);
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells = polynomial(coefs)->build();
+		const std::size_t tickCount = scaled(2000);
+
+		std::cout << "== scheduler: " << scheduler.getWorkers() << " workers, degree 16" << std::endl;
+
+		double asyncSeconds = measure([&]{
+				for (std::size_t t = 0; t != tickCount; t++) {
+					std::vector<std::future<std::tuple<std::optional<int>, std::optional<int>>>> futures;
+
+					for (std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+						futures.push_back(std::async(std::launch::async, [&cell]{ return cell->compute(); }));
+					}
+					for (auto &future : futures) {
+						future.get();
+					}
+				}
+			});
+		double schedulerSeconds = measure([&]{
+				for (std::size_t t = 0; t != tickCount; t++) {
+					scheduler.parallelFor(cells.size(), [&](const std::size_t i){ cells[i]->compute(); });
+				}
+			});
+
+		std::cout << std::setw(20) << "async tick us" << std::setw(12) << std::fixed << std::setprecision(2)
+			  << asyncSeconds / tickCount * 1e6 << std::endl
+			  << std::setw(20) << "scheduler tick us" << std::setw(12) << schedulerSeconds / tickCount * 1e6 << std::endl;
+
+		const std::size_t containerCount = 64;
+		const std::vector<int> xs = randomValues(256, -1000, 1000);
+		std::vector<Systolic::Container> containers;
+		Systolic::Container expected(toQueue(xs));
+
+		for (std::size_t c = 0; c != containerCount; c++) {
+			containers.emplace_back(toQueue(xs));
+			containers.back().setCells(polynomial(coefs));
+		}
+		expected.setCells(polynomial(coefs));
+		expected.computeBatch();
+
+		const Systolic::Backend::SchedulerStats before = scheduler.getStats();
+		double steppedSeconds = measure([&]{
+				scheduler.parallelFor(containerCount, [&](const std::size_t c){
+						for (std::size_t t = 0; t != xs.size() + coefs.size(); t++) {
+							containers[c].step();
+						}
+					});
+			});
+		const Systolic::Backend::SchedulerStats after = scheduler.getStats();
+		bool same = true;
+
+		for (const Systolic::Container &container : containers) {
+			same = same && container.getOutputView() == expected.getOutputView();
+		}
+		std::cout << std::setw(20) << "containers s" << std::setw(12) << std::setprecision(4) << steppedSeconds
+			  << "  (" << containerCount << " stepped at once)" << mark(same) << std::endl
+			  << std::setw(20) << "tasks" << std::setw(12) << after.submitted - before.submitted
+			  << "  (stolen " << after.stolen - before.stolen << ", withdrawn " << after.withdrawn - before.withdrawn
+			  << ", max queue depth " << after.maxQueueDepth << ")" << std::endl;
+	}
+
+	/* A large batch computed at once against by tiles on the scheduler, then cancelled halfway. */
+	void benchAsync()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::size_t tileSize = scaled(1 << 16);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const std::vector<int> coefs = randomValues(17, -8, 8);
+		Systolic::Container batch(toQueue(xs));
+		Systolic::Container tiled(toQueue(xs));
+		Systolic::Container cancelled(toQueue(xs));
+		std::size_t reports = 0;
+		bool done = false;
+
+		batch.setCells(polynomial(coefs));
+		tiled.setCells(polynomial(coefs));
+		cancelled.setCells(polynomial(coefs));
+		std::cout << "== async: polynomial of degree 16 over " << count << " X, tiles of " << tileSize << std::endl;
+
+		double batchSeconds = measure([&]{ batch.computeBatch(); });
+		double tiledSeconds = measure([&]{
+				done = tiled.computeAsync([&](const Systolic::ComputeProgress &, const std::vector<int> &) { reports++; },
+							  Systolic::CancellationToken(), tileSize).get();
+			});
+		Systolic::CancellationToken token;
+		Clock::time_point cancelledAt;
+
+		cancelled.computeAsync([&](const Systolic::ComputeProgress &progress, const std::vector<int> &) {
+				if (progress.outputs >= count / 2 && !token.isCancelled()) {
+					cancelledAt = Clock::now();
+					token.cancel();
+				}
+			}, token, tileSize).get();
+		const double latency = std::chrono::duration<double>(Clock::now() - cancelledAt).count();
+
+		std::cout << std::setw(20) << "computeBatch s" << std::setw(12) << std::fixed << std::setprecision(4) << batchSeconds << std::endl
+			  << std::setw(20) << "computeAsync s" << std::setw(12) << tiledSeconds << "  (" << reports << " reports)"
+			  << mark(done && tiled.getOutputView() == batch.getOutputView()) << std::endl
+			  << std::setw(20) << "cancel latency s" << std::setw(12) << std::setprecision(6) << latency
+			  << "  (" << cancelled.getOutputView().size() << " outputs kept)" << std::endl;
+	}
+
+	/* Containers built from a copied queue against containers borrowing the inputs, construction included. */
+	void benchInputs()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const std::vector<int> coefs = randomValues(5, -8, 8);
+		std::queue<int> copiedOutputQueue;
+		std::queue<int> borrowedOutputQueue;
+
+		std::cout << "== inputs: polynomial of degree 4 over " << count << " X" << std::endl;
+
+		double copiedSeconds = measure([&]{
+				Systolic::Container copied(toQueue(xs));
+
+				copied.setCells(polynomial(coefs));
+				copied.computeBatch();
+				copiedOutputQueue = copied.getOutputs();
+			});
+		double borrowedSeconds = measure([&]{
+				Systolic::Container borrowed(xs);
+
+				borrowed.setCells(polynomial(coefs));
+				borrowed.computeBatch();
+				borrowedOutputQueue = borrowed.getOutputs();
+			});
+		const double copiedMb = 2.0 * count * sizeof(int) / 1e6; // The queue, then the ring buffer of the container.
+
+		std::cout << std::setw(20) << "queue s" << std::setw(12) << std::fixed << std::setprecision(4) << copiedSeconds
+			  << "  (" << std::setprecision(1) << copiedMb << " MB of inputs copied)" << std::endl
+			  << std::setw(20) << "borrowed s" << std::setw(12) << std::setprecision(4) << borrowedSeconds
+			  << "  (0.0 MB of inputs copied)"
+			  << mark(borrowedOutputQueue == copiedOutputQueue) << std::endl;
+	}
+
+	/* Three stages run one after the other, each draining the outputs of the previous one, then streamed by a Pipeline. */
+	void benchStages()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const std::vector<int> coefs = randomValues(33, -8, 8);
+		const std::vector<int> taps = randomValues(64, -8, 8);
+		const std::string normalization = "div 7 | add 1";
+		std::vector<int> sequentialOutputs;
+		std::vector<double> stageSeconds;
+
+		std::cout << "== stages: polynomial of degree 32, FIR of 64 taps then " << normalization << " over " << count << " X" << std::endl;
+
+		double sequentialSeconds = measure([&]{
+				Systolic::Container first(xs);
+
+				first.setCells(polynomial(coefs));
+				first.computeBatch();
+
+				const std::vector<int> firstOutputs = first.takeOutputs();
+				Systolic::Container second(firstOutputs);
+
+				second.setCells(Systolic::CellArrayBuilder::getNew()->fromFirTaps(toQueue(taps)));
+				second.computeBatch();
+
+				const std::vector<int> secondOutputs = second.takeOutputs();
+				Systolic::Container third(secondOutputs);
+
+				third.setCells(Systolic::CellArrayBuilder::getNew()->fromPipelineDescription(normalization));
+				third.computeBatch();
+				sequentialOutputs = third.takeOutputs();
+			});
+		bool same = false;
+		double streamedSeconds = measure([&]{
+				Systolic::Pipeline pipeline(xs.data(), xs.size());
+
+				pipeline.addStage(polynomial(coefs));
+				pipeline.addStage(Systolic::CellArrayBuilder::getNew()->fromFirTaps(toQueue(taps)));
+				pipeline.addStage(Systolic::CellArrayBuilder::getNew()->fromPipelineDescription(normalization));
+				pipeline.compute();
+				same = (pipeline.getOutputView().toVector() == sequentialOutputs);
+				stageSeconds = pipeline.getStageSeconds();
+			});
+
+		std::cout << std::setw(20) << "sequential s" << std::setw(12) << std::fixed << std::setprecision(4) << sequentialSeconds << std::endl
+			  << std::setw(20) << "pipeline s" << std::setw(12) << streamedSeconds << "  (stages:";
+		for (double seconds : stageSeconds) {
+			std::cout << " " << seconds;
+		}
+		std::cout << ")" << mark(same) << std::endl;
+	}
+
+	/* p(X) + q(X) from two containers and their outputs added, then from a graph running both branches at once. */
+	void benchGraph()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const std::vector<int> p = randomValues(33, -8, 8);
+		const std::vector<int> q = randomValues(17, -8, 8);
+		std::vector<int> sequentialOutputs;
+		std::size_t latency = 0;
+
+		std::cout << "== graph: polynomials of degree 32 and 16 added over " << count << " X" << std::endl;
+
+		double sequentialSeconds = measure([&]{
+				Systolic::Container first(xs);
+				Systolic::Container second(xs);
+
+				first.setCells(polynomial(p));
+				second.setCells(polynomial(q));
+				first.computeBatch();
+				second.computeBatch();
+				sequentialOutputs = first.takeOutputs();
+
+				const std::vector<int> secondOutputs = second.takeOutputs();
+
+				for (std::size_t i = 0; i != count; i++) {
+					sequentialOutputs[i] = static_cast<int>(static_cast<unsigned>(sequentialOutputs[i])
+										+ static_cast<unsigned>(secondOutputs[i]));
+				}
+			});
+		bool same = false;
+		double graphSeconds = measure([&]{
+				Systolic::Graph graph(xs.data(), xs.size());
+
+				graph.setNodes(Systolic::GraphBuilder::getNew()->parallel({polynomial(p), polynomial(q)}, Systolic::Merge::Sum));
+				graph.computeBatch();
+				same = (graph.getOutputView().toVector() == sequentialOutputs);
+				latency = graph.getLatency();
+			});
+
+		std::cout << std::setw(20) << "containers s" << std::setw(12) << std::fixed << std::setprecision(4) << sequentialSeconds << std::endl
+			  << std::setw(20) << "graph s" << std::setw(12) << graphSeconds << "  (latency: " << latency << " ticks)"
+			  << mark(same) << std::endl;
+	}
+
+	/* Cycles of 10^5 hardware cells over 10^6 X, divisions taking 16 cycles and powers being pipelined. */
+	void benchCost()
+	{
+		const std::size_t count = scaled(1000000);
+		const std::size_t stages = scaled(25000);
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const Systolic::CostModel model = Systolic::CostModel::fromDescription("div=16, pow=4/1, mul=3/1");
+		std::string description;
+		Systolic::CostReport report;
+
+		for (std::size_t i = 0; i != stages; i++) {
+			description += "add 1 | div 3 | pow 2 | mul 2\n";
+		}
+
+		Systolic::Container container(xs);
+
+		container.setCells(Systolic::CellArrayBuilder::getNew()->fromPipelineDescription(description));
+		std::cout << "== cost: " << 4 * stages << " cells over " << count << " X" << std::endl;
+
+		double seconds = measure([&]{ report = container.estimateCost(model); });
+
+		// The estimate against short chains run cycle by cycle, without buffers between their cells.
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<std::size_t> cycles(1, 8);
+		std::size_t mismatches = 0;
+
+		for (std::size_t chain = 0; chain != 1000; chain++) {
+			std::vector<Systolic::CellCost> costs(1 + chain % 6);
+
+			for (Systolic::CellCost &cost : costs) {
+				cost = {cycles(gen), cycles(gen)};
+			}
+			mismatches += (model.estimate(costs, 1 + chain % 40).cycles != simulateCycles(costs, 1 + chain % 40));
+		}
+		std::cout << std::setw(20) << "estimate s" << std::setw(12) << std::fixed << std::setprecision(4) << seconds
+			  << "  (" << report.cycles << " cycles, utilization " << report.utilization << ", "
+			  << report.bottlenecks.size() << " bottlenecks)" << std::endl
+			  << "cycle by cycle check (1000 chains): " << verdict(mismatches == 0) << std::endl;
+	}
+
+	/* Tiled runs without and with periodic checkpoints, then a single checkpoint saved and loaded. */
+	void benchCheckpoint()
+	{
+		const std::size_t count = scaled(1 << 22);
+		const std::size_t tileSize = scaled(1 << 16);
+		const std::string path = "systolic_bench.ck";
+		const std::vector<int> xs = randomValues(count, -1000, 1000);
+		const std::vector<int> coefs = randomValues(17, -8, 8);
+		Systolic::Container plain(xs);
+		Systolic::Container checkpointed(xs);
+		Systolic::Container resumed(xs);
+
+		plain.setCells(polynomial(coefs));
+		checkpointed.setCells(polynomial(coefs));
+		resumed.setCells(polynomial(coefs));
+		checkpointed.setCheckpoints(path, 16);
+		std::cout << "== checkpoint: polynomial of degree 16 over " << count << " X, tiles of " << tileSize
+			  << ", a checkpoint every 16 tiles" << std::endl;
+
+		double plainSeconds = measure([&]{ plain.computeAsync(nullptr, Systolic::CancellationToken(), tileSize).get(); });
+		double checkpointedSeconds = measure([&]{
+				checkpointed.computeAsync(nullptr, Systolic::CancellationToken(), tileSize).get();
+			});
+		double saveSeconds = measure([&]{ checkpointed.saveCheckpoint(path); });
+		double loadSeconds = measure([&]{ resumed.loadCheckpoint(path); });
+
+		std::remove(path.c_str());
+		std::remove((path + ".out").c_str());
+		std::cout << std::setw(20) << "plain s" << std::setw(12) << std::fixed << std::setprecision(4) << plainSeconds << std::endl
+			  << std::setw(20) << "checkpointed s" << std::setw(12) << checkpointedSeconds
+			  << "  (" << count / tileSize / 16 << " checkpoints)" << std::endl
+			  << std::setw(20) << "save s" << std::setw(12) << saveSeconds << std::endl
+			  << std::setw(20) << "load s" << std::setw(12) << loadSeconds
+			  << mark(resumed.getOutputView() == plain.getOutputView()) << std::endl;
+	}
+
+	/* Pipelines of a large polynomial built from its equation, from its coefficients, then from a pipeline file. */
+	void benchPipeline()
+	{
+		const std::size_t degree = scaled(100000);
+		const std::string path = "systolic_bench.pl";
+		const std::vector<int> coefs = randomValues(degree + 1, 1, 9);
+		std::stringstream equation;
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> parsed;
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> listed;
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> loaded;
+
+		for (std::size_t i = 0; i != coefs.size(); i++) {
+			equation << (i != 0 ? "+" : "") << coefs[i] << "x^" << degree - i;
+		}
+		std::cout << "== pipeline: polynomial of degree " << degree << std::endl;
+
+		double equationSeconds = measure([&]{
+				parsed = Systolic::CellArrayBuilder::getNew()->fromPolynomialEquation(equation.str())->build();
+			});
+		double coefsSeconds = measure([&]{ listed = Systolic::CellArrayBuilder::getNew()->fromPolynomialCoefs(toQueue(coefs))->build(); });
+		double saveSeconds = measure([&]{ Systolic::CellArrayBuilder::getNew()->fromPolynomialCoefs(toQueue(coefs))->savePipeline(path); });
+		double loadSeconds = measure([&]{ loaded = Systolic::CellArrayBuilder::getNew()->fromPipelineFile(path)->build(); });
+		bool same = (loaded.size() == parsed.size());
+
+		for (std::size_t i = 0; same && i != loaded.size(); i++) {
+			same = loaded[i]->getCellDescription() == parsed[i]->getCellDescription();
+		}
+		std::remove(path.c_str());
+		std::cout << std::setw(20) << "equation s" << std::setw(12) << std::fixed << std::setprecision(4) << equationSeconds << std::endl
+			  << std::setw(20) << "coefs s" << std::setw(12) << coefsSeconds << std::endl
+			  << std::setw(20) << "save s" << std::setw(12) << saveSeconds << "  (coefs included)" << std::endl
+			  << std::setw(20) << "pipeline file s" << std::setw(12) << loadSeconds << mark(same) << std::endl;
+	}
+
+	void benchDescription()
+	{
+		using Systolic::Cell::Types;
+		const std::size_t stages = scaled(100000);
+		const std::vector<int> terms = randomValues(stages, 1, 9);
+		const Types types[] = {Types::Addition, Types::Multiplication, Types::Power, Types::Division};
+		const char *keywords[] = {"add", "mul", "pow", "div"};
+		std::stringstream mixed;
+		std::stringstream poly;
+		std::stringstream equation;
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> added;
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> parsed;
+
+		for (std::size_t i = 0; i != stages; i++) {
+			mixed << (i != 0 ? " | " : "") << keywords[i % 4] << " " << terms[i];
+			poly << (i != 0 ? " " : "poly ") << terms[i];
+			equation << (i != 0 ? "+" : "") << terms[i] << "x^" << stages - 1 - i;
+		}
+		std::cout << "== description: " << stages << " stages" << std::endl;
+
+		double addSeconds = measure([&]{
+				std::shared_ptr<Systolic::CellArrayBuilder> builder = Systolic::CellArrayBuilder::getNew();
+
+				for (std::size_t i = 0; i != stages; i++) {
+					builder->add(types[i % 4], terms[i]);
+				}
+				added = builder->build();
+			});
+		double mixedSeconds = measure([&]{ parsed = Systolic::CellArrayBuilder::getNew()->fromPipelineDescription(mixed.str())->build(); });
+		bool same = (added.size() == parsed.size());
+
+		for (std::size_t i = 0; same && i != added.size(); i++) {
+			same = added[i]->getCellDescription() == parsed[i]->getCellDescription();
+		}
+		double equationSeconds = measure([&]{ Systolic::CellArrayBuilder::getNew()->fromPolynomialEquation(equation.str())->build(); });
+		double polySeconds = measure([&]{ Systolic::CellArrayBuilder::getNew()->fromPipelineDescription(poly.str())->build(); });
+
+		std::cout << std::setw(20) << "add s" << std::setw(12) << std::fixed << std::setprecision(4) << addSeconds << std::endl
+			  << std::setw(20) << "mixed s" << std::setw(12) << mixedSeconds << mark(same) << std::endl
+			  << std::setw(20) << "equation s" << std::setw(12) << equationSeconds << std::endl
+			  << std::setw(20) << "poly s" << std::setw(12) << polySeconds << std::endl;
+	}
+
+	/* Values of type T from small integers, fixed-point ones being scaled down as to stay in range. */
+	template <typename T>
+	std::vector<T> toValues(const std::vector<int> &values)
+	{
+		std::vector<T> res;
+
+		for (int value : values) {
+			if constexpr (std::is_same_v<T, Systolic::Backend::Q16>) {
+				res.push_back(Systolic::Backend::Q16::fromDouble(value / 8.0));
+			} else {
+				res.push_back(static_cast<T>(value));
+			}
+		}
+		return res;
+	}
+
+	template <typename T>
+	void benchType(const std::vector<int> &xs, const std::vector<int> &coefs)
+	{
+		const std::vector<T> values = toValues<T>(xs);
+		const Systolic::Backend::BasicPolynomialEvaluator<T> evaluator(toValues<T>(coefs));
+		std::vector<T> outputs(values.size());
+
+		double seconds = measure([&]{ evaluator.evaluate(values.data(), outputs.data(), values.size()); });
+
+		std::cout << std::setw(10) << Systolic::Backend::ValueTraits<T>::name
+			  << std::setw(14) << std::fixed << std::setprecision(4) << seconds
+			  << std::setw(12) << std::setprecision(1) << values.size() / seconds / 1e6 << std::endl;
+	}
+
+	void benchTypes()
+	{
+		const std::size_t count = scaled(1 << 21);
+		const std::vector<int> xs = randomValues(count, -8, 8);
+		const std::vector<int> coefs = randomValues(17, -8, 8);
+
+		std::cout << "== types: polynomial of degree 16 over " << count << " X" << std::endl
+			  << std::setw(10) << "type" << std::setw(14) << "seconds" << std::setw(12) << "M X/s" << std::endl;
+		benchType<std::int32_t>(xs, coefs);
+		benchType<std::int64_t>(xs, coefs);
+		benchType<double>(xs, coefs);
+		benchType<Systolic::Backend::Q16>(xs, coefs);
+
+		Systolic::Container container(toQueue(xs));
+
+		container.setCells(polynomial(coefs));
+
+		double seconds = measure([&]{ container.computeBatch(); });
+
+		std::cout << std::setw(10) << "Container" << std::setw(14) << std::setprecision(4) << seconds
+			  << std::setw(12) << std::setprecision(1) << count / seconds / 1e6 << "  (int, queues included)" << std::endl;
+	}
+
+	struct Section {
+		const char *name;
+		void (*run)();
+	};
+
+	const Section sections[] = {
+		{"estrin", benchEstrin},
+		{"multipoint", benchMultipoint},
+		{"gemm", benchGemm},
+		{"fir", benchFir},
+		{"sort", benchSort},
+		{"band", benchBand},
+		{"incremental", benchIncremental},
+		{"memo", benchMemo},
+		{"newton", benchNewton},
+		{"wide", benchWide},
+		{"hash", benchHash},
+		{"types", benchTypes},
+		{"queues", benchQueues},
+		{"output", benchOutput},
+		{"jobs", benchJobs},
+		{"scheduler", benchScheduler},
+		{"async", benchAsync},
+		{"inputs", benchInputs},
+		{"checkpoint", benchCheckpoint},
+		{"pipeline", benchPipeline},
+		{"description", benchDescription},
+		{"stages", benchStages},
+		{"graph", benchGraph},
+		{"cost", benchCost},
+	};
+}
+
+int main(int ac, char **av)
+{
+	int named = 0;
+
+	for (int i = 1; i < ac; i++) {
+		small = small || std::strcmp(av[i], "--small") == 0;
+		named += (std::strcmp(av[i], "--small") != 0);
+	}
+	for (const Section &section : sections) {
+		bool selected = (named == 0);
+
+		for (int i = 1; i < ac; i++) {
+			selected = selected || std::strcmp(av[i], section.name) == 0;
+		}
+		if (selected) {
+			section.run();
+		}
+	}
+	if (failures != 0) {
+		std::cerr << "Err: " << failures << " check(s) failed." << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicPolynomialEvaluator.hpp
+ * Batch evaluation backend for chains of BasicPolynomialCells.
+ */
+
+#pragma once
+
+#include "Systolic/Backend/ValueTypes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Batch evaluator of polynomials over any value type.
+		 * Computes, for a whole batch of X, the Horner's method with the
+		 * kernel of ValueTraits<T>, giving the same values as a chain of
+		 * BasicPolynomialCells would.
+		 * X are evaluated by blocks, the sums of a block being updated
+		 * together so that the compiler vectorizes them, and the blocks
+		 * are spread over the Scheduler.
+		 * Instantiated for std::int32_t, std::int64_t, double and Q16.
+		 */
+		template <typename T>
+		class BasicPolynomialEvaluator {
+		public:
+			/**
+			 * Default constructor.
+			 * @param coefs Coefficients from the highest degree to the constant term.
+			 */
+			BasicPolynomialEvaluator(const std::vector<T> &coefs);
+
+			/**
+			 * Evaluate the polynomial over a batch of X.
+			 * @param xs Values of X.
+			 * @param outputs Destination of the values, one per X.
+			 * @param count Number of X.
+			 */
+			void evaluate(const T *xs, T *outputs, const std::size_t count) const;
+			/**
+			 * Evaluate the polynomial over a batch of X.
+			 * @return The value of the polynomial for each X, in order.
+			 * @see evaluate
+			 */
+			std::vector<T> evaluate(const std::vector<T> &xs) const;
+
+		private:
+			static constexpr std::size_t blockSize = 256; /** X evaluated together. */
+
+			std::vector<T> coefs;
+		};
+
+		extern template class BasicPolynomialEvaluator<std::int32_t>;
+		extern template class BasicPolynomialEvaluator<std::int64_t>;
+		extern template class BasicPolynomialEvaluator<double>;
+		extern template class BasicPolynomialEvaluator<Q16>;
+	}
+}
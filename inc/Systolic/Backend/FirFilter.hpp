@@ -0,0 +1,98 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file FirFilter.hpp
+ * Streaming batch backend for chains of FirCells.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Streaming FIR filter.
+		 * Computes the same values as a chain of FirCells would,
+		 * including the 32-bit wraparound of its integer arithmetic,
+		 * without simulating the array.
+		 * Samples are processed by blocks, each output being a dot
+		 * product of the taps with the latest samples that the compiler
+		 * vectorizes over the taps.
+		 * The latest samples are kept between calls to process, so that
+		 * a signal can be filtered chunk by chunk.
+		 */
+		class FirFilter {
+		public:
+			/**
+			 * Default constructor.
+			 * Starts with an history of zeros, as do fresh FirCells.
+			 * @param taps Taps in the order of the FirCells, the first
+			 * one being applied to the latest sample.
+			 * @throws std::invalid_argument if there is no tap.
+			 */
+			FirFilter(const std::vector<int> &taps);
+
+			/**
+			 * Filter a chunk of samples.
+			 * @param samples Samples to filter, in order.
+			 * @param outputs Destination of the filtered samples; may not
+			 * overlap samples.
+			 * @param count Number of samples.
+			 */
+			void process(const int *samples, int *outputs, const std::size_t count);
+			/**
+			 * Filter a chunk of samples.
+			 * @see process
+			 */
+			std::vector<int> process(const std::vector<int> &samples);
+			/**
+			 * Forget every previous sample.
+			 */
+			void reset();
+			/**
+			 * Get the latest samples, as many as taps, the latest last.
+			 * The k-th latest sample is the one held by the delay
+			 * register of the k-th FirCell of the equivalent chain.
+			 */
+			std::vector<int> getHistory() const;
+			/**
+			 * Replace the latest samples.
+			 * @param history As many samples as taps, the latest last.
+			 * @throws std::invalid_argument if the size does not match.
+			 * @see getHistory
+			 */
+			void setHistory(const std::vector<int> &history);
+			/**
+			 * Get the number of taps.
+			 */
+			std::size_t getTapCount() const;
+
+		private:
+			static constexpr std::size_t blockSize = 1024; /** Samples filtered between two history updates. */
+
+			std::vector<std::uint32_t> reversedTaps; /** Taps from the oldest sample to the latest. */
+			std::vector<std::uint32_t> window; /** History followed by the block being filtered. */
+		};
+	}
+}
@@ -0,0 +1,262 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ModularArithmetic.hpp
+ * Modular multiplication with Montgomery and Barrett reductions.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Reduction used by modular multiplications.
+		 */
+		enum class Reduction {
+			Montgomery, /** Montgomery reduction, for odd moduli. */
+			Barrett /** Barrett reduction, for any modulus. */
+		};
+
+		/**
+		 * Word twice as large as the given one, holding the product of two residues.
+		 * 64-bit words are only available with compilers providing 128-bit integers.
+		 */
+		template <typename Word>
+		struct DoubleWordOf;
+
+		template <>
+		struct DoubleWordOf<std::uint32_t> {
+			using type = std::uint64_t;
+		};
+
+#ifdef __SIZEOF_INT128__
+		template <>
+		struct DoubleWordOf<std::uint64_t> {
+			__extension__ typedef unsigned __int128 type;
+		};
+#endif
+
+		template <typename Word>
+		using DoubleWord = typename DoubleWordOf<Word>::type;
+
+		/**
+		 * Montgomery arithmetic modulo an odd modulus.
+		 * A constant factor is prepared once in Montgomery form, B*R mod M
+		 * with R = 2^(bits of Word), so that multiplying a plain residue by
+		 * it gives a plain residue, without any division.
+		 * The modulus must be below 2^31 for 32-bit words, 2^63 for
+		 * 64-bit ones, as to add two residues without overflow.
+		 */
+		template <typename Word>
+		class Montgomery {
+			static_assert(std::is_same_v<Word, std::uint32_t> || std::is_same_v<Word, std::uint64_t>,
+				      "Montgomery arithmetic is defined over 32-bit and 64-bit words.");
+		public:
+			/**
+			 * Default constructor.
+			 * @param modulus Odd modulus, below 2^31 or 2^63.
+			 * @throws std::invalid_argument if the modulus is even or too large.
+			 */
+			explicit Montgomery(const Word modulus)
+				: modulus(modulus), negInverse(0), r2(0)
+			{
+				if (modulus < 3 || modulus % 2 == 0 || modulus >> (sizeof(Word) * 8 - 1) != 0) {
+					throw std::invalid_argument("Montgomery reduction needs an odd modulus fitting in a signed word.");
+				}
+
+				Word inverse = modulus; // Newton's iterations, each doubling the correct low bits of M^-1.
+
+				for (int i = 0; i != 6; i++) {
+					inverse *= 2 - modulus * inverse;
+				}
+				negInverse = -inverse;
+
+				const DoubleWord<Word> r = static_cast<Word>(-modulus) % modulus; // 2^bits mod M.
+
+				r2 = static_cast<Word>(r * r % modulus);
+			}
+
+			/**
+			 * Prepare a constant factor for multiply.
+			 * @param factor A residue below the modulus.
+			 */
+			Word prepare(const Word factor) const
+			{
+				return reduce(static_cast<DoubleWord<Word>>(factor) * r2);
+			}
+			/**
+			 * Multiply a residue by a prepared factor.
+			 * @return The residue of value * factor.
+			 */
+			Word multiply(const Word value, const Word prepared) const
+			{
+				return reduce(static_cast<DoubleWord<Word>>(value) * prepared);
+			}
+			/**
+			 * Add two residues.
+			 */
+			Word add(const Word lhs, const Word rhs) const
+			{
+				const Word sum = lhs + rhs;
+
+				return (sum >= modulus ? sum - modulus : sum);
+			}
+			/**
+			 * Get the modulus.
+			 */
+			Word getModulus() const
+			{
+				return modulus;
+			}
+
+		private:
+			Word modulus;
+			Word negInverse; /** -M^-1 mod 2^bits. */
+			Word r2; /** 2^(2 bits) mod M. */
+
+			/* T * 2^-bits mod M, for T below M * 2^bits. */
+			Word reduce(const DoubleWord<Word> t) const
+			{
+				const Word u = static_cast<Word>(t) * negInverse;
+				const Word res = static_cast<Word>((t + static_cast<DoubleWord<Word>>(u) * modulus) >> (sizeof(Word) * 8));
+
+				return (res >= modulus ? res - modulus : res);
+			}
+		};
+
+		/**
+		 * Barrett arithmetic modulo any modulus.
+		 * Products are reduced with a multiplication by the precomputed
+		 * floor(2^2k / M), k being the number of bits of M, followed by at
+		 * most two subtractions. Factors need no preparation.
+		 * The modulus must be below 2^31 for 32-bit words, 2^63 for
+		 * 64-bit ones, as to keep the intermediate products in a double word.
+		 */
+		template <typename Word>
+		class Barrett {
+			static_assert(std::is_same_v<Word, std::uint32_t> || std::is_same_v<Word, std::uint64_t>,
+				      "Barrett arithmetic is defined over 32-bit and 64-bit words.");
+		public:
+			/**
+			 * Default constructor.
+			 * @param modulus Modulus, from 2 to 2^31 or 2^63 excluded.
+			 * @throws std::invalid_argument if the modulus is too small or too large.
+			 */
+			explicit Barrett(const Word modulus)
+				: modulus(modulus), bits(0), mu(0)
+			{
+				if (modulus < 2 || modulus >> (sizeof(Word) * 8 - 1) != 0) {
+					throw std::invalid_argument("Barrett reduction needs a modulus of at least 2 fitting in a signed word.");
+				}
+				while (bits != sizeof(Word) * 8 && modulus >> bits != 0) {
+					bits++;
+				}
+				mu = (static_cast<DoubleWord<Word>>(1) << (2 * bits)) / modulus;
+			}
+
+			/**
+			 * Prepare a constant factor for multiply, which is a no-op.
+			 */
+			Word prepare(const Word factor) const
+			{
+				return factor;
+			}
+			/**
+			 * Multiply a residue by a prepared factor.
+			 * @return The residue of value * factor.
+			 */
+			Word multiply(const Word value, const Word prepared) const
+			{
+				const DoubleWord<Word> x = static_cast<DoubleWord<Word>>(value) * prepared;
+				const Word q = static_cast<Word>((static_cast<Word>(x >> (bits - 1)) * mu) >> (bits + 1));
+				DoubleWord<Word> res = x - static_cast<DoubleWord<Word>>(q) * modulus; // Below 3M.
+
+				res = (res >= modulus ? res - modulus : res);
+				return static_cast<Word>(res >= modulus ? res - modulus : res);
+			}
+			/**
+			 * Add two residues.
+			 */
+			Word add(const Word lhs, const Word rhs) const
+			{
+				const Word sum = lhs + rhs;
+
+				return (sum >= modulus ? sum - modulus : sum);
+			}
+			/**
+			 * Get the modulus.
+			 */
+			Word getModulus() const
+			{
+				return modulus;
+			}
+
+		private:
+			Word modulus;
+			unsigned bits; /** Number of bits of the modulus. */
+			DoubleWord<Word> mu; /** floor(2^(2 bits) / M), up to 2^(bits + 1). */
+		};
+
+		/**
+		 * Call a function with the arithmetic fitting a modulus.
+		 * Moduli below 2^31 use 32-bit words, the other ones 64-bit words
+		 * when the compiler provides 128-bit integers.
+		 * @param modulus Modulus of the arithmetic.
+		 * @param reduction Reduction of the arithmetic.
+		 * @param function Generic function taking the arithmetic, whose
+		 * return type must not depend on the arithmetic.
+		 * @return The value returned by function.
+		 * @throws std::invalid_argument if the modulus does not suit the reduction.
+		 */
+		template <typename Function>
+		auto withArithmetic(const std::uint64_t modulus, const Reduction reduction, Function &&function)
+		{
+			if (modulus >> 31 == 0) {
+				const std::uint32_t word = static_cast<std::uint32_t>(modulus);
+
+				return (reduction == Reduction::Montgomery ? function(Montgomery<std::uint32_t>(word))
+					: function(Barrett<std::uint32_t>(word)));
+			}
+#ifdef __SIZEOF_INT128__
+			return (reduction == Reduction::Montgomery ? function(Montgomery<std::uint64_t>(modulus))
+				: function(Barrett<std::uint64_t>(modulus)));
+#else
+			throw std::invalid_argument("Moduli of 2^31 and more need a compiler with 128-bit integers.");
+#endif
+		}
+
+		/**
+		 * Get the residue of a signed value.
+		 * @return value mod modulus, between 0 and modulus - 1.
+		 */
+		template <typename Word>
+		Word residue(const std::int64_t value, const Word modulus)
+		{
+			const std::int64_t res = value % static_cast<std::int64_t>(modulus);
+
+			return static_cast<Word>(res < 0 ? res + static_cast<std::int64_t>(modulus) : res);
+		}
+	}
+}
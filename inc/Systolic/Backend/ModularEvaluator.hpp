@@ -0,0 +1,86 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ModularEvaluator.hpp
+ * Batch evaluation backend for chains of ModularPolynomialCells.
+ */
+
+#pragma once
+
+#include "Systolic/Backend/ModularArithmetic.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Batch evaluator of polynomials modulo a prime, or any modulus.
+		 * Computes, for a whole batch of X, the Horner's method reduced
+		 * modulo M after every operation, as a chain of
+		 * ModularPolynomialCells would, with either Montgomery or Barrett
+		 * reductions over 32-bit words when M is below 2^31, over 64-bit
+		 * words otherwise.
+		 * X are evaluated by blocks, the sums of a block being updated
+		 * together so that the compiler vectorizes them, and the blocks
+		 * are spread over the Scheduler.
+		 */
+		class ModularEvaluator {
+		public:
+			/**
+			 * Default constructor.
+			 * @param coefs Coefficients from the highest degree to the
+			 * constant term, possibly negative.
+			 * @param modulus Modulus, below 2^63, and odd for Montgomery reductions.
+			 * @param reduction Reduction of the products.
+			 * @throws std::invalid_argument if the modulus does not suit the reduction.
+			 */
+			ModularEvaluator(const std::vector<std::int64_t> &coefs, const std::uint64_t modulus,
+					 const Reduction reduction = Reduction::Montgomery);
+
+			/**
+			 * Evaluate the polynomial over a batch of X.
+			 * @param xs Values of X, possibly negative.
+			 * @param outputs Destination of the residues, one per X.
+			 * @param count Number of X.
+			 */
+			void evaluate(const std::int64_t *xs, std::uint64_t *outputs, const std::size_t count) const;
+			/**
+			 * Evaluate the polynomial over a batch of X.
+			 * @return The residue of the polynomial for each X, in order.
+			 * @see evaluate
+			 */
+			std::vector<std::uint64_t> evaluate(const std::vector<std::int64_t> &xs) const;
+			/**
+			 * Get the modulus.
+			 */
+			std::uint64_t getModulus() const;
+
+		private:
+			static constexpr std::size_t blockSize = 256; /** X evaluated together. */
+
+			std::vector<std::uint64_t> coefs; /** Residues of the coefficients. */
+			std::uint64_t modulus;
+			Reduction reduction;
+		};
+	}
+}
@@ -0,0 +1,79 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file NewtonSolver.hpp
+ * Batched Newton's method over the roots of a polynomial.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Outcome of the Newton's method from one starting point.
+		 */
+		struct NewtonRoot {
+			int root; /** Last iterate, a root of the polynomial if converged. */
+			std::size_t iterations; /** Number of evaluations of the polynomial. */
+			bool converged; /** Whether the polynomial is 0 at root. */
+		};
+
+		/**
+		 * Integer Newton's method over many starting points.
+		 * Each iteration evaluates the polynomial and its derivative in
+		 * a single pass, as a chain of DualPolynomialCells would, then
+		 * moves every point by -p(X)/p'(X), rounded towards zero, or by
+		 * one towards the root when that quotient is 0.
+		 * A point stops once the polynomial is 0 at it, once its
+		 * derivative is 0, once it moves back to its previous value or
+		 * out of the range of int, or after the maximum number of
+		 * iterations.
+		 * Points are iterated by blocks, the blocks being spread over the
+		 * Scheduler.
+		 */
+		class NewtonSolver {
+		public:
+			/**
+			 * Default constructor.
+			 * @param coefs Coefficients in the order of the cells, from
+			 * the highest degree to the constant term.
+			 * @throws std::invalid_argument if there is no coefficient.
+			 */
+			NewtonSolver(const std::vector<int> &coefs);
+
+			/**
+			 * Run the Newton's method from every starting point.
+			 * @param starts Starting points.
+			 * @param maxIterations Maximum number of evaluations per point.
+			 * @return The outcome for each starting point, in order.
+			 */
+			std::vector<NewtonRoot> solve(const std::vector<int> &starts, const std::size_t maxIterations = 64) const;
+
+		private:
+			static constexpr std::size_t blockSize = 256; /** Points iterated together. */
+
+			std::vector<int> coefs;
+		};
+	}
+}
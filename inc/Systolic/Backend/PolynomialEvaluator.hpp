@@ -0,0 +1,119 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file PolynomialEvaluator.hpp
+ * Batch evaluation backend for chains of PolynomialCells.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Batch evaluator of polynomials.
+		 * Computes, for a whole batch of X, the same values as a chain
+		 * of PolynomialCells would, including the 32-bit wraparound of
+		 * its integer arithmetic, without simulating the array.
+		 * Small batches are evaluated with the Horner's method while
+		 * large ones, both in degree and in number of X, use a
+		 * subproduct tree multipoint evaluation in O(n log^2 n), with
+		 * polynomial products done by number theoretic transforms
+		 * over three primes and reconstructed modulo 2^32.
+		 */
+		class PolynomialEvaluator {
+		public:
+			/**
+			 * Minimum degree for the multipoint evaluation to be used.
+			 */
+			static constexpr std::size_t multipointMinDegree = 131072;
+			/**
+			 * Minimum number of X for the multipoint evaluation to be used.
+			 */
+			static constexpr std::size_t multipointMinPoints = 131072;
+			/**
+			 * Maximum degree for the multipoint evaluation to be exact.
+			 * Its convolutions, of up to twice the number of coefficients,
+			 * are reconstructed from three primes whose product, about
+			 * 2^86, must exceed their largest coefficient, below
+			 * length * 2^64: lengths are thus limited to 2^22.
+			 */
+			static constexpr std::size_t multipointMaxDegree = (std::size_t(1) << 21) - 1;
+
+			/**
+			 * Evaluate a polynomial over a batch of X.
+			 * Selects the multipoint evaluation when both the degree and
+			 * the number of X are over their thresholds and the degree
+			 * is not over multipointMaxDegree, or the Horner's method
+			 * otherwise.
+			 * @param coefs Coefficients in the order of the PolynomialCells,
+			 * from the highest degree to the constant term.
+			 * @param xs Values of X.
+			 * @return The value of the polynomial for each X, in order.
+			 */
+			static std::vector<int> evaluate(const std::vector<int> &coefs, const std::vector<int> &xs);
+			/**
+			 * Evaluate a polynomial over count X read from memory.
+			 * @see evaluate
+			 */
+			static std::vector<int> evaluate(const std::vector<int> &coefs, const int *xs, const std::size_t count);
+			/**
+			 * Evaluate a polynomial over a batch of X with the Horner's method.
+			 * Tiles of X are spread over the Backend::Scheduler.
+			 * @see evaluate
+			 */
+			static std::vector<int> evaluateHorner(const std::vector<int> &coefs, const std::vector<int> &xs);
+			static std::vector<int> evaluateHorner(const std::vector<int> &coefs, const int *xs, const std::size_t count);
+			/**
+			 * Evaluate a polynomial and its derivative over a batch of X.
+			 * Runs the Horner's method over dual numbers, giving the same
+			 * values as a chain of DualPolynomialCells would. Tiles of X
+			 * are spread over the Backend::Scheduler, the value and the
+			 * derivative of each X being computed in a single pass.
+			 * @param coefs Coefficients from the highest degree to the constant term.
+			 * @param xs Values of X.
+			 * @param derivatives Filled with the value of the derivative for each X, in order.
+			 * @return The value of the polynomial for each X, in order.
+			 */
+			static std::vector<int> evaluateWithDerivative(const std::vector<int> &coefs, const std::vector<int> &xs,
+								       std::vector<int> &derivatives);
+			static std::vector<int> evaluateWithDerivative(const std::vector<int> &coefs, const int *xs, const std::size_t count,
+								       std::vector<int> &derivatives);
+			/**
+			 * Evaluate a polynomial over a batch of X with a subproduct tree.
+			 * Polynomials over multipointMaxDegree are evaluated with the
+			 * Horner's method instead.
+			 * @see evaluate
+			 */
+			static std::vector<int> evaluateMultipoint(const std::vector<int> &coefs, const std::vector<int> &xs);
+			static std::vector<int> evaluateMultipoint(const std::vector<int> &coefs, const int *xs, const std::size_t count);
+			/**
+			 * Tell whether evaluate would use the multipoint evaluation.
+			 * @param degree Degree of the polynomial.
+			 * @param points Number of X.
+			 */
+			static bool usesMultipoint(const std::size_t degree, const std::size_t points);
+		};
+	}
+}
@@ -0,0 +1,113 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file RollingHash.hpp
+ * Sliding-window polynomial hashing of byte streams.
+ */
+
+#pragma once
+
+#include "Systolic/Backend/ModularArithmetic.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Polynomial rolling hash.
+		 * Hashes every window of W bytes d0…dW-1 of a stream as
+		 * d0*B^(W-1) + d1*B^(W-2) + … + dW-1 mod M, that is the value
+		 * at X = B of a chain of ModularPolynomialCells whose
+		 * coefficients are the bytes of the window. Each hash is
+		 * derived from the previous one by removing the leaving byte
+		 * and adding the entering one, with a single modular
+		 * multiplication per byte.
+		 * Streams are cut in chunks spread over the Scheduler, each chunk being hashed as eight interleaved
+		 * lanes, so that their multiplications overlap.
+		 */
+		class RollingHash {
+		public:
+			/**
+			 * Handler of the hashes of a file, given by chunks in order.
+			 * Takes the offset of the first window of the chunk, its
+			 * hashes and their number.
+			 */
+			using Consumer = std::function<void(const std::size_t, const std::uint64_t *, const std::size_t)>;
+
+			/**
+			 * Default constructor.
+			 * @param base Base B of the hash.
+			 * @param modulus Modulus M of the hash, below 2^63, and odd for Montgomery reductions.
+			 * @param window Number W of bytes of a window.
+			 * @param reduction Reduction of the products.
+			 * @throws std::invalid_argument if the window is empty or the modulus does not suit the reduction.
+			 */
+			RollingHash(const std::uint64_t base, const std::uint64_t modulus, const std::size_t window,
+				    const Reduction reduction = Reduction::Montgomery);
+
+			/**
+			 * Hash every window of a stream.
+			 * @param data Bytes of the stream.
+			 * @param size Number of bytes.
+			 * @param hashes Destination of the hashes, with room for
+			 * getHashCount(size) values, the i-th one being the hash of
+			 * the window starting at the i-th byte.
+			 */
+			void scan(const unsigned char *data, const std::size_t size, std::uint64_t *hashes) const;
+			/**
+			 * Hash every window of a file.
+			 * The file is mapped in memory and hashed by chunks, each chunk
+			 * being handed to the consumer before the next one is hashed.
+			 * @param path Path of the file.
+			 * @param consumer Handler of the hashes.
+			 * @return false if the file cannot be mapped, true otherwise.
+			 */
+			bool scanFile(const std::string &path, const Consumer &consumer) const;
+			/**
+			 * Hash a whole stream, as if it were a single window.
+			 * @param data Bytes of the stream.
+			 * @param size Number of bytes.
+			 */
+			std::uint64_t fingerprint(const unsigned char *data, const std::size_t size) const;
+			/**
+			 * Get the number of windows of a stream.
+			 * @param size Number of bytes of the stream.
+			 */
+			std::size_t getHashCount(const std::size_t size) const;
+			/**
+			 * Get the number of bytes of a window.
+			 */
+			std::size_t getWindow() const;
+
+		private:
+			static constexpr std::size_t lanes = 8; /** Interleaved windows of a chunk. */
+			static constexpr std::size_t fileChunk = std::size_t(1) << 22; /** Windows hashed between two calls to a consumer. */
+
+			std::uint64_t base;
+			std::uint64_t modulus;
+			std::size_t window;
+			Reduction reduction;
+		};
+	}
+}
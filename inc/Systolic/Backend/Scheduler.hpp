@@ -0,0 +1,147 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Scheduler.hpp
+ * Work-stealing task scheduler shared by the containers and backends.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Counters of a Scheduler.
+		 */
+		struct SchedulerStats {
+			std::size_t workers; /** Threads of the scheduler. */
+			std::size_t submitted; /** Tasks submitted so far. */
+			std::size_t executed; /** Tasks run so far, by the workers or by waiting callers. */
+			std::size_t stolen; /** Tasks run by another thread than the one whose deque they were pushed to. */
+			std::size_t withdrawn; /** Helpers of a parallelFor taken back unstarted once the loop was over. */
+			std::size_t queueDepth; /** Tasks waiting in the deques. */
+			std::size_t maxQueueDepth; /** Most tasks ever waiting at once. */
+		};
+
+		/**
+		 * Work-stealing task scheduler.
+		 * Runs tasks on a fixed set of worker threads, each owning a
+		 * deque: a worker pushes the tasks it submits to the back of
+		 * its own deque and runs them from the back, while idle
+		 * workers steal from the front of the other deques. Threads
+		 * waiting for a parallelFor run queued tasks meanwhile, so
+		 * that nested parallel loops neither deadlock nor add threads.
+		 * The instance shared by the whole process has one worker less
+		 * than the hardware has threads, the thread calling parallelFor
+		 * taking part in the loop, so that the number of busy threads
+		 * stays at the core count however many containers are running.
+		 */
+		class Scheduler {
+		public:
+			/**
+			 * Get the scheduler shared by the whole process.
+			 */
+			static Scheduler &getInstance();
+
+			/**
+			 * Default constructor.
+			 * @param workers Number of worker threads, one less than the
+			 * hardware supports threads (and at least one) when 0.
+			 */
+			Scheduler(const std::size_t workers = 0);
+			Scheduler(const Scheduler &) = delete;
+			Scheduler &operator=(const Scheduler &) = delete;
+			/**
+			 * Runs the tasks left, then stops the workers.
+			 */
+			~Scheduler();
+
+			/**
+			 * Queue a task.
+			 * Tasks submitted by a worker go to its own deque, other ones
+			 * to the deques of the workers in turn.
+			 * @param task Task to run, which must not throw.
+			 */
+			void submit(std::function<void()> task);
+			/**
+			 * Run body(0) to body(count - 1) and wait for them.
+			 * Indexes are taken in order by the calling thread and by up
+			 * to one task per worker, so that a slow index does not hold
+			 * back the others; the calling thread runs queued tasks while
+			 * waiting for the last ones, and takes back the helper tasks
+			 * that did not start before the loop was over.
+			 * @param count Number of indexes.
+			 * @param body Function to run on each index.
+			 * @throws The first exception thrown by body, once every index is done.
+			 */
+			void parallelFor(const std::size_t count, const std::function<void(const std::size_t)> &body);
+			/**
+			 * Get the counters of the scheduler.
+			 */
+			SchedulerStats getStats() const;
+			/**
+			 * Get the number of worker threads.
+			 */
+			std::size_t getWorkers() const;
+
+		private:
+			/* Queued task, with the parallelFor it helps if any. */
+			struct Task {
+				std::function<void()> run;
+				const void *loop;
+			};
+
+			/* Deque of a worker, whose lock is only contended by thieves. */
+			struct Queue {
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			std::vector<std::unique_ptr<Queue>> queues; /** One per worker. */
+			std::vector<std::thread> threads;
+			std::mutex sleepMutex;
+			std::condition_variable wake;
+			bool stopping; /** Guarded by sleepMutex. */
+			std::atomic<std::size_t> pending; /** Tasks waiting in the deques. */
+			std::atomic<std::size_t> maxPending;
+			std::atomic<std::size_t> submitted;
+			std::atomic<std::size_t> executed;
+			std::atomic<std::size_t> stolen;
+			std::atomic<std::size_t> withdrawn;
+			std::atomic<std::size_t> nextQueue; /** Deque of the next task submitted from outside. */
+
+			void push(Task task);
+			void withdraw(const void *loop);
+			void work(const std::size_t self);
+			bool runOne(const std::size_t self);
+			std::size_t currentWorker() const;
+		};
+	}
+}
@@ -0,0 +1,254 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ValueTypes.hpp
+ * Value types of the templated cells and their arithmetic kernels.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+namespace Systolic {
+	namespace Backend {
+
+		/**
+		 * Signed fixed-point number in the Q format.
+		 * Holds a value as a 32-bit integer scaled by 2^Fraction, so
+		 * that Fixed<16> is a Q16.16 number, ranging from -32768 to
+		 * 32768 with a step of 2^-16. Sums and products wrap around on
+		 * overflow, as the integers of the cells do; products are
+		 * computed over 64 bits before being rounded to the nearest
+		 * representable value.
+		 */
+		template <int Fraction>
+		class Fixed {
+		public:
+			static_assert(Fraction > 0 && Fraction < 31, "Fixed numbers need 1 to 30 fractional bits.");
+
+			/**
+			 * Default constructor, to 0.
+			 */
+			constexpr Fixed() : raw(0) {}
+			/**
+			 * Convert an integer.
+			 * Integer parts beyond the range of the format wrap around.
+			 */
+			explicit constexpr Fixed(const int value) : raw(wrap(static_cast<std::int64_t>(value) * one)) {}
+
+			/**
+			 * Build a number from its scaled representation.
+			 * @param raw Value times 2^Fraction.
+			 */
+			static constexpr Fixed fromRaw(const std::int32_t raw)
+			{
+				Fixed res;
+
+				res.raw = raw;
+				return res;
+			}
+			/**
+			 * Convert a floating point number, rounded to the nearest representable value.
+			 */
+			static Fixed fromDouble(const double value)
+			{
+				return fromRaw(wrap(std::llround(value * one)));
+			}
+
+			/**
+			 * Get the value times 2^Fraction.
+			 */
+			constexpr std::int32_t getRaw() const { return raw; }
+			/**
+			 * Convert to a floating point number, exactly.
+			 */
+			constexpr double toDouble() const { return static_cast<double>(raw) / one; }
+
+			constexpr Fixed operator+(const Fixed other) const
+			{
+				return fromRaw(wrap(static_cast<std::int64_t>(raw) + other.raw));
+			}
+			constexpr Fixed operator-(const Fixed other) const
+			{
+				return fromRaw(wrap(static_cast<std::int64_t>(raw) - other.raw));
+			}
+			/**
+			 * Widening product, rounded to the nearest.
+			 */
+			constexpr Fixed operator*(const Fixed other) const
+			{
+				return fromRaw(wrap((static_cast<std::int64_t>(raw) * other.raw + half) >> Fraction));
+			}
+			constexpr bool operator==(const Fixed other) const { return raw == other.raw; }
+			constexpr bool operator!=(const Fixed other) const { return raw != other.raw; }
+
+		private:
+			static constexpr std::int64_t one = std::int64_t(1) << Fraction;
+			static constexpr std::int64_t half = one >> 1;
+
+			std::int32_t raw; /** Value times 2^Fraction. */
+
+			/* Keeps the 32 low bits, as two's complement. */
+			static constexpr std::int32_t wrap(const std::int64_t value)
+			{
+				return static_cast<std::int32_t>(static_cast<std::uint32_t>(static_cast<std::uint64_t>(value)));
+			}
+		};
+
+		/**
+		 * Q16.16 fixed-point number, the fixed-point type of the library.
+		 */
+		using Q16 = Fixed<16>;
+
+		/**
+		 * Arithmetic and conversions of a value type.
+		 * Specialized for each type the templated cells are instantiated
+		 * with: std::int32_t, std::int64_t, double and Q16.
+		 * Provides:
+		 * - name, the name of the type on the command line;
+		 * - multiplyAdd(sum, x, coef), the S*X+C step of the Horner's
+		 *   method, wrapping around for integers, fused for doubles
+		 *   when built with SYSTOLIC_FMA, and widening for fixed point numbers;
+		 * - parse(text), which throws std::invalid_argument on
+		 *   ill-formatted or out of range values;
+		 * - toString(value).
+		 */
+		template <typename T>
+		struct ValueTraits;
+
+		template <>
+		struct ValueTraits<std::int64_t> {
+			static constexpr const char *name = "int64";
+
+			static std::int64_t multiplyAdd(const std::int64_t sum, const std::int64_t x, const std::int64_t coef)
+			{
+				return static_cast<std::int64_t>(static_cast<std::uint64_t>(sum) * static_cast<std::uint64_t>(x)
+								 + static_cast<std::uint64_t>(coef));
+			}
+			static std::int64_t parse(const std::string &text)
+			{
+				std::size_t end = 0;
+				long long value = 0;
+
+				try {
+					value = std::stoll(text, &end);
+				} catch (const std::exception &) {
+					end = 0;
+				}
+				if (end == 0 || end != text.size()) {
+					throw std::invalid_argument(text + " is not a valid 64-bit integer.");
+				}
+				return static_cast<std::int64_t>(value);
+			}
+			static std::string toString(const std::int64_t value)
+			{
+				return std::to_string(value);
+			}
+		};
+
+		template <>
+		struct ValueTraits<std::int32_t> {
+			static constexpr const char *name = "int32";
+
+			static std::int32_t multiplyAdd(const std::int32_t sum, const std::int32_t x, const std::int32_t coef)
+			{
+				return static_cast<std::int32_t>(static_cast<std::uint32_t>(sum) * static_cast<std::uint32_t>(x)
+								 + static_cast<std::uint32_t>(coef));
+			}
+			static std::int32_t parse(const std::string &text)
+			{
+				const std::int64_t value = ValueTraits<std::int64_t>::parse(text);
+
+				if (value < std::numeric_limits<std::int32_t>::min() || value > std::numeric_limits<std::int32_t>::max()) {
+					throw std::invalid_argument(text + " does not fit in 32 bits.");
+				}
+				return static_cast<std::int32_t>(value);
+			}
+			static std::string toString(const std::int32_t value)
+			{
+				return std::to_string(value);
+			}
+		};
+
+		template <>
+		struct ValueTraits<double> {
+			static constexpr const char *name = "double";
+
+			static double multiplyAdd(const double sum, const double x, const double coef)
+			{
+#ifdef SYSTOLIC_FMA
+				return std::fma(sum, x, coef); // A single instruction, the units using it being built with -mfma.
+#else
+				return sum * x + coef; // Without FMA instructions, std::fma is a slow library call.
+#endif
+			}
+			static double parse(const std::string &text)
+			{
+				std::size_t end = 0;
+				double value = 0;
+
+				try {
+					value = std::stod(text, &end);
+				} catch (const std::exception &) {
+					end = 0;
+				}
+				if (end == 0 || end != text.size()) {
+					throw std::invalid_argument(text + " is not a valid floating point number.");
+				}
+				return value;
+			}
+			static std::string toString(const double value)
+			{
+				std::ostringstream ss;
+
+				ss << std::setprecision(15) << value;
+				return ss.str();
+			}
+		};
+
+		template <int Fraction>
+		struct ValueTraits<Fixed<Fraction>> {
+			static constexpr const char *name = "fixed";
+
+			static Fixed<Fraction> multiplyAdd(const Fixed<Fraction> sum, const Fixed<Fraction> x, const Fixed<Fraction> coef)
+			{
+				return sum * x + coef;
+			}
+			static Fixed<Fraction> parse(const std::string &text)
+			{
+				return Fixed<Fraction>::fromDouble(ValueTraits<double>::parse(text));
+			}
+			static std::string toString(const Fixed<Fraction> value)
+			{
+				std::ostringstream ss;
+
+				ss << std::setprecision(10) << value.toDouble();
+				return ss.str();
+			}
+		};
+	}
+}
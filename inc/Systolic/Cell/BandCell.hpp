@@ -0,0 +1,109 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BandCell.hpp
+ * Cell dedicated to banded matrix-vector products.
+ */
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <optional>
+#include <vector>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Processing element of a BidirectionalContainer.
+		 * Cell with a forward channel, carrying the elements of X from
+		 * left to right, and a backward channel, carrying the partial
+		 * elements of Y = A*X from right to left.
+		 * The cell holds one diagonal of the band matrix A, and adds to
+		 * each element of Y going through it the product of the element
+		 * of its diagonal on the same row by the element of X it meets.
+		 * Rows are counted from the elements of Y going through the cell.
+		 */
+		class BandCell {
+		public:
+			/**
+			 * Default constructor.
+			 * @param diagonal Elements of the diagonal, one per row of A:
+			 * the element of row i is A[i][i + offset], 0 when out of A.
+			 * @param offset Offset of the diagonal, positive above the main
+			 * diagonal and negative below.
+			 */
+			BandCell(const std::vector<int> diagonal, const int offset);
+
+			/**
+			 * Perform the computation.
+			 * Does Y+A*X on the elements of X and Y fed to the cell, where
+			 * A is the element of the diagonal of the current row.
+			 * @return A tuple with
+			 * at 0 the element of X forwarded to the right
+			 * and at 1 the element of Y forwarded to the left.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> compute();
+			/**
+			 * Give new values to the cell for later computation.
+			 * @param forward Element of X coming from the left neighbour.
+			 * @param backward Element of Y coming from the right neighbour.
+			 * @see compute
+			 */
+			void feed(const std::optional<int> forward, const std::optional<int> backward);
+			/**
+			 * Get the last computed values, as (forward, backward).
+			 * @see compute
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> getPartial() const;
+			/**
+			 * Get the inputs for the next computation, as (forward, backward).
+			 * @see feed
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> getInputs() const;
+			/**
+			 * Get the elements of the diagonal held by the cell.
+			 */
+			const std::vector<int> &getDiagonal() const;
+			/**
+			 * Get the offset of the diagonal held by the cell.
+			 */
+			int getOffset() const;
+			/**
+			 * Forget every previous value, as to start a new product.
+			 */
+			void reset();
+			/**
+			 * Get a generic description of the cell.
+			 */
+			std::string getCellDescription() const;
+
+		private:
+			const std::vector<int> diagonal; /** Elements of the diagonal, by row. */
+			const int offset; /** Offset of the diagonal. */
+			std::size_t row; /** Row of the next element of Y. */
+			std::optional<int> forward; /** Element of X from the left neighbour. */
+			std::optional<int> backward; /** Element of Y from the right neighbour. */
+			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed values, as (forward, backward). */
+		};
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicPolynomialCell.hpp
+ * Cell dedicated to polynomial operation, over any value type.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+#include "Systolic/Backend/ValueTypes.hpp"
+
+#include <cstdint>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Implementation of a BasicICell for Horner's method.
+		 * Cell that performs S*X+C computation over values of type T,
+		 * with the kernel of Systolic::Backend::ValueTraits<T>.
+		 * Instantiated for std::int32_t, std::int64_t, double and
+		 * Systolic::Backend::Q16.
+		 */
+		template <typename T>
+		class BasicPolynomialCell : public BasicICell<T> {
+		public:
+			/**
+			 * Default constructor.
+			 */
+			BasicPolynomialCell(const T coef);
+
+			/**
+			 * Perform the computation.
+			 * Does Horner's method polynomial evaluation on its
+			 * internal input.
+			 * @return A tuple with
+			 * at 0 the new computed value
+			 * and at 1 the initial value from the input queue.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<T>, std::optional<T>> compute() override;
+			void feed(const std::tuple<std::optional<T>, std::optional<T>> input) override;
+			std::tuple<std::optional<T>, std::optional<T>> getPartial() const override;
+			std::tuple<std::optional<T>, std::optional<T>> getInputs() const override;
+			std::string getCellDescription() const override;
+			/**
+			 * Get the coefficient of the cell.
+			 */
+			T getCoef() const;
+
+		private:
+			T coef; /** Coefficient of the Horner's method operation. */
+			std::optional<T> input; /** Value to be used for the next computation. */
+			std::optional<T> sum; /** Value computed by the previous cell. */
+			std::tuple<std::optional<T>, std::optional<T>> partial; /** Last computed value, as (sum, input). */
+		};
+
+		extern template class BasicPolynomialCell<std::int32_t>;
+		extern template class BasicPolynomialCell<std::int64_t>;
+		extern template class BasicPolynomialCell<double>;
+		extern template class BasicPolynomialCell<Systolic::Backend::Q16>;
+	}
+}
@@ -0,0 +1,102 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file CompareExchangeCell.hpp
+ * Cell dedicated to sorting arrays.
+ */
+
+#pragma once
+
+#include <string>
+#include <optional>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Processing element of a SortArray.
+		 * Cell holding a single value, that it can order with the
+		 * value held by its right neighbour (odd-even transposition),
+		 * or with a value coming from its left neighbour, keeping the
+		 * smallest one and forwarding the largest one to the right
+		 * (systolic priority queue).
+		 */
+		class CompareExchangeCell {
+		public:
+			/**
+			 * Default constructor.
+			 * The cell starts empty.
+			 */
+			CompareExchangeCell();
+
+			/**
+			 * Perform the computation.
+			 * Keeps the smallest of the held value and of the value
+			 * fed to the cell.
+			 * @return The largest of both values, to be forwarded to the
+			 * right neighbour. May be empty on empty feeding or while the
+			 * cell was empty.
+			 */
+			std::optional<int> compute();
+			/**
+			 * Give a new value to the cell for later computation.
+			 * @param incoming Value coming from the left neighbour.
+			 * @see compute
+			 */
+			void feed(const std::optional<int> incoming);
+			/**
+			 * Order the held values of this cell and of its right neighbour.
+			 * The smallest value ends up in this cell; empty cells are
+			 * considered greater than any value.
+			 * @param right Right neighbour of the cell.
+			 */
+			void exchange(CompareExchangeCell &right);
+			/**
+			 * Replace the held value.
+			 * @param incoming Value coming from the right neighbour.
+			 * @return The previously held value, to be forwarded to the left neighbour.
+			 */
+			std::optional<int> shift(const std::optional<int> incoming);
+			/**
+			 * Get the held value.
+			 */
+			std::optional<int> getValue() const;
+			/**
+			 * Get the last value forwarded to the right neighbour.
+			 * @see compute
+			 */
+			std::optional<int> getPartial() const;
+			/**
+			 * Get the input for the next computation.
+			 * @see feed
+			 */
+			std::optional<int> getInputs() const;
+			/**
+			 * Get a generic description of the cell.
+			 */
+			std::string getCellDescription() const;
+
+		private:
+			std::optional<int> value; /** Held value. */
+			std::optional<int> incoming; /** Value from the left neighbour. */
+			std::optional<int> partial; /** Value forwarded to the right neighbour. */
+		};
+	}
+}
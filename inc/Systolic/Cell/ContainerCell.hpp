@@ -0,0 +1,126 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ContainerCell.hpp
+ * Cell running a whole chain of cells.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+#include "Systolic/Cell/Types.hpp"
+#include "Systolic/Container/Container.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Implementation of an ICell for nested containers.
+		 * Cell running a chain of cells given at cell creation, P, on a
+		 * Container of its own, so that a whole pipeline, such as a
+		 * polynomial, acts as a single stage of another chain.
+		 * In Stage mode, the cell computes P(S) from the value S of the
+		 * previous cell, or P(X) when first in its chain, so that a
+		 * polynomial stage followed by a normalization stage computes
+		 * N(P(X)). In Sum mode, it computes S+P(X) instead.
+		 * Each computation runs its value through the nested cells
+		 * directly, while container chains made of such cells only
+		 * evaluate each nested chain once per batch, with the backend
+		 * that suits it.
+		 */
+		class ContainerCell : public ICell {
+		public:
+			/**
+			 * Default constructor.
+			 * @param cells Chain of cells to run, in order.
+			 * @param mode How the result of the chain is combined with the previous cell.
+			 * @throws std::invalid_argument If the chain is empty.
+			 */
+			ContainerCell(std::vector<std::unique_ptr<ICell>> cells, const NestedMode mode = NestedMode::Stage);
+			/**
+			 * Builder constructor.
+			 * Runs the cells of the builder.
+			 * @param builder CellArrayBuilder.
+			 * @param mode How the result of the chain is combined with the previous cell.
+			 * @throws std::invalid_argument If builder is null or has no cell.
+			 */
+			ContainerCell(std::shared_ptr<Systolic::CellArrayBuilder> builder, const NestedMode mode = NestedMode::Stage);
+
+			/**
+			 * Perform the computation.
+			 * Runs the sum computed by the previous cell, or X when
+			 * there is none, through the nested chain in Stage mode.
+			 * Runs X through it and adds the result to that sum in Sum
+			 * mode.
+			 * @return A tuple with
+			 * at 0 the new computed value
+			 * and at 1 the initial value from the input queue.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> compute() override;
+			void feed(const std::tuple<std::optional<int>, std::optional<int>> input) override;
+			std::tuple<std::optional<int>, std::optional<int>> getPartial() const override;
+			std::tuple<std::optional<int>, std::optional<int>> getInputs() const override;
+			std::string getCellDescription() const override;
+			/**
+			 * Restore the registers of the cell.
+			 * The registers of the nested cells are not part of them.
+			 * @throws std::logic_error If a nested cell keeps a state.
+			 */
+			void setRegisters(const std::vector<std::optional<int>> &registers) override;
+			/**
+			 * Nested chains are stateless when all of their cells are.
+			 */
+			bool isStateless() const override;
+			/**
+			 * Get how the cell combines its nested chain with the previous cell.
+			 */
+			NestedMode getMode() const;
+			/**
+			 * Run many values through the nested chain at once.
+			 * @param xs First value.
+			 * @param count Number of values.
+			 * @return P(X) for each value X, in order.
+			 */
+			std::vector<int> evaluate(const int *xs, const std::size_t count);
+			/**
+			 * Get the cost of the nested chain as a single cell.
+			 * @return The sum of the latencies of the nested cells and the largest of their intervals.
+			 */
+			Systolic::CellCost getCost(const Systolic::CostModel &model) const;
+
+		private:
+			std::unique_ptr<Systolic::Container> container; /** Container running the nested chain. */
+			std::vector<ICell *> chain; /** Cells of the nested chain, owned by the container. */
+			NestedMode mode;
+			std::string description;
+			bool stateless;
+			bool dirty; /** Whether single computations left values in the nested cells. */
+			std::optional<int> input; /** Value to be used for the next computation. */
+			std::optional<int> sum; /** Value computed by the previous cell. */
+			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed value, as (sum, input). */
+
+			int evaluateOne(const int x);
+		};
+	}
+}
@@ -56,6 +56,7 @@ namespace Systolic {
 			std::tuple<std::optional<int>, std::optional<int>> getPartial() const override;
 			std::tuple<std::optional<int>, std::optional<int>> getInputs() const override;
 			std::string getCellDescription() const override;
+			void setRegisters(const std::vector<std::optional<int>> &registers) override;
 
 		private:
 			const std::function<int(const int)> operation;
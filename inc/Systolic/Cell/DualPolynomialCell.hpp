@@ -0,0 +1,95 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file DualPolynomialCell.hpp
+ * Cell dedicated to polynomial operation along with its derivative.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Implementation of an ICell for polynomial and derivative evaluation.
+		 * Cell that performs Horner's method computation over dual numbers:
+		 * along with the value S*X+C of a PolynomialCell, it computes the
+		 * derivative D*X+S from the derivative D of the previous cell, as
+		 * its auxiliary value. A chain of such cells thus outputs p(X) and
+		 * p'(X) in a single pass.
+		 */
+		class DualPolynomialCell : public ICell {
+		public:
+			/**
+			 * Default constructor.
+			 */
+			DualPolynomialCell(const int coef);
+
+			/**
+			 * Perform the computation.
+			 * Does Horner's method polynomial evaluation on its internal
+			 * input, the derivative being updated from the sum fed to the
+			 * cell before it is replaced.
+			 * @return A tuple with
+			 * at 0 the new computed value
+			 * and at 1 the initial value from the input queue.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> compute() override;
+			void feed(const std::tuple<std::optional<int>, std::optional<int>> input) override;
+			std::tuple<std::optional<int>, std::optional<int>> getPartial() const override;
+			std::tuple<std::optional<int>, std::optional<int>> getInputs() const override;
+			std::string getCellDescription() const override;
+			/**
+			 * Get the registers of the cell, followed by the derivatives fed and computed.
+			 */
+			std::vector<std::optional<int>> getRegisters() const override;
+			void setRegisters(const std::vector<std::optional<int>> &registers) override;
+			/**
+			 * Dual cells carry the derivative.
+			 * @return true.
+			 */
+			bool hasAuxiliary() const override;
+			/**
+			 * Give the derivative computed by the previous cell.
+			 */
+			void feedAuxiliary(const std::optional<int> auxiliary) override;
+			/**
+			 * Get the derivative of the last computation.
+			 * May be empty on empty feeding.
+			 */
+			std::optional<int> getAuxiliary() const override;
+			/**
+			 * Get the coefficient of the cell.
+			 */
+			int getCoef() const;
+
+		private:
+			const int coef; /** Coefficient of the Horner's method operation. */
+			std::optional<int> input; /** Value to be used for the next computation. */
+			std::optional<int> sum; /** Value computed by the previous cell. */
+			std::optional<int> derivative; /** Derivative computed by the previous cell. */
+			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed value, as (sum, input). */
+			std::optional<int> partialDerivative; /** Last computed derivative. */
+		};
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file FirCell.hpp
+ * Cell dedicated to FIR filtering (1-D convolution).
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Implementation of an ICell for FIR filter taps.
+		 * Cell that performs S+H*X computation, where H is a constant
+		 * tap defined at cell creation, and forwards the sample it
+		 * received for the previous computation instead of the current
+		 * one. That extra delay makes the k-th cell of a chain see the
+		 * sample fed k steps earlier, so that a chain of taps h0, h1, …
+		 * outputs y[n] = h0*x[n] + h1*x[n-1] + ….
+		 * The delay register starts at 0 and keeps its value across
+		 * empty feedings, so that the state of the filter carries over
+		 * successive inputs.
+		 */
+		class FirCell : public ICell {
+		public:
+			/**
+			 * Default constructor.
+			 * Defines the tap of this cell.
+			 */
+			FirCell(const int tap);
+
+			/**
+			 * Perform the computation.
+			 * Does an S+H*X computation where S is the sum computed by
+			 * the previous cell, X the sample fed to this cell and H
+			 * the tap defined at the cell creation.
+			 * @return A tuple with
+			 * at 0 the new computed value
+			 * and at 1 the sample fed at the previous computation.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> compute() override;
+			void feed(const std::tuple<std::optional<int>, std::optional<int>> input) override;
+			std::tuple<std::optional<int>, std::optional<int>> getPartial() const override;
+			std::tuple<std::optional<int>, std::optional<int>> getInputs() const override;
+			std::string getCellDescription() const override;
+			/**
+			 * Get the registers of the cell, followed by the delay register.
+			 */
+			std::vector<std::optional<int>> getRegisters() const override;
+			void setRegisters(const std::vector<std::optional<int>> &registers) override;
+			/**
+			 * FIR cells depend on the sample of their previous computation.
+			 * @return false.
+			 */
+			bool isStateless() const override;
+			/**
+			 * Get the tap of the cell.
+			 */
+			int getTap() const;
+			/**
+			 * Get the sample held by the delay register.
+			 */
+			int getDelay() const;
+			/**
+			 * Replace the sample held by the delay register.
+			 */
+			void setDelay(const int delay);
+
+		private:
+			const int tap; /** Tap of the filter. */
+			int delay; /** Sample of the previous computation. */
+			std::optional<int> input; /** Sample to be used for the next computation. */
+			std::optional<int> sum; /** Value computed by the previous cell. */
+			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed value, as (sum, delayed sample). */
+		};
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GridCell.hpp
+ * Cell dedicated to two-dimensional multiply-accumulate arrays.
+ */
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <optional>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Dataflow of a two-dimensional matrix multiplication array.
+		 */
+		enum class Dataflow {
+			OutputStationary, /** Both operands flow through the cells, each accumulating one output. */
+			WeightStationary /** Each cell holds one weight, the partial sums flow downward. */
+		};
+
+		/**
+		 * Processing element of a Grid.
+		 * Cell with a west and a north input, forwarding to its east
+		 * and south neighbours.
+		 * In output stationary mode, it accumulates the products of its
+		 * west and north inputs and forwards both unchanged.
+		 * In weight stationary mode, it forwards its west input to the
+		 * east and the sum of its north input and of the product of its
+		 * west input by its weight to the south.
+		 */
+		class GridCell {
+		public:
+			/**
+			 * Output stationary constructor.
+			 * The accumulator starts at 0.
+			 */
+			GridCell();
+			/**
+			 * Weight stationary constructor.
+			 * @param weight Weight held by the cell.
+			 */
+			GridCell(const int weight);
+
+			/**
+			 * Perform the computation.
+			 * Does a multiply-accumulate on the last values fed to the cell.
+			 * @return A tuple with
+			 * at 0 the value forwarded to the east
+			 * and at 1 the value forwarded to the south.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> compute();
+			/**
+			 * Give new values to the cell for later computation.
+			 * @param west Value coming from the west neighbour.
+			 * @param north Value coming from the north neighbour.
+			 * @see compute
+			 */
+			void feed(const std::optional<int> west, const std::optional<int> north);
+			/**
+			 * Get the last computed values, as (east, south).
+			 * @see compute
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> getPartial() const;
+			/**
+			 * Get the inputs for the next computation, as (west, north).
+			 * @see feed
+			 */
+			std::tuple<std::optional<int>, std::optional<int>> getInputs() const;
+			/**
+			 * Get the accumulated value of an output stationary cell.
+			 */
+			int getAccumulator() const;
+			/**
+			 * Get the weight of a weight stationary cell.
+			 */
+			int getWeight() const;
+			/**
+			 * Get the dataflow the cell was created for.
+			 */
+			Dataflow getDataflow() const;
+			/**
+			 * Get a generic description of the cell.
+			 */
+			std::string getCellDescription() const;
+
+		private:
+			const Dataflow dataflow; /** Role of the cell in the array. */
+			const int weight; /** Stationary weight, unused in output stationary mode. */
+			int accumulator; /** Sum of the products, unused in weight stationary mode. */
+			std::optional<int> west; /** Value from the west neighbour. */
+			std::optional<int> north; /** Value from the north neighbour. */
+			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed values, as (east, south). */
+		};
+	}
+}
@@ -27,6 +27,8 @@
 #include <string>
 #include <tuple>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 
 namespace Systolic {
 	namespace Cell {
@@ -34,9 +36,12 @@ namespace Systolic {
 		/**
 		 * Pure virtual class for Cell class implementation.
 		 * Interface defining the mandatory function to
-		 * implement in order to be used by cell containers.
+		 * implement in order to be used by cell containers,
+		 * whose values are of type T.
+		 * @see ICell
 		 */
-		class ICell {
+		template <typename T>
+		class BasicICell {
 		public:
 			/**
 			 * Perform the computation.
@@ -48,15 +53,15 @@ namespace Systolic {
 			 * and at 1 the initial value from the input queue.
 			 * May be empty on empty feeding.
 			 */
-			virtual std::tuple<std::optional<int>, std::optional<int>> compute() = 0;
+			virtual std::tuple<std::optional<T>, std::optional<T>> compute() = 0;
 			/**
 			 * Give a new value to the cell for later computation.
 			 * Stores a new value in the cell, to be used during computation.
 			 * Does not replace the existing partial result.
-			 * @param input An optional integer.
+			 * @param input An optional value.
 			 * @see compute
 			 */
-			virtual void feed(const std::tuple<std::optional<int>, std::optional<int>> input) = 0;
+			virtual void feed(const std::tuple<std::optional<T>, std::optional<T>> input) = 0;
 			/**
 			 * Get the current computed value of the cell.
 			 * Gets the last computed value of this cell.
@@ -65,7 +70,7 @@ namespace Systolic {
 			 * and at 1 the initial value from the input queue.
 			 * @see compute
 			 */
-			virtual std::tuple<std::optional<int>, std::optional<int>> getPartial() const = 0;
+			virtual std::tuple<std::optional<T>, std::optional<T>> getPartial() const = 0;
 			/**
 			 * Get the inputs for the next computation.
 			 * Get the last values fed to the cells.
@@ -74,16 +79,73 @@ namespace Systolic {
 			 * and at (1) the original input.
 			 ù @see feed
 			 */
-			virtual std::tuple<std::optional<int>, std::optional<int>> getInputs() const = 0;
+			virtual std::tuple<std::optional<T>, std::optional<T>> getInputs() const = 0;
 			/**
 			 * Get a generic description of the cell.
 			 * @return An implementation-dependant string.
 			 */
 			virtual std::string getCellDescription() const = 0;
+			/**
+			 * Tell whether the results of the cell only depend on its inputs.
+			 * Cells keeping a state from one computation to the next must
+			 * return false, as to prevent containers from reusing their
+			 * previous results.
+			 * @return true, unless overridden.
+			 */
+			virtual bool isStateless() const { return true; }
+			/**
+			 * Tell whether the cell carries a value besides its partial.
+			 * Such cells read the auxiliary value of the previous cell
+			 * before each computation, and leave their own for the next
+			 * one, the auxiliary value of the last cell being an output of
+			 * the container alongside the partial.
+			 * @return false, unless overridden.
+			 */
+			virtual bool hasAuxiliary() const { return false; }
+			/**
+			 * Give the auxiliary value of the previous cell for the next computation.
+			 * Ignored unless overridden.
+			 * @param auxiliary An optional value.
+			 * @see hasAuxiliary
+			 */
+			virtual void feedAuxiliary(const std::optional<T> auxiliary) { (void)auxiliary; }
+			/**
+			 * Get the auxiliary value of the last computation.
+			 * @return An empty value, unless overridden.
+			 * @see hasAuxiliary
+			 */
+			virtual std::optional<T> getAuxiliary() const { return std::nullopt; }
+			/**
+			 * Get the registers of the cell, as saved by checkpoints.
+			 * @return The values fed for the next computation, as given
+			 * by getInputs, then the last computed value, as given by
+			 * getPartial, followed by the registers proper to the cell.
+			 */
+			virtual std::vector<std::optional<T>> getRegisters() const
+			{
+				return {std::get<0>(getInputs()), std::get<1>(getInputs()), std::get<0>(getPartial()), std::get<1>(getPartial())};
+			}
+			/**
+			 * Restore the registers given by getRegisters.
+			 * @param registers Registers of a cell of the same kind.
+			 * @throws std::logic_error unless overridden.
+			 * @throws std::invalid_argument if the number of registers differs.
+			 */
+			virtual void setRegisters(const std::vector<std::optional<T>> &registers)
+			{
+				(void)registers;
+				throw std::logic_error("Cell " + getCellDescription() + " cannot restore its registers.");
+			}
 			/**
 			 * Default deconstructor.
 			 */
-			virtual ~ICell() {};
+			virtual ~BasicICell() {};
 		};
+
+		/**
+		 * Interface of the integer cells, used by every container
+		 * but the BasicContainer.
+		 */
+		using ICell = BasicICell<int>;
 	}
 }
@@ -0,0 +1,109 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ModularPolynomialCell.hpp
+ * Cell dedicated to polynomial operation modulo an integer.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+#include "Systolic/Backend/ModularArithmetic.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Implementation of a BasicICell for modular polynomial operation.
+		 * Cell that performs the Horner's method computation S*X+C
+		 * modulo M, with either a Montgomery or a Barrett reduction of
+		 * the product, instead of wrapping around. Inputs, possibly
+		 * negative, are reduced to their residue first; every computed
+		 * value is a residue, between 0 and M - 1.
+		 * Instantiated for std::int32_t, whose cells reduce over 32-bit
+		 * words and are run by the Container, and for std::int64_t,
+		 * whose cells reduce over 64-bit words and are run by the
+		 * Int64Container, when the compiler provides 128-bit integers.
+		 */
+		template <typename T>
+		class BasicModularPolynomialCell : public BasicICell<T> {
+		public:
+			using Word = std::make_unsigned_t<T>; /** Word of the residues and of the reductions. */
+
+			/**
+			 * Default constructor.
+			 * @param coef Coefficient, possibly negative.
+			 * @param modulus Modulus, from 2 to the largest T, and odd for Montgomery reductions.
+			 * @param reduction Reduction of the products.
+			 * @throws std::invalid_argument if the modulus does not suit the reduction.
+			 */
+			BasicModularPolynomialCell(const T coef, const T modulus,
+						   const Systolic::Backend::Reduction reduction = Systolic::Backend::Reduction::Montgomery);
+
+			/**
+			 * Perform the computation.
+			 * Does the Horner's method step modulo M on its internal input.
+			 * @return A tuple with
+			 * at 0 the new computed residue
+			 * and at 1 the initial value from the input queue.
+			 * May be empty on empty feeding.
+			 */
+			std::tuple<std::optional<T>, std::optional<T>> compute() override;
+			void feed(const std::tuple<std::optional<T>, std::optional<T>> input) override;
+			std::tuple<std::optional<T>, std::optional<T>> getPartial() const override;
+			std::tuple<std::optional<T>, std::optional<T>> getInputs() const override;
+			std::string getCellDescription() const override;
+			void setRegisters(const std::vector<std::optional<T>> &registers) override;
+			/**
+			 * Get the coefficient of the cell, as given at its creation.
+			 */
+			T getCoef() const;
+			/**
+			 * Get the modulus of the cell.
+			 */
+			T getModulus() const;
+			/**
+			 * Get the reduction of the products.
+			 */
+			Systolic::Backend::Reduction getReduction() const;
+
+		private:
+			const T coef; /** Coefficient of the Horner's method operation. */
+			const Systolic::Backend::Reduction reduction;
+			std::variant<Systolic::Backend::Montgomery<Word>, Systolic::Backend::Barrett<Word>> arithmetic;
+			std::optional<T> input; /** Value to be used for the next computation. */
+			std::optional<T> sum; /** Residue computed by the previous cell. */
+			std::tuple<std::optional<T>, std::optional<T>> partial; /** Last computed value, as (sum, input). */
+		};
+
+		using ModularPolynomialCell = BasicModularPolynomialCell<std::int32_t>; /** Modular cell of the Container, modulo M below 2^31. */
+
+		extern template class BasicModularPolynomialCell<std::int32_t>;
+#ifdef __SIZEOF_INT128__
+		using Modular64PolynomialCell = BasicModularPolynomialCell<std::int64_t>; /** Modular cell of the Int64Container, modulo M below 2^63. */
+
+		extern template class BasicModularPolynomialCell<std::int64_t>;
+#endif
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file MultiplyAddCell.hpp
+ * Cell dedicated to the nodes of an Estrin's scheme tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <optional>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Binary node of a polynomial evaluation tree.
+		 * Cell that performs L+H*P computation, where L and H are
+		 * either the results of its two children or, for the leaves,
+		 * two constant coefficients defined at cell creation, and P
+		 * is the power of X matching the depth of the node.
+		 * Unlike ICell implementations, this cell has two upstream
+		 * neighbours and is meant to be used by a TreeContainer.
+		 */
+		class MultiplyAddCell {
+		public:
+			/**
+			 * Inner node constructor.
+			 * Both terms of the computation are fed by the children of the node.
+			 */
+			MultiplyAddCell();
+			/**
+			 * Leaf constructor.
+			 * Defines the two constant coefficients of the computation.
+			 * @param low Coefficient of the lower degree.
+			 * @param high Coefficient of the higher degree.
+			 */
+			MultiplyAddCell(const int low, const int high);
+
+			/**
+			 * Perform the computation.
+			 * Does an L+H*P computation on the last values fed to the cell.
+			 * Replaces its internal stored value by the computed result.
+			 * @return The computed value.
+			 * May be empty on empty feeding.
+			 */
+			std::optional<int> compute();
+			/**
+			 * Give new values to the cell for later computation.
+			 * Constant coefficients of leaves take precedence over
+			 * the given low and high values.
+			 * @param low Partial result of the left child.
+			 * @param high Partial result of the right child.
+			 * @param power Power of X for the level of the node.
+			 * @see compute
+			 */
+			void feed(const std::optional<int> low, const std::optional<int> high,
+				  const std::optional<int> power);
+			/**
+			 * Get the last computed value of the cell.
+			 * @see compute
+			 */
+			std::optional<int> getPartial() const;
+			/**
+			 * Get the inputs for the next computation.
+			 * @return The last values fed to the cell, as (low, high, power).
+			 * @see feed
+			 */
+			std::tuple<std::optional<int>, std::optional<int>, std::optional<int>> getInputs() const;
+			/**
+			 * Get a generic description of the cell.
+			 */
+			std::string getCellDescription() const;
+
+		private:
+			const bool isLeaf; /** Whether the terms are constant coefficients. */
+			std::optional<int> low; /** Lower degree term. */
+			std::optional<int> high; /** Higher degree term. */
+			std::optional<int> power; /** Power of X bound to the level of the node. */
+			std::optional<int> partial; /** Result of the last computation. */
+		};
+	}
+}
@@ -56,9 +56,20 @@ namespace Systolic {
 			std::tuple<std::optional<int>, std::optional<int>> getPartial() const override;
 			std::tuple<std::optional<int>, std::optional<int>> getInputs() const override;
 			std::string getCellDescription() const override;
+			void setRegisters(const std::vector<std::optional<int>> &registers) override;
+			/**
+			 * Get the coefficient of the cell.
+			 * @return The coefficient defined at the cell creation, or by the last setCoef.
+			 */
+			int getCoef() const;
+			/**
+			 * Replace the coefficient of the cell.
+			 * Only affects the following computations.
+			 */
+			void setCoef(const int coef);
 
 		private:
-			const int coef; /** Coefficient of the Horner's method operation. */
+			int coef; /** Coefficient of the Horner's method operation. */
 			std::optional<int> input; /** Value to be used for the next computation. */
 			std::optional<int> sum; /** Sum of all values that were computed by this cell. */
 			std::tuple<std::optional<int>, std::optional<int>> partial; /** Last computed value, as (sum, input). */
@@ -32,6 +32,9 @@
 #include "Systolic/Cell/PowerCell.hpp"
 #include "Systolic/Cell/PolynomialCell.hpp"
 #include "Systolic/Cell/CustomCell.hpp"
+#include "Systolic/Cell/MultiplyAddCell.hpp"
+#include "Systolic/Cell/FirCell.hpp"
+#include "Systolic/Cell/DualPolynomialCell.hpp"
 
 namespace Systolic {
 	namespace Cell {
@@ -46,7 +49,17 @@ namespace Systolic {
 			Square, /** Reference to SquareCell. */
 			Power, /** Reference to PowerCell. */
 			Polynomial, /** Reference to PolynomialCell. */
-			Custom /** Reference to CustomCell. */
+			Custom, /** Reference to CustomCell. */
+			Fir, /** Reference to FirCell. */
+			DualPolynomial /** Reference to DualPolynomialCell. */
+		};
+
+		/**
+		 * How a ContainerCell combines its nested chain with the previous cell.
+		 */
+		enum class NestedMode {
+			Stage, /** P(S), or P(X) in first position: the nested chain is a stage fed by the previous one. */
+			Sum /** S+P(X): the result of the nested chain is added to the sum, as a custom cell would. */
 		};
 	}
 }
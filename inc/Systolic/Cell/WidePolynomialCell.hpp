@@ -0,0 +1,102 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file WidePolynomialCell.hpp
+ * Cell dedicated to the evaluation of several polynomials at once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Systolic {
+	namespace Cell {
+
+		/**
+		 * Processing element of a WideContainer.
+		 * Cell that performs the Horner's method computation S*X+C of a
+		 * PolynomialCell for M polynomials at once, holding one
+		 * coefficient per polynomial. The M sums are stored next to each
+		 * other, so that the computation of a token is vectorized across
+		 * the polynomials.
+		 */
+		class WidePolynomialCell {
+		public:
+			/**
+			 * Default constructor.
+			 * @param coefs Coefficient of each polynomial, in order.
+			 * @throws std::invalid_argument if there is no coefficient.
+			 */
+			WidePolynomialCell(const std::vector<int> &coefs);
+
+			/**
+			 * Perform the computation.
+			 * Does the Horner's method step of every polynomial on the
+			 * last values fed to the cell.
+			 * @return The X to forward to the next cell.
+			 * May be empty on empty feeding.
+			 */
+			std::optional<int> compute();
+			/**
+			 * Give new values to the cell for later computation.
+			 * @param input X to evaluate the polynomials at.
+			 * @param sums Sums computed by the previous cell, one per
+			 * polynomial, or an empty vector for sums of 0.
+			 * @see compute
+			 */
+			void feed(const std::optional<int> input, const std::vector<int> &sums);
+			/**
+			 * Get the X of the last computation.
+			 */
+			std::optional<int> getPartial() const;
+			/**
+			 * Get the sums of the last computation, one per polynomial.
+			 * Empty on empty feeding.
+			 */
+			const std::vector<int> &getSums() const;
+			/**
+			 * Get the X fed for the next computation.
+			 */
+			std::optional<int> getInput() const;
+			/**
+			 * Get the coefficient of each polynomial.
+			 */
+			const std::vector<int> &getCoefs() const;
+			/**
+			 * Get the number of polynomials.
+			 */
+			std::size_t getWidth() const;
+			/**
+			 * Get a generic description of the cell.
+			 */
+			std::string getCellDescription() const;
+
+		private:
+			const std::vector<int> coefs; /** Coefficient of each polynomial. */
+			std::optional<int> input; /** X to be used for the next computation. */
+			std::vector<int> sums; /** Sums fed by the previous cell. */
+			std::optional<int> partial; /** X of the last computation. */
+			std::vector<int> partialSums; /** Sums of the last computation. */
+		};
+	}
+}
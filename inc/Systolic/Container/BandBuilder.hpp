@@ -0,0 +1,81 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BandBuilder.hpp
+ * Builder of arrays of BandCells.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/BandCell.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include <memory>
+
+namespace Systolic {
+
+	/**
+	 * Band matrix array builder.
+	 * Used to create the linear array computing the product of a
+	 * band matrix by vectors, with one cell per diagonal of the band,
+	 * from the highest diagonal to the lowest one.
+	 */
+	class BandBuilder : public std::enable_shared_from_this<BandBuilder> {
+	public:
+		/**
+		 * Get a new instance of builder.
+		 */
+		static std::shared_ptr<BandBuilder> getNew();
+		/**
+		 * Define the array from a dense matrix.
+		 * The band is the smallest one holding every non-zero element.
+		 * Replaces any previously defined array.
+		 * @param matrix Matrix, as a list of rows.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If the matrix is empty or not rectangular.
+		 */
+		std::shared_ptr<BandBuilder> fromDense(const std::vector<std::vector<int>> &matrix);
+		/**
+		 * Define the array from the diagonals of the band.
+		 * Replaces any previously defined array.
+		 * @param diagonals Diagonals from the highest to the lowest, each
+		 * with one element per row of the matrix: the element of row i
+		 * of the diagonal of offset d is A[i][i + d].
+		 * @param upper Offset of the first diagonal, that is the number
+		 * of diagonals above the main one.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If there is no diagonal or if they
+		 * do not have the same size.
+		 */
+		std::shared_ptr<BandBuilder> fromDiagonals(const std::vector<std::vector<int>> &diagonals, const int upper);
+		/**
+		 * Generate the systolic array from the previous definition.
+		 * @return The cells of the array, from the highest diagonal to the lowest.
+		 */
+		std::vector<std::unique_ptr<Systolic::Cell::BandCell>> build();
+	private:
+		static void *operator new(size_t) = delete;
+		static void *operator new[](size_t) = delete;
+		static void operator delete(void *) = delete;
+		static void operator delete[](void *) = delete;
+		std::vector<std::unique_ptr<Systolic::Cell::BandCell>> cells;
+	};
+}
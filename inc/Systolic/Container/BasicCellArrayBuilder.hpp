@@ -0,0 +1,85 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicCellArrayBuilder.hpp
+ * Builder of vector<unique_ptr<BasicICell<T>>>.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/BasicPolynomialCell.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <initializer_list>
+
+namespace Systolic {
+
+	/**
+	 * Systolic array builder over any value type.
+	 * Used to create array of cells of type T in order, for a
+	 * BasicContainer.
+	 * Instantiated for std::int32_t, std::int64_t, double and
+	 * Systolic::Backend::Q16.
+	 */
+	template <typename T>
+	class BasicCellArrayBuilder : public std::enable_shared_from_this<BasicCellArrayBuilder<T>> {
+	public:
+		/**
+		 * Get a new instance of builder.
+		 */
+		static std::shared_ptr<BasicCellArrayBuilder> getNew();
+		/**
+		 * Add a cell to the array.
+		 * @param cell Any implementation of BasicICell<T>.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument if cell is null.
+		 */
+		std::shared_ptr<BasicCellArrayBuilder> add(std::unique_ptr<Systolic::Cell::BasicICell<T>> cell);
+		/**
+		 * Add a deduced number of BasicPolynomialCells.
+		 * Add as many BasicPolynomialCells as needed for the given list,
+		 * with their coefficients in order of the list.
+		 * @param coefs The list of coefficients for each future polynomial cell, in order.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<BasicCellArrayBuilder> fromPolynomialCoefs(const std::initializer_list<T> coefs);
+		/**
+		 * Add a preset number of BasicPolynomialCells.
+		 * @param coefs The queue of coefficients for each future polynomial cell, in order.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<BasicCellArrayBuilder> fromPolynomialCoefs(std::queue<T> coefs);
+		/**
+		 * Generate the systolic array from previous addition.
+		 * @return A vector of unique_ptr of the previously added cells.
+		 */
+		std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> build();
+	private:
+		std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> cellArray;
+	};
+
+	extern template class BasicCellArrayBuilder<std::int32_t>;
+	extern template class BasicCellArrayBuilder<std::int64_t>;
+	extern template class BasicCellArrayBuilder<double>;
+	extern template class BasicCellArrayBuilder<Systolic::Backend::Q16>;
+}
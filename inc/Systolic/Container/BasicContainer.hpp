@@ -0,0 +1,143 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicContainer.hpp
+ * Cell container and runner over any value type.
+ */
+
+#pragma once
+
+#include "Systolic/Container/BasicCellArrayBuilder.hpp"
+#include "Systolic/Backend/BasicPolynomialEvaluator.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <future>
+#include <initializer_list>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Cell container and runner over any value type.
+	 * Runs a chain of BasicICell<T> in a systolic manner over a list
+	 * of inputs, as the Container does for integers, for 64-bit
+	 * integers, floating point or fixed-point values.
+	 * Instantiated for std::int32_t, std::int64_t, double and
+	 * Systolic::Backend::Q16; the specialized features of the
+	 * Container, such as traces, caches and auxiliary values, are
+	 * only available on integers through the Container.
+	 */
+	template <typename T>
+	class BasicContainer {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the values to process as a
+		 * bracket-enclosed list.
+		 */
+		BasicContainer(const std::initializer_list<T> entries);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the values to process.
+		 */
+		BasicContainer(const std::queue<T> entries);
+
+		/**
+		 * Initialize cells.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * @param cells Vector with all cell to use in order.
+		 */
+		void setCells(std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> cells);
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells with the current instance of the builder.
+		 * @param builder BasicCellArrayBuilder.
+		 * @throws std::invalid_argument if builder is null.
+		 */
+		void setCells(std::shared_ptr<Systolic::BasicCellArrayBuilder<T>> builder);
+		/**
+		 * Single tick on the operation chain.
+		 * Call is ignored if not cell are registered.
+		 * @see Systolic::Container::step
+		 */
+		void step();
+		/**
+		 * Operate the chain until completion.
+		 * Call is ignored if no cell or no inputs are registered.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Evaluate every input without simulating the ticks.
+		 * Chains of BasicPolynomialCells are given to the
+		 * BasicPolynomialEvaluator, and chains of 32- or 64-bit
+		 * BasicModularPolynomialCells sharing their modulus to the
+		 * ModularEvaluator, while any other chain has its cells
+		 * computing each input one after the other.
+		 * Call is ignored if no cell or no inputs are registered.
+		 * @see Systolic::Backend::BasicPolynomialEvaluator
+		 * @see Systolic::Backend::ModularEvaluator
+		 */
+		void computeBatch();
+		/**
+		 * Display the current content of the output queue, as a
+		 * list of no-space comma-separated values.
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the current output queue.
+		 */
+		std::queue<T> getOutputs() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> cells;
+		std::queue<T> inputs;
+		std::queue<T> outputs;
+		std::vector<std::string> logs;
+
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<T> value) const;
+	};
+
+	using Int32Container = BasicContainer<std::int32_t>; /** Container of 32-bit integers. */
+	using Int64Container = BasicContainer<std::int64_t>; /** Container of 64-bit integers. */
+	using DoubleContainer = BasicContainer<double>; /** Container of floating point numbers. */
+	using FixedContainer = BasicContainer<Systolic::Backend::Q16>; /** Container of Q16.16 fixed-point numbers. */
+
+	extern template class BasicContainer<std::int32_t>;
+	extern template class BasicContainer<std::int64_t>;
+	extern template class BasicContainer<double>;
+	extern template class BasicContainer<Systolic::Backend::Q16>;
+}
@@ -0,0 +1,110 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BatchEvaluator.hpp
+ * Evaluation of batches of inputs through a chain of cells.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+#include "Systolic/Container/ResultCache.hpp"
+#include "Util/RingBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Backend evaluating a batch, chosen from the cells of the chain.
+	 */
+	enum class BatchBackend {
+		Polynomial, /** PolynomialEvaluator, for PolynomialCells. */
+		Dual, /** PolynomialEvaluator along with the derivatives, for DualPolynomialCells. */
+		Modular, /** ModularEvaluator, for ModularPolynomialCells sharing their modulus. */
+		Fir, /** FirFilter, for FirCells. */
+		Nested, /** Nested chains evaluated in turn, for ContainerCells. */
+		Cells /** Each input going through the cells. */
+	};
+
+	/**
+	 * Evaluator of batches of inputs through a chain of cells.
+	 * Gives the inputs to the fastest backend applicable to the
+	 * cells: chains of PolynomialCells to the PolynomialEvaluator, as
+	 * chains of DualPolynomialCells along with their derivatives,
+	 * chains of ModularPolynomialCells sharing their modulus to the
+	 * ModularEvaluator, chains of FirCells to a FirFilter starting
+	 * from their delay registers, chains of ContainerCells to their
+	 * nested chains in turn, while any other chain has its cells
+	 * computing each input one after the other.
+	 * The evaluator works on the chain and the auxiliary queue of a
+	 * container, which must outlive it.
+	 */
+	class BatchEvaluator {
+	public:
+		/**
+		 * Default constructor.
+		 * @param cells Chain evaluating the inputs.
+		 * @param auxiliaryOutputs Queue receiving the auxiliary values
+		 * left by the last cell, if it carries any.
+		 */
+		BatchEvaluator(std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells, Util::RingBuffer<int> &auxiliaryOutputs);
+
+		/**
+		 * Evaluate a batch of inputs.
+		 * With a cache, only the distinct inputs missing from it are
+		 * evaluated, unless the cells are stateful or carry auxiliary
+		 * values, then added to it. Inputs are deduplicated through a
+		 * dense table of the results when their domain spans up to
+		 * 65536 values.
+		 * @param xs Inputs, read in place.
+		 * @param cache Cache of the results, or null.
+		 * @param pipelineId Id of the chain in the cache.
+		 * @return The results, in the order of the inputs.
+		 */
+		std::vector<int> evaluate(const Util::RingView<int> &xs, Systolic::ResultCache *cache, const std::uint64_t pipelineId);
+		/**
+		 * Get the backend used by the last evaluation.
+		 */
+		Systolic::BatchBackend getBackend() const;
+		/**
+		 * Get the number of inputs that went through the cells so far, cache hits excluded.
+		 */
+		std::size_t getEvaluated() const;
+		/**
+		 * Get the name of a backend, as shown by the traces.
+		 */
+		static const char *getBackendName(const Systolic::BatchBackend backend);
+
+	private:
+		static constexpr std::size_t denseDomain = 65536; /** Largest input domain deduplicated by a dense table. */
+
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells;
+		Util::RingBuffer<int> &auxiliaryOutputs;
+		Systolic::BatchBackend backend;
+		std::size_t evaluated;
+
+		std::vector<int> evaluateBatch(const Util::RingView<int> &xs);
+		std::vector<int> evaluateMemoized(const Util::RingView<int> &xs, Systolic::ResultCache &cache, const std::uint64_t pipelineId);
+	};
+}
@@ -0,0 +1,139 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BidirectionalContainer.hpp
+ * Linear cell container and runner with two opposite channels.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/BandCell.hpp"
+#include "Systolic/Container/BandBuilder.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Linear cell container and runner with two opposite channels.
+	 * Container running a chain of BandCells, one per diagonal of a
+	 * band matrix A, over the products Y = A*X of a list of vectors.
+	 * The elements of X enter the first cell and move to the right,
+	 * while the elements of Y, starting at 0, enter the last cell and
+	 * move to the left, both every other step, so that each element of
+	 * Y meets every element of X it depends on in the cell holding
+	 * their diagonal. The result leaves the array through its first
+	 * cell. Vectors are multiplied one after the other.
+	 */
+	class BidirectionalContainer {
+	public:
+		/**
+		 * Default constructor.
+		 * @param vectors Vectors X to multiply, each with as many
+		 * elements as A has columns.
+		 */
+		BidirectionalContainer(const std::vector<std::vector<int>> vectors);
+
+		/**
+		 * Initialize cells.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * @param cells Cells from the highest diagonal to the lowest.
+		 * @throws std::invalid_argument if the cells are not consecutive diagonals of a single matrix.
+		 */
+		void setCells(std::vector<std::unique_ptr<Systolic::Cell::BandCell>> cells);
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells with the current instance of the builder.
+		 * @param builder BandBuilder.
+		 * @throws std::invalid_argument if builder is null.
+		 */
+		void setCells(std::shared_ptr<Systolic::BandBuilder> builder);
+		/**
+		 * Single tick on the array.
+		 * Injects the next elements of X and Y on their end of the
+		 * array, moves every element of X to the right and of Y to the
+		 * left then provokes each cell to compute its current value.
+		 * Call is ignored if not cell are registered or if every product is done.
+		 */
+		void step();
+		/**
+		 * Operate the array until completion.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no vectors are registered.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Compute every product without simulating the ticks.
+		 * Gives the same result as compute, without logs. The vectors
+		 * are spread over the Backend::Scheduler, by
+		 * groups sharing each block of the diagonals while it is in the
+		 * cache.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no vectors are registered.
+		 */
+		void computeBatch();
+		/**
+		 * Tell whether every product is done.
+		 */
+		bool isDone() const;
+		/**
+		 * Get the products Y, one per vector X.
+		 * Elements not computed yet are 0.
+		 */
+		std::vector<std::vector<int>> getResult() const;
+		/**
+		 * Display the result on the standard output,
+		 * one comma-separated product per line.
+		 */
+		void dumpResult() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::unique_ptr<Systolic::Cell::BandCell>> cells;
+		std::vector<std::vector<int>> vectors;
+		std::vector<std::vector<int>> result;
+		std::size_t current; /** Index of the vector being multiplied. */
+		std::size_t tick; /** Number of steps done on the current vector. */
+		std::vector<std::string> logs;
+
+		std::size_t getRows() const;
+		std::size_t getForwardDelay() const;
+		std::size_t getBackwardDelay() const;
+		std::size_t getStepCount() const;
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
@@ -25,8 +25,12 @@
 #pragma once
 
 #include "Systolic/Cell/Types.hpp"
+#include "Systolic/Cell/WidePolynomialCell.hpp"
+#include "Systolic/Cell/ModularPolynomialCell.hpp"
 
+#include <cstdint>
 #include <stdexcept>
+#include <string>
 #include <vector>
 #include <queue>
 #include <memory>
@@ -46,6 +50,16 @@ namespace Systolic {
 		 * Get a new instance of builder.
 		 */
 		static std::shared_ptr<CellArrayBuilder> getNew();
+		/**
+		 * Register a custom function under a name.
+		 * Custom cells added by name can be saved to pipeline files,
+		 * which refer to their function by that name. Registering a
+		 * name again replaces its function.
+		 * @param name Name of the function.
+		 * @param customFunc The custom function, taking a const int and returning a const int.
+		 * @throws std::invalid_argument If the name is empty or the function null.
+		 */
+		static void registerCustomCell(const std::string &name, const std::function<int(const int)> customFunc);
 		/**
 		 * Add a predefined cell to the array.
 		 * @param cellType Type enum of the cell to add.
@@ -65,37 +79,199 @@ namespace Systolic {
 		 */
 		std::shared_ptr<CellArrayBuilder> add(const Systolic::Cell::Types cellType,
 				      const std::function<int(const int)> customFunc);
+		/**
+		 * Add a custom cell to the array, from a registered function.
+		 * @param cellType Type enum of the cell to add.
+		 * @param name Name under which the function was registered.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument On predefined type cell insertion, or if no function has that name.
+		 * @see registerCustomCell
+		 */
+		std::shared_ptr<CellArrayBuilder> add(const Systolic::Cell::Types cellType, const std::string &name);
+		/**
+		 * Add a cell running the cells of another builder.
+		 * The cells are taken from that builder, as by build, and
+		 * nested in a ContainerCell, which runs the sum of the previous
+		 * cell through their chain in Stage mode, or adds the result of
+		 * their chain to it in Sum mode.
+		 * @param nested Builder of the nested chain.
+		 * @param mode How the nested chain is combined with the previous cell.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If nested is null, is this builder or has no cell.
+		 * @see Systolic::Cell::ContainerCell
+		 */
+		std::shared_ptr<CellArrayBuilder> addNested(std::shared_ptr<CellArrayBuilder> nested,
+							    const Systolic::Cell::NestedMode mode = Systolic::Cell::NestedMode::Stage);
 		/**
 		 * Add a deduced number of PolynomialCells.
 		 * Add as many PolynomialCell as needed for the given list, with their coefficients in
 		 * order of the list.
 		 * @param coefs The list of coefficients for each future polynomial cell, in order.
+		 * @param withDerivative Whether to add DualPolynomialCells instead, as to
+		 * output the derivative of the polynomial along with its value.
 		 * @return The instance of the builder.
 		 */
-		std::shared_ptr<CellArrayBuilder> fromPolynomialCoefs(const std::initializer_list<int> coefs);
+		std::shared_ptr<CellArrayBuilder> fromPolynomialCoefs(const std::initializer_list<int> coefs,
+								      const bool withDerivative = false);
 		/**
 		 * Add a preset number of PolynomialCells.
 		 * Add as many PolynomialCell as entries in the given queue, with their coefficients in
 		 * order of the queue.
 		 * @param coefs The queue of coefficients for each future polynomial cell, in order.
+		 * @param withDerivative Whether to add DualPolynomialCells instead.
 		 * @return The instance of the builder.
 		 */
-		std::shared_ptr<CellArrayBuilder> fromPolynomialCoefs(const std::queue<int> coefs);
+		std::shared_ptr<CellArrayBuilder> fromPolynomialCoefs(const std::queue<int> coefs,
+								      const bool withDerivative = false);
 		/**
 		 * Add a preset number PolynomialCells.
 		 * Add as many PolynomialCells as required to solves the given equation
 		 * using the Horner's method.
 		 * Ill-formated equation will provide an undefined sequence of cells.
 		 * @param equation An equation of the form Cn*X^N(+Cn-1*X^N-1+…).
+		 * @param withDerivative Whether to add DualPolynomialCells instead.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<CellArrayBuilder> fromPolynomialEquation(std::string equation,
+									 const bool withDerivative = false);
+		/**
+		 * Add a deduced number of ModularPolynomialCells.
+		 * Add as many ModularPolynomialCells as needed for the given list, with their
+		 * coefficients in order of the list, all reducing modulo the same modulus.
+		 * @param coefs The list of coefficients for each future modular cell, in order.
+		 * @param modulus The modulus, from 2 to 2^31 excluded, and odd for Montgomery reductions.
+		 * @param reduction The reduction of the products.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If the modulus does not suit the reduction.
+		 */
+		std::shared_ptr<CellArrayBuilder> fromModularPolynomialCoefs(const std::initializer_list<int> coefs, const int modulus,
+									     const Systolic::Backend::Reduction reduction
+									     = Systolic::Backend::Reduction::Montgomery);
+		/**
+		 * Add a preset number of ModularPolynomialCells.
+		 * @param coefs The queue of coefficients for each future modular cell, in order.
+		 * @param modulus The modulus, from 2 to 2^31 excluded, and odd for Montgomery reductions.
+		 * @param reduction The reduction of the products.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If the modulus does not suit the reduction.
+		 */
+		std::shared_ptr<CellArrayBuilder> fromModularPolynomialCoefs(const std::queue<int> coefs, const int modulus,
+									     const Systolic::Backend::Reduction reduction
+									     = Systolic::Backend::Reduction::Montgomery);
+		/**
+		 * Add polynomials to be evaluated side by side.
+		 * Each row is a polynomial, given as its coefficients from the
+		 * highest degree to the constant term; every polynomial, including
+		 * the ones of previous calls, must have the same number of coefficients.
+		 * @param coefs The coefficients of each polynomial, one row per polynomial.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If the rows are empty or not all of the same size.
+		 * @see buildWide
+		 */
+		std::shared_ptr<CellArrayBuilder> fromPolynomialMatrix(const std::vector<std::vector<int>> &coefs);
+		/**
+		 * Add a deduced number of FirCells.
+		 * Add as many FirCells as needed for the given list, with their taps in
+		 * order of the list, the first tap being applied to the latest sample.
+		 * @param taps The list of taps for each future FIR cell, in order.
 		 * @return The instance of the builder.
 		 */
-		std::shared_ptr<CellArrayBuilder> fromPolynomialEquation(std::string equation);
+		std::shared_ptr<CellArrayBuilder> fromFirTaps(const std::initializer_list<int> taps);
+		/**
+		 * Add a preset number of FirCells.
+		 * Add as many FirCells as entries in the given queue, with their taps in
+		 * order of the queue.
+		 * @param taps The queue of taps for each future FIR cell, in order.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<CellArrayBuilder> fromFirTaps(const std::queue<int> taps);
+		/**
+		 * Add the cells of a pipeline description.
+		 * The description is read in a single pass, its stages being
+		 * separated by | or new lines and each one naming a cell
+		 * followed by its terms:
+		 * - add N, mul N, div N, square and pow N add an AdditiveCell, a MultiplicativeCell,
+		 *   a DivisionCell, a SquareCell and a PowerCell;
+		 * - poly C…, dual C… and fir H… add a PolynomialCell, a DualPolynomialCell or a FirCell per term;
+		 * - mod M C… [montgomery|barrett] adds a ModularPolynomialCell modulo M per term;
+		 * - custom name adds a CustomCell from a registered function.
+		 * Blank lines are ignored and # starts a comment running to the end of its line,
+		 * so that a description can be kept in a file, as in
+		 * "add 3 | mul 2 | pow 3 | div 7".
+		 * @param description The pipeline description.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument With the line and column of the first error, if the
+		 * description is empty or ill-formed; no cell is added then.
+		 * @see registerCustomCell
+		 */
+		std::shared_ptr<CellArrayBuilder> fromPipelineDescription(const std::string &description);
+		/**
+		 * Add the cells of a pipeline file.
+		 * The file is mapped in memory and its fixed-size entries are
+		 * turned into cells in a single pass, without any parsing.
+		 * @param path Path of a file written by savePipeline.
+		 * @return The instance of the builder.
+		 * @throws std::runtime_error If the file cannot be read, is not a
+		 * pipeline file of this version, or names an unregistered custom
+		 * function; no cell is added then.
+		 * @see savePipeline
+		 */
+		std::shared_ptr<CellArrayBuilder> fromPipelineFile(const std::string &path);
+		/**
+		 * Save the cells added so far to a pipeline file.
+		 * The file holds a versioned header, the names of the custom
+		 * functions, then one fixed-size entry per cell with its type and
+		 * terms, in native byte order. It is written to path.tmp, then
+		 * renamed to path.
+		 * @param path Path of the file.
+		 * @return false if the file could not be written.
+		 * @throws std::invalid_argument If a custom cell was not added by name, or a cell is nested.
+		 * @see fromPipelineFile
+		 */
+		bool savePipeline(const std::string &path) const;
 		/**
 		 * Generate the systolic array from previous addition.
 		 * @return A vector of unique_ptr of the previously added cells.
 		 */
 		std::vector<std::unique_ptr<Systolic::Cell::ICell>> build();
+		/**
+		 * Generate an Estrin's scheme tree from previous addition.
+		 * Converts the chain of PolynomialCells into a binary tree of
+		 * MultiplyAddCells, with the leaves holding pairs of coefficients
+		 * and each upper level combining its children with the next
+		 * power of X (X^2, X^4, …). Missing higher degree coefficients
+		 * are padded with 0 as to have a complete tree.
+		 * @return The levels of the tree, from the leaves to the root.
+		 * @throws std::invalid_argument If any previously added cell is not a PolynomialCell.
+		 */
+		std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> buildTree();
+		/**
+		 * Generate a chain of WidePolynomialCells from previous polynomial matrices.
+		 * The k-th cell holds the k-th coefficient of every polynomial,
+		 * in the order of the rows.
+		 * @return A vector of unique_ptr of the cells, in order.
+		 * @throws std::invalid_argument If no polynomial matrix was added.
+		 * @see fromPolynomialMatrix
+		 */
+		std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> buildWide();
 	private:
+		/**
+		 * Entry of a pipeline file, describing a cell.
+		 */
+		struct CellRecord {
+			std::uint8_t type; /** Systolic::Cell::Types of the cell, or modularType. */
+			std::uint8_t reduction; /** Systolic::Backend::Reduction of modular cells. */
+			std::uint16_t name; /** Index of the name of custom cells, anonymousName if none. */
+			std::int32_t term;
+			std::int32_t modulus; /** Modulus of modular cells. */
+		};
+		static_assert(sizeof(CellRecord) == 12, "Entries of the pipeline files must not be padded.");
+
+		static constexpr std::uint32_t pipelineVersion = 1; /** Version of the pipeline files, bumped on any change of their layout. */
+		static constexpr std::uint8_t modularType = 0x80; /** Type of the modular polynomial cells, which have no Types. */
+		static constexpr std::uint16_t anonymousName = 0xffff; /** Name of the custom cells added by function. */
+		static constexpr std::uint8_t nestedType = 0x81; /** Type of the container cells, which cannot be saved. */
+
 		static void *operator new(size_t) = delete;
 		static void *operator new[](size_t) = delete;
 		static void operator delete(void *) = delete;
@@ -107,6 +283,12 @@ namespace Systolic {
 		inline std::string reformat(const std::string &equation) const;
 		inline std::vector<std::pair<int, int>> getCoefsPair(const std::string equation) const;
 		inline void fillMissingCoefs(std::vector<std::pair<int, int>> &coefs) const;
+		void append(std::unique_ptr<Systolic::Cell::ICell> cell, const CellRecord &record);
+		void appendImported(std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells, std::vector<CellRecord> entryRecords,
+				    const std::vector<std::string> &names);
 		std::vector<std::unique_ptr<Systolic::Cell::ICell>> cellArray;
+		std::vector<CellRecord> records; /** Description of each cell of cellArray, for savePipeline. */
+		std::vector<std::string> customNames; /** Names of the custom cells added by name. */
+		std::vector<std::vector<int>> polynomialMatrix; /** Polynomials added for buildWide, one per row. */
 	};
 }
@@ -0,0 +1,142 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Checkpointer.hpp
+ * Checkpoint files of a Container and the log of its outputs.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/ICell.hpp"
+#include "Util/RingBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * State of a Container saved by a checkpoint.
+	 */
+	struct CheckpointState {
+		std::uint64_t tick; /** Number of steps done. */
+		std::uint64_t consumed; /** Inputs read so far. */
+		std::uint64_t total; /** Inputs read so far and left to read. */
+		std::uint64_t taken[2]; /** Outputs and auxiliary outputs taken out of their queues so far. */
+		std::vector<std::vector<std::optional<int>>> registers; /** Registers of each cell, only filled by load. */
+		std::vector<int> outputs[2]; /** Outputs and auxiliary outputs still in their queues, only filled by load. */
+	};
+
+	/**
+	 * Writer and reader of the checkpoints of a Container.
+	 * A checkpoint holds the registers of every cell and the counters
+	 * of the container in a compact binary file, written to path.tmp
+	 * then renamed to path, so that a process killed meanwhile leaves
+	 * the previous checkpoint intact. The outputs themselves go to the
+	 * log path.out, to which each checkpoint only appends those
+	 * produced since the previous one to the same path, as chunks
+	 * later ones of which win, the checkpoint recording how much of
+	 * the log it covers.
+	 * Also holds the settings of the periodic checkpoints.
+	 */
+	class Checkpointer {
+	public:
+		/**
+		 * Default constructor.
+		 * Creates a checkpointer without periodic checkpoints.
+		 */
+		Checkpointer();
+
+		/**
+		 * Save a checkpoint.
+		 * @param path Path of the file.
+		 * @param cells Cells of the container.
+		 * @param state Counters of the container, its registers and
+		 * outputs being ignored.
+		 * @param outputs Output queue of the container.
+		 * @param auxiliaryOutputs Auxiliary output queue of the container.
+		 * @return false if the file or the log could not be written.
+		 * @throws std::logic_error if a cell cannot give its registers.
+		 */
+		bool save(const std::string &path, const std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells,
+			  const Systolic::CheckpointState &state, const Util::RingView<int> &outputs,
+			  const Util::RingView<int> &auxiliaryOutputs);
+		/**
+		 * Read a checkpoint.
+		 * The checkpoint must have been saved by the same cells, over
+		 * the same total of inputs, after at least consumed of them.
+		 * @param path Path of the file.
+		 * @param cells Cells of the container.
+		 * @param consumed Inputs read so far by the container.
+		 * @param total Inputs read so far and left to read by the container.
+		 * @param state Filled with the saved state, outputs included.
+		 * @return false, after reporting why, if the file or its log
+		 * cannot be read or does not match the container.
+		 */
+		bool load(const std::string &path, const std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells,
+			  const std::uint64_t consumed, const std::uint64_t total, Systolic::CheckpointState &state);
+		/**
+		 * Log again the outputs from the given one on, as they changed in place.
+		 * @param first Index of the first output changed, counting those taken.
+		 */
+		void rewind(const std::size_t first);
+
+		/**
+		 * Set the periodic checkpoints.
+		 * @param path Path of the checkpoints, or empty to stop saving them.
+		 * @param steps Number of ticks, or tiles, between two checkpoints.
+		 * @throws std::invalid_argument if steps is 0 while path is not empty.
+		 */
+		void setPeriodic(const std::string &path, const std::size_t steps);
+		/**
+		 * Get the path of the periodic checkpoints, empty if none.
+		 */
+		const std::string &getPath() const;
+		/**
+		 * Tell whether a periodic checkpoint is due.
+		 * @param steps Ticks, or tiles, done so far.
+		 * @param cancelled Whether the computation was cancelled,
+		 * a checkpoint being then due regardless of steps.
+		 */
+		bool isDue(const std::size_t steps, const bool cancelled) const;
+		/**
+		 * Count a periodic checkpoint that could not be saved, with a warning.
+		 */
+		void addFailure();
+		/**
+		 * Get the number of periodic checkpoints that could not be saved since setPeriodic.
+		 */
+		std::size_t getFailures() const;
+
+	private:
+		static constexpr std::uint32_t version = 2; /** Version of the checkpoint files, bumped on any change of their layout. */
+
+		std::string path; /** Path of the periodic checkpoints, empty if none. */
+		std::size_t steps; /** Ticks, or tiles, between two periodic checkpoints. */
+		std::size_t failures; /** Periodic checkpoints not saved since setPeriodic. */
+		std::string outputLog; /** Log of the outputs appended to by save, empty before the first checkpoint. */
+		std::uint64_t outputLogSize; /** Bytes of the log covered by the last checkpoint. */
+		std::size_t loggedOutputs[2]; /** Outputs and auxiliary outputs produced before the end of the log. */
+	};
+}
@@ -26,6 +26,17 @@
 
 #include "Systolic/Cell/Types.hpp"
 #include "Systolic/Container/CellArrayBuilder.hpp"
+#include "Systolic/Backend/PolynomialEvaluator.hpp"
+#include "Systolic/Backend/FirFilter.hpp"
+#include "Systolic/Backend/ModularEvaluator.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+#include "Systolic/Container/Trace.hpp"
+#include "Systolic/Container/ResultCache.hpp"
+#include "Systolic/Container/CostModel.hpp"
+#include "Systolic/Container/BatchEvaluator.hpp"
+#include "Systolic/Container/Checkpointer.hpp"
+#include "Util/RingBuffer.hpp"
+#include "Util/OutputWriter.hpp"
 
 #include <iostream>
 #include <iomanip>
@@ -33,14 +44,76 @@
 #include <sstream>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <queue>
 #include <cstdarg>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+#include <unordered_map>
 
 namespace Systolic {
 
+	/**
+	 * Counters of a Container.
+	 */
+	struct ContainerStats {
+		std::size_t inputs; /** Inputs given to computeBatch. */
+		std::size_t evaluated; /** Inputs that went through the cells, the other ones being cache hits. */
+
+		/**
+		 * Get the share of the inputs that did not go through the cells.
+		 * @return A rate between 0 and 1, 0 when there was no input.
+		 */
+		double getHitRate() const;
+	};
+
+	/**
+	 * Progress of an asynchronous computation of a Container.
+	 */
+	struct ComputeProgress {
+		std::size_t steps; /** Ticks, or tiles of inputs, done so far. */
+		std::size_t outputs; /** Outputs produced so far. */
+		std::size_t total; /** Outputs expected once every input went through. */
+		double seconds; /** Time elapsed since the start. */
+		double eta; /** Seconds left at the throughput measured so far, negative until an output is produced. */
+	};
+
+	/**
+	 * Receiver of the progress of an asynchronous computation, along
+	 * with the outputs produced since its previous call.
+	 */
+	using ProgressCallback = std::function<void(const ComputeProgress &progress, const std::vector<int> &outputs)>;
+
+	/**
+	 * Cancellation flag, shared by the copies of a token.
+	 */
+	class CancellationToken {
+	public:
+		/**
+		 * Default constructor.
+		 * Creates a token not cancelled yet.
+		 */
+		CancellationToken();
+
+		/**
+		 * Ask the computations holding a copy of the token to stop.
+		 */
+		void cancel();
+		/**
+		 * Tell whether the token was cancelled.
+		 */
+		bool isCancelled() const;
+
+	private:
+		std::shared_ptr<std::atomic<bool>> cancelled;
+	};
+
 	/**
 	 * Cell container and runner.
 	 * Container made to received a user-defined collection
@@ -57,9 +130,42 @@ namespace Systolic {
 		Container(const std::initializer_list<const int> entries);
 		/**
 		 * Preset constructor.
+		 * The queue is emptied into the container, so that moving it
+		 * in avoids any other copy.
 		 * @param entries A preset queue of the numbers to process.
 		 */
-		Container(const std::queue<int> entries);
+		Container(std::queue<int> entries);
+		/**
+		 * Borrowing constructor.
+		 * Reads the inputs straight from the memory of the caller
+		 * instead of copying them.
+		 * @param entries First number to process.
+		 * @param count Number of numbers to process.
+		 * @see setInputs
+		 */
+		Container(const int *entries, const std::size_t count);
+		/**
+		 * Borrowing constructor, over a contiguous range of int such as
+		 * a std::vector, a std::array or a C array.
+		 * Temporary ranges are rejected, as they would not outlive the
+		 * container.
+		 * @see setInputs
+		 */
+		template <typename Range, typename = std::enable_if_t<Util::IsContiguousRange<Range, int>::value>>
+		Container(const Range &entries) : Container(std::data(entries), std::size(entries)) {}
+		template <typename Range, typename = std::enable_if_t<Util::IsContiguousRange<Range, int>::value>>
+		Container(const Range &&entries) = delete;
+		/**
+		 * Iterator constructor.
+		 * Borrows the numbers when the iterators are pointers or
+		 * std::vector iterators, and copies them otherwise.
+		 * @see setInputs
+		 */
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		Container(Iterator first, Iterator last) : Container()
+		{
+			setInputs(first, last);
+		}
 		/**
 		 * C-Style constructor.
 		 * Tells how many inputs there is and what is their respective
@@ -94,6 +200,60 @@ namespace Systolic {
 		 * @throws std::invalid_argument if builder is null.
 		 */
 		void setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder);
+		/**
+		 * Record the activity of the container.
+		 * Every following step records the compute span of each cell,
+		 * on its own lane and on the lane of the thread running it, the
+		 * injections and outputs of values, and counters of the active
+		 * cells and of the queue depths. Batch computations are recorded
+		 * as a single span.
+		 * @param trace Recorder to use, or null to stop recording.
+		 */
+		void setTrace(std::shared_ptr<Systolic::Trace> trace);
+		/**
+		 * Replace the inputs not fed to the cells yet.
+		 * Borrows the numbers, which are read straight from the memory
+		 * of the caller: that memory must outlive every computation
+		 * of the container, or the next call to setInputs, and must not
+		 * change until every number went through. Debug builds check
+		 * the latter, computations throwing std::logic_error when the
+		 * numbers left differ from those given. The cells, the values
+		 * in flight and the outputs are kept.
+		 * @param entries First number to process.
+		 * @param count Number of numbers to process.
+		 */
+		void setInputs(const int *entries, const std::size_t count);
+		/**
+		 * Replace the inputs not fed to the cells yet by a contiguous range of int.
+		 * @see setInputs(const int *, const std::size_t)
+		 */
+		template <typename Range, typename = std::enable_if_t<Util::IsContiguousRange<Range, int>::value>>
+		void setInputs(const Range &entries)
+		{
+			setInputs(std::data(entries), std::size(entries));
+		}
+		template <typename Range, typename = std::enable_if_t<Util::IsContiguousRange<Range, int>::value>>
+		void setInputs(const Range &&entries) = delete;
+		/**
+		 * Replace the inputs not fed to the cells yet by those between two iterators.
+		 * Borrows them when the iterators are pointers or std::vector
+		 * iterators, and copies them in a single pass otherwise.
+		 * @see setInputs(const int *, const std::size_t)
+		 */
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		void setInputs(Iterator first, Iterator last)
+		{
+			if constexpr (Util::isContiguousIterator<Iterator, int>) {
+				setInputs((first == last ? nullptr : &*first), static_cast<std::size_t>(last - first));
+			} else {
+				inputs.clear();
+				borrowedEntries = nullptr;
+				consumed = 0;
+				for (; first != last; ++first) {
+					inputs.push(*first);
+				}
+			}
+		}
 		/**
 		 * Single tick on the operation chain.
 		 * Provoke each registered cell to compute their current
@@ -112,18 +272,211 @@ namespace Systolic {
 		 * @see step
 		 */
 		void compute();
+		/**
+		 * Operate the chain until completion, on the scheduler.
+		 * Runs compute, or the tiles of inputs of computeBatch, as a
+		 * task of the Backend::Scheduler so that the calling thread is
+		 * free meanwhile, reporting the progress and the new outputs
+		 * every 256 ticks or every tile, and once done or cancelled.
+		 * The token is checked between two ticks or two tiles: a
+		 * cancelled simulation leaves its values in flight in the
+		 * cells, the inputs not fed yet in the input queue, and the
+		 * outputs produced so far in the output queue.
+		 * The container must outlive the computation and be left
+		 * alone until the future is ready, and the future must not be
+		 * waited for from a task of the scheduler.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no inputs are registered.
+		 * @param progress Called from the thread running the
+		 * computation, or null.
+		 * @param token Token stopping the computation once cancelled.
+		 * @param tileSize Number of inputs evaluated at once like
+		 * computeBatch does, or 0 to simulate the ticks like compute.
+		 * @return A future holding true once every input went through,
+		 * false when the call was ignored or cancelled, or the exception
+		 * thrown by the computation.
+		 * @see compute
+		 * @see computeBatch
+		 */
+		std::future<bool> computeAsync(ProgressCallback progress = nullptr, CancellationToken token = CancellationToken(),
+					       const std::size_t tileSize = 0);
+		/**
+		 * Evaluate every input without simulating the ticks.
+		 * Pushes the same values as compute would to the outputs
+		 * queue, but without logs and using the fastest backend
+		 * applicable to the registered cells: chains of PolynomialCells
+		 * are given to the PolynomialEvaluator, as are chains of
+		 * DualPolynomialCells along with their derivatives, chains of
+		 * ModularPolynomialCells sharing their modulus to the
+		 * ModularEvaluator, chains of FirCells to a FirFilter starting
+		 * from their delay registers, while any
+		 * other chain has its cells computing each input one after
+		 * the other. With a cache, only the distinct inputs missing
+		 * from it are evaluated, unless the cells carry auxiliary values.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no inputs are registered.
+		 * @see Systolic::Backend::PolynomialEvaluator
+		 * @see Systolic::Backend::FirFilter
+		 * @see setCache
+		 */
+		void computeBatch();
+		/**
+		 * Keep the results of the polynomial batches.
+		 * When enabled, computeBatch keeps the inputs and outputs of
+		 * chains of PolynomialCells, so that setCoef can update them
+		 * instead of evaluating the inputs again.
+		 * Disabling it drops the kept results.
+		 * @param incremental Whether to keep the results.
+		 */
+		void setIncremental(const bool incremental);
+		/**
+		 * Change the coefficient of a PolynomialCell of the chain.
+		 * If the results of the last batch are kept, each of them is
+		 * updated by delta * X^(N - index), N being the degree of the
+		 * polynomial, with the powers of X kept for later changes of
+		 * the same coefficient, and those still in the output queue
+		 * are replaced in place, any other output being left alone.
+		 * The results are the same as those of a new batch, 32-bit
+		 * wraparound included.
+		 * @param index Index of the cell in the chain, 0 being the
+		 * coefficient of the highest degree.
+		 * @param coef New coefficient.
+		 * @throws std::invalid_argument if there is no PolynomialCell at index.
+		 * @see setIncremental
+		 */
+		void setCoef(const std::size_t index, const int coef);
+		/**
+		 * Reuse the results of previous batches.
+		 * When a cache is given and every cell is stateless, computeBatch
+		 * only evaluates the distinct inputs missing from the cache, then
+		 * adds their results to it and scatters the results back in the
+		 * order of the inputs. Inputs are deduplicated through a dense
+		 * table of the results when their domain spans up to 65536 values.
+		 * @param cache Cache to use, possibly shared with other containers,
+		 * or null to evaluate every input.
+		 * @see Systolic::Cell::ICell::isStateless
+		 */
+		void setCache(std::shared_ptr<Systolic::ResultCache> cache);
+		/**
+		 * Get the id under which the results of the container are cached.
+		 * The id changes whenever the cells or their coefficients do.
+		 */
+		std::uint64_t getPipelineId() const;
+		/**
+		 * Get the counters of the batches computed so far.
+		 */
+		ContainerStats getStats() const;
+		/**
+		 * Get the cost of each cell of the chain.
+		 * @param model Cost of each type of cell.
+		 * @return The costs, in the order of the cells.
+		 * @see Systolic::CostModel::getCellCost
+		 */
+		std::vector<Systolic::CellCost> getCellCosts(const Systolic::CostModel &model) const;
+		/**
+		 * Estimate the inputs not fed yet going through hardware cells.
+		 * Schedules them analytically according to the latency and the
+		 * interval the model gives each cell, without running them:
+		 * step, compute and the traces still take a tick per cell.
+		 * @param model Cost of each type of cell.
+		 * @return Cycles, utilization, bottlenecks and throughput of the run.
+		 * @see Systolic::CostModel::estimate
+		 */
+		Systolic::CostReport estimateCost(const Systolic::CostModel &model) const;
+		/**
+		 * Save the state of the container to a checkpoint file.
+		 * Saves the registers of every cell, the number of steps done,
+		 * the number of inputs read so far and the number of outputs
+		 * produced so far to a compact binary file, written to path.tmp
+		 * then renamed to path, so that a process killed meanwhile
+		 * leaves the previous checkpoint intact. The outputs themselves
+		 * go to the log path.out, to which each checkpoint only appends
+		 * those produced since the previous one to the same path, the
+		 * checkpoint recording how much of the log it covers. Logs are
+		 * not saved.
+		 * @param path Path of the file.
+		 * @return false if the file could not be written.
+		 * @throws std::logic_error if a cell cannot give its registers.
+		 * @see Systolic::Cell::ICell::getRegisters
+		 */
+		bool saveCheckpoint(const std::string &path) const;
+		/**
+		 * Resume from a checkpoint file.
+		 * The container must have the same cells and the same inputs
+		 * as the one which saved the checkpoint, and must not have read
+		 * more inputs than it: the inputs read by then are skipped, and
+		 * the registers, the number of steps and the outputs restored,
+		 * the latter from the log path.out.
+		 * @param path Path of the file.
+		 * @return false if the file cannot be read or does not match
+		 * the container, which is then left untouched.
+		 * @throws std::logic_error if a cell cannot restore its registers.
+		 * @see Systolic::Cell::ICell::setRegisters
+		 */
+		bool loadCheckpoint(const std::string &path);
+		/**
+		 * Save checkpoints while computing.
+		 * compute and computeAsync save a checkpoint every given number
+		 * of ticks, or of tiles, as well as when cancelled. Checking
+		 * for them costs a single comparison per tick or tile.
+		 * @param path Path of the checkpoints, or empty to stop saving them.
+		 * @param steps Number of ticks, or tiles, between two checkpoints.
+		 * @throws std::invalid_argument if steps is 0 while path is not empty.
+		 * @see saveCheckpoint
+		 */
+		void setCheckpoints(const std::string &path, const std::size_t steps);
+		/**
+		 * Get the number of periodic checkpoints that could not be saved.
+		 * Each failure is also reported by a warning on the error
+		 * output, the previous checkpoint being left in place.
+		 * @return The failures since the last call to setCheckpoints.
+		 */
+		std::size_t getCheckpointFailures() const;
 		/**
 		 * Display the current content of the output queue.
 		 * Displays all values contained within the output queue
 		 * on the standard output, in a First In, First Out
-		 * manner.
+		 * manner, as a list of no-space comma-separated numbers.
+		 * @see Util::OutputWriter
 		 */
 		void dumpOutputs() const;
 		/**
-		 * Get a copy of the current output queue, as a
-		 * list of no-space comma-separated numbers.
+		 * Get a copy of the current output queue.
+		 * @see getOutputView
 		 */
 		std::queue<int> getOutputs() const;
+		/**
+		 * Get a view over the current output queue, without copying it.
+		 * The view is invalidated by the next computation.
+		 */
+		Util::RingView<int> getOutputView() const;
+		/**
+		 * Get a copy of the auxiliary values left by the last cell.
+		 * Filled alongside the output queue when the last cell carries
+		 * an auxiliary value, such as the derivatives computed by a
+		 * chain of DualPolynomialCells.
+		 * @see Systolic::Cell::ICell::hasAuxiliary
+		 */
+		std::queue<int> getAuxiliaryOutputs() const;
+		/**
+		 * Get a view over the auxiliary values left by the last cell, without copying them.
+		 * The view is invalidated by the next computation.
+		 */
+		Util::RingView<int> getAuxiliaryOutputView() const;
+		/**
+		 * Take the outputs computed so far out of the container.
+		 * Leaves the output queue empty, as to stream the outputs of
+		 * successive computations without keeping them. The auxiliary
+		 * values matching the taken outputs are dropped.
+		 * @return The outputs, oldest first.
+		 */
+		std::vector<int> takeOutputs();
+		/**
+		 * Take the outputs and the auxiliary values computed so far out of the container.
+		 * @param auxiliary Filled with the auxiliary values, oldest first.
+		 * @return The outputs, oldest first.
+		 */
+		std::vector<int> takeOutputs(std::vector<int> &auxiliary);
 
 		/**
 		 * Get a textual representation of the current state.
@@ -142,11 +495,45 @@ namespace Systolic {
 		std::string getLog() const;
 	private:
 		std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells;
-		std::queue<int> inputs;
-		std::queue<int> outputs;
+		Util::RingBuffer<int> inputs; /** Preallocated from the number of entries, or borrowed from the caller. */
+		const int *borrowedEntries; /** Memory given to setInputs, while the inputs are borrowed from it. */
+		std::size_t borrowedCount;
+		std::size_t borrowedChecksum; /** Checksum of the borrowed inputs, checked by debug builds. */
+		std::size_t consumed; /** Inputs read so far, fed to the cells or evaluated. */
+		Util::RingBuffer<int> outputs; /** Preallocated from the number of inputs of each computation. */
+		Util::RingBuffer<int> auxiliaryOutputs;
 		std::vector<std::string> logs;
+		std::shared_ptr<Systolic::Trace> trace;
+		std::size_t tick; /** Number of steps done. */
+		std::size_t takenOutputs; /** Outputs taken out of the queue so far. */
+		std::size_t takenAuxiliary; /** Auxiliary outputs taken out of their queue so far. */
+		bool incremental; /** Whether polynomial batches are kept. */
+		std::vector<int> cachedInputs; /** Inputs of the last kept batch. */
+		std::vector<std::uint32_t> cachedOutputs; /** Outputs of the last kept batch, as unsigned values. */
+		std::size_t cachedFirst; /** Outputs produced before those of the last kept batch. */
+		std::unordered_map<std::size_t, std::vector<std::uint32_t>> cachedPowers; /** Powers of the inputs, by exponent. */
+		std::shared_ptr<Systolic::ResultCache> cache;
+		std::uint64_t pipelineId; /** Id of the current cells in the cache. */
+		ContainerStats stats;
+		mutable Systolic::Checkpointer checkpoints; /** Checkpoint files, their output log and the periodic checkpoints. */
+
+		static constexpr std::size_t progressTicks = 256; /** Ticks between two progress reports of computeAsync. */
+
+		/**
+		 * Empty container, every other constructor starting from it.
+		 */
+		Container();
 
+		void checkBorrowedInputs() const;
+		std::size_t getInFlight() const;
+		void flushInFlight();
+		void saveCheckpointIfDue(const std::size_t steps, const bool cancelled) const;
+		bool runSteps(const ProgressCallback &progress, const CancellationToken &token);
+		bool runTiles(const ProgressCallback &progress, const CancellationToken &token, const std::size_t tileSize);
+		void reportProgress(const ProgressCallback &progress, const ComputeProgress &done, std::size_t &reported) const;
+		std::vector<int> evaluateInputs(const Util::RingView<int> &xs, Systolic::BatchBackend &backend);
 		std::string makeLogEntry() const;
+		void writeValues(std::stringstream &ss, const Util::RingView<int> &values) const;
 		std::string optionalToString(std::optional<int> value) const;
 	};
 }
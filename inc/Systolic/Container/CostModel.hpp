@@ -0,0 +1,143 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file CostModel.hpp
+ * Cycle-level cost of the cells of a systolic array.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/Types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Cost of a cell in clock cycles.
+	 */
+	struct CellCost {
+		std::size_t latency; /** Cycles from an X entering the cell to its result leaving it. */
+		std::size_t interval; /** Cycles between two X entering the cell, 1 for a fully pipelined cell. */
+	};
+
+	/**
+	 * Estimated run of inputs through a chain of cells.
+	 */
+	struct CostReport {
+		std::size_t inputs; /** Number of X run through the chain. */
+		std::size_t cycles; /** Cycles from the first X entering the chain to the last result leaving it. */
+		std::size_t latency; /** Cycles an X takes to go through the chain. */
+		double throughput; /** X leaving the chain per cycle once it is full. */
+		double utilization; /** Share of the cycles the cells of the whole chain are busy. */
+		std::vector<double> cellUtilization; /** Share of the cycles each cell is busy, in order. */
+		std::vector<std::size_t> bottlenecks; /** Cells whose interval bounds the throughput, in order. */
+
+		/**
+		 * Get a textual summary of the report, one figure per line.
+		 * @param shown Number of bottleneck cells listed, the other ones being counted only.
+		 */
+		std::string getSummary(const std::size_t shown = 8) const;
+	};
+
+	/**
+	 * Cycle-level cost model of a chain of cells.
+	 * Gives each type of cell a latency and an initiation interval,
+	 * every cell costing one cycle of each by default, as a step of a
+	 * container does.
+	 * X number j enters cell i once the cell is done with X number
+	 * j - 1 and cell i - 1 is done with X number j, one X being
+	 * offered to the chain per cycle. The chain then being a tandem
+	 * of deterministic stages, X number j enters cell i at cycle
+	 * L0 + … + Li-1 + j * max(1, I0, …, Ii), Lk and Ik being the
+	 * latency and the interval of cell k: the schedule of any number
+	 * of inputs is known from a single pass over the cells, without
+	 * simulating the cycles. Each result then leaves its cell at the
+	 * cycle the next cell takes it, so that the schedule holds without
+	 * any buffer between cells, as in a systolic array.
+	 * The model is an analytic estimate only: the steps of the
+	 * containers still compute every cell once per tick.
+	 */
+	class CostModel {
+	public:
+		/**
+		 * Default constructor.
+		 * Every cell costs a latency and an interval of one cycle.
+		 */
+		CostModel();
+
+		/**
+		 * Create a model from a textual description.
+		 * The description holds comma-separated entries such as
+		 * div=16 or pow=4/1, each giving the latency of a type of
+		 * cell, then optionally its interval after a slash; without
+		 * it, the cell is not pipelined and its interval is its
+		 * latency. Types are named as in the pipeline descriptions:
+		 * add, mul, div, square, pow, poly, dual, fir, mod and custom.
+		 * Types not given keep a cost of one cycle.
+		 * @param description Entries of the model.
+		 * @throws std::invalid_argument If an entry names no type or holds no positive latency and interval.
+		 * @see Systolic::CellArrayBuilder::fromPipelineDescription
+		 */
+		static CostModel fromDescription(const std::string &description);
+
+		/**
+		 * Set the cost of a type of cell.
+		 * @throws std::invalid_argument If the latency or the interval is 0.
+		 */
+		void setCost(const Systolic::Cell::Types type, const CellCost cost);
+		/**
+		 * Get the cost of a type of cell.
+		 */
+		CellCost getCost(const Systolic::Cell::Types type) const;
+		/**
+		 * Set the cost of the ModularPolynomialCells, which have no Types.
+		 * @throws std::invalid_argument If the latency or the interval is 0.
+		 */
+		void setModularCost(const CellCost cost);
+		/**
+		 * Get the cost of the ModularPolynomialCells.
+		 */
+		CellCost getModularCost() const;
+		/**
+		 * Get the cost of a cell from its type.
+		 * A ContainerCell costs the sum of the latencies of its nested
+		 * cells and the largest of their intervals, as the chain it
+		 * nests would. Cells of any other type cost as custom cells.
+		 */
+		CellCost getCellCost(const Systolic::Cell::ICell &cell) const;
+		/**
+		 * Estimate inputs going through a chain of cells.
+		 * Costs a single pass over the cells, whatever the number of inputs.
+		 * @param costs Cost of each cell of the chain, in order.
+		 * @param inputs Number of X to run through the chain.
+		 * @return The estimated run, with no cycle for an empty chain.
+		 */
+		CostReport estimate(const std::vector<CellCost> &costs, const std::size_t inputs) const;
+	private:
+		std::array<CellCost, 9> costs; /** Cost of each type of cell, in the order of Types. */
+		CellCost modular;
+
+		static void checkCost(const CellCost cost);
+	};
+}
@@ -0,0 +1,195 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Graph.hpp
+ * Directed acyclic graph of cell chains.
+ */
+
+#pragma once
+
+#include "Systolic/Container/Container.hpp"
+#include "Systolic/Container/GraphBuilder.hpp"
+#include "Util/RingBuffer.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Directed acyclic graph of cell chains.
+	 * Container running GraphNodes over a given input list: every X
+	 * leaves the input node towards its successors, goes through the
+	 * chains of cells, is duplicated on fan-outs and combined again by
+	 * the merge nodes, the output of the graph being the one of a
+	 * given node.
+	 * Stepping the graph simulates each tick of every node at once, a
+	 * chain of k cells taking k ticks and a merge one tick, as would a
+	 * register between two nodes. Branches of unequal latencies are
+	 * balanced by delay buffers on the edges of the faster ones, so
+	 * that the tokens of a same X reach each merge node on the same
+	 * tick.
+	 * Batches go through the nodes by topological levels, the nodes of
+	 * a level being independent and run at once on the
+	 * Backend::Scheduler, each chain with the batch backend that suits it.
+	 */
+	class Graph {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the number to process as a
+		 * bracket-enclosed list (e.g. {0, 1, 2, 3}).
+		 */
+		Graph(const std::initializer_list<const int> entries);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the numbers to process.
+		 */
+		Graph(std::queue<int> entries);
+		/**
+		 * Borrowing constructor.
+		 * Reads the inputs straight from the memory of the caller,
+		 * which must outlive the computations.
+		 * @param entries First number to process.
+		 * @param count Number of numbers to process.
+		 */
+		Graph(const int *entries, const std::size_t count);
+
+		/**
+		 * Initialize nodes.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * The output of the graph is the last node.
+		 * @param nodes Nodes, in the order of their ids, the input node first.
+		 * @throws std::invalid_argument If a node is neither a chain fed by a single node
+		 * nor a merge of several ones, refers to a node that does not exist, or the nodes form a cycle.
+		 */
+		void setNodes(std::vector<Systolic::GraphNode> nodes);
+		/**
+		 * Initialize nodes.
+		 * Initializes all the nodes with the current instance of the builder.
+		 * @param builder GraphBuilder.
+		 * @throws std::invalid_argument if builder is null.
+		 */
+		void setNodes(std::shared_ptr<Systolic::GraphBuilder> builder);
+		/**
+		 * Choose the node whose outputs are the outputs of the graph.
+		 * Nodes that do not lead to it are not run.
+		 * @param node Id of the node.
+		 * @throws std::invalid_argument If the node does not exist or is the input one.
+		 */
+		void setOutput(const std::size_t node);
+		/**
+		 * Single tick on the graph.
+		 * Injects the next X, moves every token along the edges and
+		 * their delay buffers, then provokes each node to compute.
+		 * Call is ignored if no node is registered.
+		 * @throws std::logic_error If the tokens of a merge node are not aligned.
+		 */
+		void step();
+		/**
+		 * Operate the graph until completion.
+		 * Call is ignored if no node is registered.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Compute the result without simulating the ticks.
+		 * Gives the same outputs as compute, without logs, the tokens in
+		 * flight being first stepped out of the graph.
+		 * Call is ignored if no node is registered.
+		 */
+		void computeBatch();
+		/**
+		 * Tell whether every X went through the graph.
+		 */
+		bool isDone() const;
+		/**
+		 * Get the number of ticks from the injection of an X to its output.
+		 */
+		std::size_t getLatency() const;
+		/**
+		 * Get the delay buffers of the incoming edges of a node.
+		 * @param node Id of the node.
+		 * @return The number of ticks each edge delays its tokens, in
+		 * the order of the predecessors of the node.
+		 * @throws std::invalid_argument If the node does not exist.
+		 */
+		std::vector<std::size_t> getDelays(const std::size_t node) const;
+		/**
+		 * Get the topological levels of the nodes leading to the output.
+		 * The nodes of a level only depend on those of the previous levels.
+		 * @return The ids of the nodes of each level, the input node being alone in the first one.
+		 */
+		std::vector<std::vector<std::size_t>> getLevels() const;
+		/**
+		 * Display the current content of the output queue, as a list of
+		 * no-space comma-separated numbers.
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the outputs of the graph.
+		 */
+		std::queue<int> getOutputs() const;
+		/**
+		 * Get a view over the outputs of the graph, without copying them.
+		 * The view is invalidated by the next computation.
+		 */
+		Util::RingView<int> getOutputView() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<Systolic::GraphNode> nodes;
+		std::vector<std::unique_ptr<Systolic::Container>> chains; /** Container running the cells of each chain node, null for the others. */
+		std::vector<std::size_t> lengths; /** Number of cells of each node, 0 for merges and the input. */
+		std::vector<std::vector<std::size_t>> levels;
+		std::vector<std::vector<std::size_t>> delays; /** Delay of each incoming edge, by node. */
+		std::vector<std::vector<std::deque<std::optional<int>>>> lines; /** Tokens held by the delay buffer of each incoming edge, by node. */
+		std::vector<std::optional<int>> emitted; /** Token left by each node on the last tick. */
+		std::vector<std::size_t> ready; /** Tick at which the token of the first X leaves each node. */
+		std::size_t output;
+		std::vector<int> ownedEntries; /** Inputs given by value, entries pointing to them. */
+		const int *entries;
+		std::size_t count;
+		std::size_t injected; /** Inputs injected so far. */
+		std::size_t produced; /** Outputs produced so far. */
+		Util::RingBuffer<int> outputs;
+		std::vector<std::string> logs;
+
+		void schedule();
+		void tick(const bool inject);
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
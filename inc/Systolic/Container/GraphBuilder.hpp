@@ -0,0 +1,153 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GraphBuilder.hpp
+ * Builder of the nodes of a Graph.
+ */
+
+#pragma once
+
+#include "Systolic/Container/CellArrayBuilder.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Predefined operations of the merge nodes.
+	 * Integer operations wrap around, as the cells do.
+	 */
+	enum class Merge {
+		Sum, /** Sum of the values. */
+		Difference, /** First value minus the following ones. */
+		Product, /** Product of the values. */
+		Min, /** Smallest value. */
+		Max /** Largest value. */
+	};
+
+	/**
+	 * Node of a Graph.
+	 * Node 0 is the input of the graph, which has neither cells nor
+	 * predecessors. Every other node is either a chain of cells, run
+	 * over the outputs of its single predecessor, or a merge node,
+	 * folding the outputs of its predecessors with its operation.
+	 */
+	struct GraphNode {
+		std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells; /** Chain of the node, empty for the input and merge nodes. */
+		std::function<int(const int, const int)> merge; /** Operation of merge nodes, folding their inputs in order. */
+		std::vector<std::size_t> predecessors; /** Nodes whose outputs are the inputs of this one, in order. */
+	};
+
+	/**
+	 * Graph builder.
+	 * Used to create the nodes of a Graph either edge by edge or by
+	 * common shapes, each shape being appended after the last node
+	 * added, starting from the input of the graph.
+	 */
+	class GraphBuilder : public std::enable_shared_from_this<GraphBuilder> {
+	public:
+		/**
+		 * Default constructor.
+		 * Starts with the input node.
+		 */
+		GraphBuilder();
+		/**
+		 * Get a new instance of builder.
+		 */
+		static std::shared_ptr<GraphBuilder> getNew();
+		/**
+		 * Get the operation of a predefined merge.
+		 */
+		static std::function<int(const int, const int)> getMergeOperation(const Merge merge);
+		/**
+		 * Add a chain node fed by a given node.
+		 * @param chain Builder of the cells of the chain, taken as by build.
+		 * @param from Id of the predecessor.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If chain is null or has no cell, or from is not a node.
+		 */
+		std::shared_ptr<GraphBuilder> addChain(std::shared_ptr<Systolic::CellArrayBuilder> chain, const std::size_t from);
+		/**
+		 * Add a merge node fed by given nodes.
+		 * @param merge Operation folding the inputs, in the order of from.
+		 * @param from Ids of the predecessors, at least two.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If there are less than two predecessors or one is not a node.
+		 */
+		std::shared_ptr<GraphBuilder> addMerge(const Merge merge, const std::vector<std::size_t> &from);
+		/**
+		 * Add a merge node folding its inputs with a custom operation.
+		 * @see addMerge(const Merge, const std::vector<std::size_t> &)
+		 */
+		std::shared_ptr<GraphBuilder> addMerge(const std::function<int(const int, const int)> merge,
+						       const std::vector<std::size_t> &from);
+		/**
+		 * Append a chain after the last node.
+		 * @param chain Builder of the cells of the chain.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<GraphBuilder> then(std::shared_ptr<Systolic::CellArrayBuilder> chain);
+		/**
+		 * Append parallel branches after the last node, then merge them.
+		 * Every branch is fed by the last node, as in p(X) and q(X)
+		 * merged by their sum.
+		 * @param branches Builders of the cells of each branch, at least two.
+		 * @param merge Operation folding the outputs of the branches, in order.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<GraphBuilder> parallel(const std::vector<std::shared_ptr<Systolic::CellArrayBuilder>> &branches,
+						       const Merge merge);
+		/**
+		 * Append parallel branches merged with a custom operation.
+		 * @see parallel(const std::vector<std::shared_ptr<Systolic::CellArrayBuilder>> &, const Merge)
+		 */
+		std::shared_ptr<GraphBuilder> parallel(const std::vector<std::shared_ptr<Systolic::CellArrayBuilder>> &branches,
+						       const std::function<int(const int, const int)> merge);
+		/**
+		 * Append a chain whose outputs are merged with its own inputs.
+		 * The last node is the first input of the merge, and the chain the second one.
+		 * @param chain Builder of the cells of the chain.
+		 * @param merge Operation of the merge.
+		 * @return The instance of the builder.
+		 */
+		std::shared_ptr<GraphBuilder> residual(std::shared_ptr<Systolic::CellArrayBuilder> chain, const Merge merge);
+		/**
+		 * Get the id of the last node added, 0 being the input.
+		 */
+		std::size_t getLast() const;
+		/**
+		 * Generate the nodes from previous addition.
+		 * The builder starts over from the input node.
+		 * @return The nodes, in the order of their ids.
+		 */
+		std::vector<Systolic::GraphNode> build();
+	private:
+		static void *operator new(size_t) = delete;
+		static void *operator new[](size_t) = delete;
+		static void operator delete(void *) = delete;
+		static void operator delete[](void *) = delete;
+		void checkNode(const std::size_t id) const;
+		std::vector<Systolic::GraphNode> nodes;
+	};
+}
@@ -0,0 +1,141 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Grid.hpp
+ * Two-dimensional cell container and runner.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/GridCell.hpp"
+#include "Systolic/Container/GridBuilder.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <future>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Two-dimensional cell container and runner.
+	 * Container running a rectangular array of GridCells, each cell
+	 * being linked to its west and north neighbours, over a matrix
+	 * multiplication lhs * rhs.
+	 * The rows of lhs enter the array from the west, skewed by one
+	 * step per row. With an output stationary array, the columns of
+	 * rhs enter from the north, skewed by one step per column, and the
+	 * result is read from the accumulators of the cells. With a weight
+	 * stationary array, rhs is held by the cells and the result leaves
+	 * the array through its bottom row.
+	 */
+	class Grid {
+	public:
+		/**
+		 * Default constructor.
+		 * @param lhs Left operand of the multiplication, as a list of rows.
+		 * @param rhs Right operand of the multiplication, as a list of rows;
+		 * only used by output stationary arrays.
+		 */
+		Grid(const std::vector<std::vector<int>> lhs, const std::vector<std::vector<int>> rhs = {});
+
+		/**
+		 * Initialize cells.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * @param cells Rows of cells, all of the same size and dataflow.
+		 * @throws std::invalid_argument if the cells do not form a rectangle of a single dataflow.
+		 */
+		void setCells(std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> cells);
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells with the current instance of the builder.
+		 * @param builder GridBuilder.
+		 * @throws std::invalid_argument if builder is null.
+		 */
+		void setCells(std::shared_ptr<Systolic::GridBuilder> builder);
+		/**
+		 * Single tick on the array.
+		 * Injects the skewed operands on the west and north edges, moves
+		 * every value to the east and south neighbours then provokes each
+		 * cell to compute its current value.
+		 * Call is ignored if not cell are registered or if the multiplication is done.
+		 * @throws std::invalid_argument if the operands do not match the array.
+		 */
+		void step();
+		/**
+		 * Operate the array until completion.
+		 * Call is ignored if no cell are registered.
+		 * @throws std::invalid_argument if the operands do not match the array.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Compute the result without simulating the ticks.
+		 * Gives the same result as compute, without logs, with a
+		 * multiplication tiled for the cache and whose tiles are spread
+		 * over the Backend::Scheduler.
+		 * Call is ignored if no cell are registered.
+		 * @throws std::invalid_argument if the operands do not match the array.
+		 */
+		void computeBatch();
+		/**
+		 * Tell whether every element of the result is known.
+		 */
+		bool isDone() const;
+		/**
+		 * Get the result of the multiplication, as a list of rows.
+		 * Elements not computed yet are 0.
+		 */
+		std::vector<std::vector<int>> getResult() const;
+		/**
+		 * Display the result on the standard output,
+		 * one comma-separated row per line.
+		 */
+		void dumpResult() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> cells;
+		std::vector<std::vector<int>> lhs;
+		std::vector<std::vector<int>> rhs;
+		std::vector<std::vector<int>> result;
+		std::size_t tick; /** Number of steps done. */
+		std::vector<std::string> logs;
+
+		Systolic::Cell::Dataflow getDataflow() const;
+		std::size_t getStepCount() const;
+		void checkOperands() const;
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
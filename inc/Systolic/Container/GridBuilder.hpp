@@ -0,0 +1,80 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GridBuilder.hpp
+ * Builder of two-dimensional arrays of GridCells.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/GridCell.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include <memory>
+
+namespace Systolic {
+
+	/**
+	 * Two-dimensional systolic array builder.
+	 * Used to create the classic matrix multiplication arrays.
+	 */
+	class GridBuilder : public std::enable_shared_from_this<GridBuilder> {
+	public:
+		/**
+		 * Get a new instance of builder.
+		 */
+		static std::shared_ptr<GridBuilder> getNew();
+		/**
+		 * Define an output stationary array.
+		 * Each cell of the array accumulates one element of the result,
+		 * the rows of the left operand flowing from the west and the
+		 * columns of the right operand flowing from the north.
+		 * Replaces any previously defined array.
+		 * @param rows Number of rows of the left operand and of the result.
+		 * @param cols Number of columns of the right operand and of the result.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If either dimension is 0.
+		 */
+		std::shared_ptr<GridBuilder> outputStationary(const std::size_t rows, const std::size_t cols);
+		/**
+		 * Define a weight stationary array.
+		 * Each cell of the array holds one element of the right operand,
+		 * the rows of the left operand flowing from the west and the
+		 * partial sums flowing downward to the bottom row.
+		 * Replaces any previously defined array.
+		 * @param weights Right operand, as a list of rows.
+		 * @return The instance of the builder.
+		 * @throws std::invalid_argument If the weights are empty or not rectangular.
+		 */
+		std::shared_ptr<GridBuilder> weightStationary(const std::vector<std::vector<int>> &weights);
+		/**
+		 * Generate the systolic array from the previous definition.
+		 * @return The rows of cells of the array.
+		 */
+		std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> build();
+	private:
+		static void *operator new(size_t) = delete;
+		static void *operator new[](size_t) = delete;
+		static void operator delete(void *) = delete;
+		static void operator delete[](void *) = delete;
+		std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> grid;
+	};
+}
@@ -0,0 +1,90 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file JobRunner.hpp
+ * Concurrent runner of independent polynomial evaluations.
+ */
+
+#pragma once
+
+#include "Systolic/Container/Container.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Polynomial evaluation run by a JobRunner.
+	 */
+	struct Job {
+		std::queue<int> coefs; /** Coefficients from the highest degree, unless an equation is given. */
+		std::string equation; /** Equation of the polynomial, used instead of the coefficients when not empty. */
+		std::queue<int> inputs; /** Values of X. */
+	};
+
+	/**
+	 * Outcome of a Job.
+	 */
+	struct JobResult {
+		std::vector<int> outputs; /** Value of the polynomial for each X, in order. */
+		double seconds; /** Time spent on the job, building its cells included. */
+		std::string error; /** Reason of the failure of the job, empty on success. */
+	};
+
+	/**
+	 * Concurrent runner of independent polynomial evaluations.
+	 * Runs each job on its own Container, built from the
+	 * CellArrayBuilder and evaluated with computeBatch, the jobs being
+	 * taken in order by the threads of a Backend::Scheduler, so that a
+	 * long job does not hold back the ones after it. The batch of each
+	 * job runs on the same scheduler, which keeps the busy threads at
+	 * the core count however the jobs are nested.
+	 */
+	class JobRunner {
+	public:
+		/**
+		 * Default constructor.
+		 * @param scheduler Scheduler running the jobs, the one shared
+		 * by the whole process by default.
+		 */
+		JobRunner(Systolic::Backend::Scheduler &scheduler = Systolic::Backend::Scheduler::getInstance());
+
+		/**
+		 * Run every job.
+		 * A job whose cells cannot be built fails with the reason in
+		 * its result, without stopping the other ones.
+		 * @param jobs Jobs to run.
+		 * @return The result of each job, in the order of the jobs.
+		 */
+		std::vector<JobResult> run(const std::vector<Job> &jobs) const;
+		/**
+		 * Get the number of jobs run at once, the workers of the
+		 * scheduler and the thread calling run.
+		 */
+		std::size_t getWorkers() const;
+
+	private:
+		Systolic::Backend::Scheduler &scheduler;
+	};
+}
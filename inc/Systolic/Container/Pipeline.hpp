@@ -0,0 +1,147 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Pipeline.hpp
+ * Chain of containers streaming their outputs to one another.
+ */
+
+#pragma once
+
+#include "Systolic/Container/Container.hpp"
+#include "Util/RingBuffer.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Chain of containers streaming their outputs to one another.
+	 * Each stage is a Container with its own chain of cells, the
+	 * outputs of a stage being the inputs of the next one, such as a
+	 * polynomial followed by a normalization. The inputs go through the
+	 * stages by blocks, handed from one stage to the next through
+	 * bounded buffers shared by both, so that every stage works at the
+	 * same time as the others on its own thread, each block being
+	 * evaluated by the batch backend that suits the stage.
+	 * Stages keep their state from one block to the next, as FIR
+	 * filters do, the outputs being the same as running each stage
+	 * over the whole outputs of the previous one.
+	 */
+	class Pipeline {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the number to process as a
+		 * bracket-enclosed list (e.g. {0, 1, 2, 3}).
+		 */
+		Pipeline(const std::initializer_list<const int> entries);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the numbers to process.
+		 */
+		Pipeline(std::queue<int> entries);
+		/**
+		 * Borrowing constructor.
+		 * Reads the inputs straight from the memory of the caller,
+		 * which must outlive the computation.
+		 * @param entries First number to process.
+		 * @param count Number of numbers to process.
+		 */
+		Pipeline(const int *entries, const std::size_t count);
+
+		/**
+		 * Add a stage at the end of the pipeline.
+		 * @param cells Chain of cells of the stage, in order.
+		 * @throws std::invalid_argument If the chain is empty.
+		 */
+		void addStage(std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells);
+		/**
+		 * Add a stage at the end of the pipeline.
+		 * Takes the cells of the builder, as by build.
+		 * @param builder CellArrayBuilder.
+		 * @throws std::invalid_argument If builder is null or has no cell.
+		 */
+		void addStage(std::shared_ptr<Systolic::CellArrayBuilder> builder);
+		/**
+		 * Set the number of inputs handed from one stage to the next at once.
+		 * Larger blocks lower the synchronisation costs, smaller ones let
+		 * the stages start sooner. 4096 by default.
+		 * @throws std::invalid_argument If the size is 0.
+		 */
+		void setBlockSize(const std::size_t blockSize);
+		/**
+		 * Set the number of blocks each buffer between two stages holds.
+		 * A stage waits for the next one once its buffer is full. 4 by default.
+		 * @throws std::invalid_argument If the depth is 0.
+		 */
+		void setDepth(const std::size_t depth);
+		/**
+		 * Run every input through every stage.
+		 * The last stage runs on the calling thread, every other one on
+		 * a thread of its own. An exception thrown by a stage stops
+		 * every stage, then is thrown again.
+		 * Call is ignored if no stage is registered or no input is left.
+		 */
+		void compute();
+		/**
+		 * Get the number of stages.
+		 */
+		std::size_t getStageCount() const;
+		/**
+		 * Get the time each stage spent evaluating blocks, in seconds,
+		 * over every computation; the busiest stage bounds the throughput.
+		 */
+		std::vector<double> getStageSeconds() const;
+		/**
+		 * Display the current content of the output queue, as a list of
+		 * no-space comma-separated numbers.
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the outputs of the last stage.
+		 */
+		std::queue<int> getOutputs() const;
+		/**
+		 * Get a view over the outputs of the last stage, without copying them.
+		 * The view is invalidated by the next computation.
+		 */
+		Util::RingView<int> getOutputView() const;
+		/**
+		 * Get a copy of the auxiliary values left by the last stage.
+		 * Those of the other stages are dropped.
+		 */
+		std::queue<int> getAuxiliaryOutputs() const;
+
+	private:
+		std::vector<std::unique_ptr<Systolic::Container>> stages;
+		std::vector<double> stageSeconds; /** Time spent evaluating blocks, by stage. */
+		std::vector<int> ownedEntries; /** Inputs given by value, entries pointing to them. */
+		const int *entries;
+		std::size_t count; /** Inputs left. */
+		Util::RingBuffer<int> outputs;
+		Util::RingBuffer<int> auxiliaryOutputs;
+		std::size_t blockSize;
+		std::size_t depth;
+	};
+}
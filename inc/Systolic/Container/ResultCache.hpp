@@ -0,0 +1,96 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ResultCache.hpp
+ * Bounded cache of the results of containers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Bounded cache of results.
+	 * Open-addressing hash table mapping a (pipeline id, X) pair to
+	 * the result of X through that pipeline. Each key is looked for in
+	 * a short window of slots following its hash; once that window is
+	 * full, a new key replaces one of its entries, so that the table
+	 * never grows beyond its capacity.
+	 * A single cache can be shared by several containers, their
+	 * pipeline ids keeping their results apart. It is not thread-safe.
+	 */
+	class ResultCache {
+	public:
+		/**
+		 * Default constructor.
+		 * @param capacity Number of results the cache can hold,
+		 * rounded up to a power of two.
+		 * @throws std::invalid_argument if capacity is 0.
+		 */
+		ResultCache(const std::size_t capacity = 65536);
+
+		/**
+		 * Look for a result.
+		 * @param pipeline Id of the pipeline the result comes from.
+		 * @param x Input of the pipeline.
+		 * @return The result, empty if not cached.
+		 */
+		std::optional<int> find(const std::uint64_t pipeline, const int x) const;
+		/**
+		 * Add or replace a result.
+		 * @param pipeline Id of the pipeline the result comes from.
+		 * @param x Input of the pipeline.
+		 * @param result Output of the pipeline for x.
+		 */
+		void insert(const std::uint64_t pipeline, const int x, const int result);
+		/**
+		 * Forget every result.
+		 */
+		void clear();
+		/**
+		 * Get the number of cached results.
+		 */
+		std::size_t getSize() const;
+		/**
+		 * Get the number of results the cache can hold.
+		 */
+		std::size_t getCapacity() const;
+
+	private:
+		static constexpr std::size_t window = 8; /** Slots a key may be stored in, from its hash. */
+
+		struct Slot {
+			std::uint64_t pipeline;
+			int x;
+			int result;
+			bool used;
+		};
+
+		std::vector<Slot> slots;
+		std::size_t size; /** Number of used slots. */
+
+		std::uint64_t hash(const std::uint64_t pipeline, const int x) const;
+	};
+}
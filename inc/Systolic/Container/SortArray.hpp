@@ -0,0 +1,160 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file SortArray.hpp
+ * Sorting cell container and runner.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/CompareExchangeCell.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <future>
+#include <initializer_list>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Sorting algorithm run by a SortArray.
+	 */
+	enum class Sorting {
+		OddEvenTransposition, /** Each cell holds an entry, neighbours alternately exchange with their left and right one. */
+		PriorityQueue /** Entries flow through the cells, each keeping the smallest value it has seen. */
+	};
+
+	/**
+	 * Sorting cell container and runner.
+	 * Container running a chain of CompareExchangeCells over a stream
+	 * of entries, outputting them in ascending order.
+	 * With the odd-even transposition, the array has one cell per entry
+	 * and sorts them in as many steps as entries, alternately ordering
+	 * the even and the odd pairs of neighbours.
+	 * With the priority queue, the entries enter the first cell one per
+	 * step and ripple through the array, each cell keeping the smallest
+	 * value it has seen and forwarding the other one.
+	 * Once sorted, the values leave the array through its first cell,
+	 * one per step, every other value shifting to the left.
+	 * A limit restricts the outputs to the smallest values (top-k); the
+	 * priority queue then only has as many cells as the limit, the
+	 * values overflowing from its last cell being dropped.
+	 */
+	class SortArray {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the number to sort as a
+		 * bracket-enclosed list (e.g. {3, 0, 2, 1}).
+		 * @param sorting Sorting algorithm of the array.
+		 * @param limit Number of values to output, 0 to output every entry.
+		 */
+		SortArray(const std::initializer_list<const int> entries,
+			  const Sorting sorting = Sorting::OddEvenTransposition, const std::size_t limit = 0);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the numbers to sort.
+		 * @param sorting Sorting algorithm of the array.
+		 * @param limit Number of values to output, 0 to output every entry.
+		 */
+		SortArray(const std::queue<int> entries,
+			  const Sorting sorting = Sorting::OddEvenTransposition, const std::size_t limit = 0);
+
+		/**
+		 * Single tick on the array.
+		 * While sorting, provokes each pair of neighbours to exchange
+		 * (odd-even transposition) or each cell to compute with the
+		 * value forwarded by its left neighbour (priority queue).
+		 * Once sorted, outputs the value of the first cell and shifts
+		 * every other value to the left.
+		 * Call is ignored if there is no entry or if the array is done.
+		 */
+		void step();
+		/**
+		 * Operate the array until completion.
+		 * Call is ignored if there is no entry.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Sort every entry without simulating the ticks.
+		 * Pushes the same values as compute would to the outputs queue,
+		 * without logs, and leaves the cells untouched.
+		 * Entries are split in blocks, one per thread of the
+		 * Backend::Scheduler, each sorted on its own before the blocks are merged by an
+		 * odd-even transposition over the blocks, each exchange merging
+		 * two neighbouring blocks and splitting them back.
+		 * With a limit, each block selects its smallest values instead
+		 * and only those candidates are merged.
+		 * Call is ignored if there is no entry.
+		 */
+		void computeBatch();
+		/**
+		 * Tell whether every expected value has been output.
+		 */
+		bool isDone() const;
+		/**
+		 * Get the number of steps needed to sort the entries,
+		 * before the first value is output.
+		 */
+		std::size_t getLatency() const;
+		/**
+		 * Display the current content of the output queue.
+		 * Displays all values contained within the output queue
+		 * on the standard output, in a First In, First Out
+		 * manner.
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the current output queue.
+		 */
+		std::queue<int> getOutputs() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::unique_ptr<Systolic::Cell::CompareExchangeCell>> cells;
+		std::vector<int> entries; /** Every entry, as given at construction. */
+		std::queue<int> inputs;
+		std::queue<int> outputs;
+		const Sorting sorting;
+		std::size_t limit; /** Number of values to output. */
+		std::size_t tick; /** Number of steps done. */
+		std::vector<std::string> logs;
+
+		void init();
+		void sortStep();
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
@@ -0,0 +1,145 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Trace.hpp
+ * Recorder of the activity of containers, in the Chrome trace event format.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Systolic {
+
+	/**
+	 * Activity recorder.
+	 * Collects timed events from the containers it is given to, and
+	 * exports them in the Chrome trace event format, viewable in
+	 * Perfetto (ui.perfetto.dev) or chrome://tracing.
+	 * Events are put on lanes, grouped by process: the cells of an
+	 * array, the threads running them, the container itself. Spans
+	 * show the work of a lane over time, instants the injection or
+	 * output of a token, counters the evolution of a set of values.
+	 * Recording is thread-safe. Timestamps are in microseconds since
+	 * the creation of the recorder.
+	 */
+	class Trace {
+	public:
+		using Args = std::vector<std::pair<std::string, long long>>; /** Numerical arguments of an event. */
+
+		/**
+		 * Default constructor.
+		 * Starts the clock of the recorder.
+		 */
+		Trace();
+
+		/**
+		 * Get the current timestamp.
+		 */
+		double now() const;
+		/**
+		 * Get the lane of the calling thread in the "threads" group,
+		 * naming it on first use.
+		 */
+		std::size_t getThreadLane();
+		/**
+		 * Name a lane, replacing its previous name.
+		 * @param group Group of the lane (e.g. "cells").
+		 * @param lane Index of the lane in its group.
+		 * @param name Name to display.
+		 */
+		void nameLane(const std::string &group, const std::size_t lane, const std::string &name);
+		/**
+		 * Record some work done by a lane.
+		 * @param group Group of the lane.
+		 * @param lane Index of the lane in its group.
+		 * @param name Name of the work.
+		 * @param start Timestamp of the beginning of the work.
+		 * @param end Timestamp of the end of the work.
+		 * @param args Arguments to display alongside the span.
+		 */
+		void span(const std::string &group, const std::size_t lane, const std::string &name,
+			  const double start, const double end, const Args &args = {});
+		/**
+		 * Record a punctual event of a lane.
+		 * @param group Group of the lane.
+		 * @param lane Index of the lane in its group.
+		 * @param name Name of the event.
+		 * @param timestamp Timestamp of the event.
+		 * @param args Arguments to display alongside the event.
+		 */
+		void instant(const std::string &group, const std::size_t lane, const std::string &name,
+			     const double timestamp, const Args &args = {});
+		/**
+		 * Record the values of a counter.
+		 * @param name Name of the counter.
+		 * @param timestamp Timestamp of the values.
+		 * @param values Value of each series of the counter.
+		 */
+		void counter(const std::string &name, const double timestamp, const Args &values);
+		/**
+		 * Get the number of recorded events, lane names excluded.
+		 */
+		std::size_t getEventCount() const;
+		/**
+		 * Forget every recorded event and lane name.
+		 * The clock is not restarted.
+		 */
+		void clear();
+		/**
+		 * Get the recorded events as a Chrome trace event JSON document.
+		 */
+		std::string toJson() const;
+		/**
+		 * Write the recorded events to a file.
+		 * @param path Path of the JSON file to write.
+		 * @return true on success, false if the file cannot be written.
+		 * @see toJson
+		 */
+		bool save(const std::string &path) const;
+
+	private:
+		struct Event {
+			char phase; /** 'X' for spans, 'i' for instants, 'C' for counters. */
+			std::string name;
+			std::size_t group;
+			std::size_t lane;
+			double timestamp;
+			double duration;
+			Args args;
+		};
+
+		const std::chrono::steady_clock::time_point start;
+		mutable std::mutex mutex;
+		std::vector<Event> events;
+		std::vector<std::string> groups; /** Group names, by process id. */
+		std::map<std::pair<std::size_t, std::size_t>, std::string> laneNames; /** Names by (group, lane). */
+		std::map<std::thread::id, std::size_t> threadLanes;
+
+		std::size_t getGroup(const std::string &group);
+	};
+}
@@ -0,0 +1,159 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file TreeContainer.hpp
+ * Tree-shaped cell container and runner.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/MultiplyAddCell.hpp"
+#include "Systolic/Container/CellArrayBuilder.hpp"
+#include "Systolic/Container/Trace.hpp"
+#include "Util/RingBuffer.hpp"
+#include "Util/OutputWriter.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <future>
+#include <initializer_list>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Tree-shaped cell container and runner.
+	 * Container evaluating polynomials with the Estrin's scheme:
+	 * each input goes through a binary tree of MultiplyAddCells,
+	 * one level per step, alongside a pipeline of the powers of X
+	 * (X, X^2, X^4, …) squared from one level to the next.
+	 * The latency of an evaluation is the depth of the tree, that
+	 * is log2 of the number of coefficients, instead of the number
+	 * of coefficients for a linear Container.
+	 */
+	class TreeContainer {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the number to process as a
+		 * bracket-enclosed list (e.g. {0, 1, 2, 3}).
+		 */
+		TreeContainer(const std::initializer_list<const int> entries);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the numbers to process.
+		 */
+		TreeContainer(const std::queue<int> entries);
+
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells from the given levels, from the leaves to the root.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * @param levels Levels of cells, each level having half the cells of the previous one.
+		 * @throws std::invalid_argument if the levels do not form a binary tree.
+		 */
+		void setCells(std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> levels);
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells with the Estrin's tree of the current instance of the builder.
+		 * @param builder CellArrayBuilder holding polynomial cells.
+		 * @throws std::invalid_argument if builder is null.
+		 * @see Systolic::CellArrayBuilder::buildTree
+		 */
+		void setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder);
+		/**
+		 * Record the activity of the container.
+		 * Every following step records the compute span of each cell,
+		 * the cells being numbered from the first leaf to the root, on
+		 * its own lane and on the lane of the thread running it, the
+		 * injections and outputs of values, and counters of the active
+		 * cells and of the queue depths.
+		 * @param trace Recorder to use, or null to stop recording.
+		 */
+		void setTrace(std::shared_ptr<Systolic::Trace> trace);
+		/**
+		 * Single tick on the tree.
+		 * Injects the next input in the leaves, moves every partial
+		 * result and power of X one level up then provokes each
+		 * cell to compute its current value.
+		 * Call is ignored if not cell are registered.
+		 */
+		void step();
+		/**
+		 * Operate the tree until completion.
+		 * Make the tree work until every inputs have been send
+		 * to the outputs queue.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no inputs are registered.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Display the current content of the output queue.
+		 * Displays all values contained within the output queue
+		 * on the standard output, in a First In, First Out
+		 * manner.
+		 * @see Util::OutputWriter
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the current output queue.
+		 * @see getOutputView
+		 */
+		std::queue<int> getOutputs() const;
+		/**
+		 * Get a view over the current output queue, without copying it.
+		 * The view is invalidated by the next computation.
+		 */
+		Util::RingView<int> getOutputView() const;
+		/**
+		 * Get the number of levels of the tree.
+		 * This is the number of steps an input needs to reach the outputs.
+		 */
+		std::size_t getDepth() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> levels;
+		std::vector<std::optional<int>> powers; /** Power of X reaching each level, as X^(2^level). */
+		Util::RingBuffer<int> inputs; /** Preallocated from the number of entries. */
+		Util::RingBuffer<int> outputs; /** Preallocated from the number of inputs of each computation. */
+		std::vector<std::string> logs;
+		std::shared_ptr<Systolic::Trace> trace;
+		std::size_t tick; /** Number of steps done. */
+
+		std::string makeLogEntry() const;
+		void writeValues(std::stringstream &ss, const Util::RingView<int> &values) const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
@@ -0,0 +1,137 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file WideContainer.hpp
+ * Container evaluating several polynomials over one stream of X.
+ */
+
+#pragma once
+
+#include "Systolic/Cell/WidePolynomialCell.hpp"
+#include "Systolic/Container/CellArrayBuilder.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <initializer_list>
+#include <vector>
+#include <queue>
+
+namespace Systolic {
+
+	/**
+	 * Multi-polynomial cell container and runner.
+	 * Container running a chain of WidePolynomialCells, through which
+	 * each X goes once along with the sums of M polynomials of the same
+	 * degree, instead of one Container per polynomial, each with its own
+	 * copy of the inputs. It delivers one output queue per polynomial.
+	 */
+	class WideContainer {
+	public:
+		/**
+		 * Default constructor.
+		 * @param entries List of the number to process as a
+		 * bracket-enclosed list (e.g. {0, 1, 2, 3}).
+		 */
+		WideContainer(const std::initializer_list<const int> entries);
+		/**
+		 * Preset constructor.
+		 * @param entries A preset queue of the numbers to process.
+		 */
+		WideContainer(const std::queue<int> entries);
+
+		/**
+		 * Initialize cells.
+		 * The vector is moved and so becomes invalid after a call to this function.
+		 * @param cells Cells in order, all for the same number of polynomials.
+		 * @throws std::invalid_argument if the cells do not have the same width.
+		 */
+		void setCells(std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> cells);
+		/**
+		 * Initialize cells.
+		 * Initializes all the cells with the polynomial matrices of the current instance of the builder.
+		 * @param builder CellArrayBuilder.
+		 * @throws std::invalid_argument if builder is null.
+		 * @see Systolic::CellArrayBuilder::buildWide
+		 */
+		void setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder);
+		/**
+		 * Single tick on the operation chain.
+		 * Feeds the first cell with the next input, every other cell
+		 * with the X and sums of the previous one, then provokes each
+		 * cell to compute its current values.
+		 * Call is ignored if not cell are registered.
+		 */
+		void step();
+		/**
+		 * Operate the chain until completion.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no inputs are registered.
+		 * @see step
+		 */
+		void compute();
+		/**
+		 * Evaluate every input without simulating the ticks.
+		 * Pushes the same values as compute would to the output queues,
+		 * but without logs. Inputs are split in blocks spread over
+		 * the Backend::Scheduler, the sums of a block
+		 * being laid out by X then by polynomial so that each Horner's
+		 * step is vectorized across the polynomials.
+		 * Call is ignored if no cell are registered.
+		 * Call is also ignore if no inputs are registered.
+		 */
+		void computeBatch();
+		/**
+		 * Display the current content of the output queues.
+		 * One line per polynomial, as a list of comma-separated numbers.
+		 */
+		void dumpOutputs() const;
+		/**
+		 * Get a copy of the current output queues, one per polynomial.
+		 */
+		std::vector<std::queue<int>> getOutputs() const;
+		/**
+		 * Get the number of polynomials evaluated by the cells.
+		 */
+		std::size_t getWidth() const;
+
+		/**
+		 * Get a textual representation of the current state.
+		 * @return A visual textual log.
+		 */
+		std::string getCurrentStateLog() const;
+		/**
+		 * Get a textual representation of past and current states.
+		 * @return A visual textual log.
+		 */
+		std::string getLog() const;
+	private:
+		std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> cells;
+		std::queue<int> inputs;
+		std::vector<std::queue<int>> outputs; /** Outputs of each polynomial. */
+		std::vector<std::string> logs;
+		std::size_t tick; /** Number of steps done. */
+
+		std::string makeLogEntry() const;
+		std::string optionalToString(std::optional<int> value) const;
+	};
+}
@@ -27,6 +27,27 @@
 #include "Systolic/Cell/Types.hpp"
 #include "Systolic/Container/Container.hpp"
 #include "Systolic/Container/CellArrayBuilder.hpp"
+#include "Systolic/Container/TreeContainer.hpp"
+#include "Systolic/Container/Grid.hpp"
+#include "Systolic/Container/GridBuilder.hpp"
+#include "Systolic/Container/SortArray.hpp"
+#include "Systolic/Container/BidirectionalContainer.hpp"
+#include "Systolic/Container/BandBuilder.hpp"
+#include "Systolic/Container/Trace.hpp"
+#include "Systolic/Container/ResultCache.hpp"
+#include "Systolic/Container/WideContainer.hpp"
+#include "Systolic/Backend/NewtonSolver.hpp"
+#include "Systolic/Backend/RollingHash.hpp"
+#include "Systolic/Container/BasicContainer.hpp"
+#include "Systolic/Container/JobRunner.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+#include "Systolic/Cell/ContainerCell.hpp"
+#include "Systolic/Container/Pipeline.hpp"
+#include "Systolic/Container/GraphBuilder.hpp"
+#include "Systolic/Container/Graph.hpp"
+#include "Systolic/Container/CostModel.hpp"
+#include "Systolic/Container/BatchEvaluator.hpp"
+#include "Systolic/Container/Checkpointer.hpp"
 
 /*! \mainpage Systolic Simulator
  * \section Presentation
@@ -42,7 +63,53 @@
  *
  * The Container can then be used to solves the equation either step by step, using the `Systolic::Container::step` function or until completion using the `Systolic::Container::compute` function.
  *
- * Results and logs of the computations, partial or completed, can be queried using respectively `Systolic::Container::dumpOutputs`, `Systolic::Container::getCurrentStateLog` or `Systolic::Container::getLog`.
+ * When the logs are not needed, `Systolic::Container::computeBatch` gives the same outputs without simulating the steps, using the `Systolic::Backend::PolynomialEvaluator` for chains of polynomial cells.
+ *
+ * Once `Systolic::Container::setIncremental` is enabled, `Systolic::Container::setCoef` changes a coefficient of the chain and updates the results of the last batch instead of evaluating them again.
+ *
+ * A `Systolic::ResultCache` given to `Systolic::Container::setCache` lets `Systolic::Container::computeBatch` evaluate each distinct X of a stateless chain only once, across batches; `Systolic::Container::getStats` reports the hit rate.
+ *
+ * The cells added to a builder can be saved to a binary pipeline file by `Systolic::CellArrayBuilder::savePipeline` and loaded back without any parsing by `Systolic::CellArrayBuilder::fromPipelineFile`, custom cells being referred to by the name given to `Systolic::CellArrayBuilder::registerCustomCell`.
+ *
+ * Pipelines mixing any kind of cells can be written as text, such as `add 3 | mul 2 | pow 3 | div 7`, and added by `Systolic::CellArrayBuilder::fromPipelineDescription`; the CLI takes them from its `--pipeline` and `--pipeline-file` options.
+ *
+ * A chain of cells can be nested as a single `Systolic::Cell::ContainerCell` of another chain by `Systolic::CellArrayBuilder::addNested`, fed by the previous cell as a stage or added to its sum, and chains feeding one another are streamed by a `Systolic::Pipeline`, whose stages run concurrently and hand their outputs over by blocks.
+ *
+ * Chains can also form a directed acyclic graph, such as p(X) and q(X) computed side by side then added, built by a `Systolic::GraphBuilder` and run by a `Systolic::Graph`: merge nodes combine the outputs of several nodes, the edges of the faster branches are given delay buffers so that the tokens of a same X meet, and the independent nodes of a batch run at once.
+ *
+ * A `Systolic::CostModel` gives each type of cell a latency and an initiation interval in clock cycles, such as divisions taking 16 cycles and pipelined powers, and `Systolic::Container::estimateCost` schedules the inputs through the cells accordingly, as an analytic estimate that leaves the one-tick steps unchanged, reporting the cycles, the utilization of the array, its bottleneck cells and its steady-state throughput without running the inputs.
+ *
+ * Chains of `Systolic::Cell::DualPolynomialCell`, built by passing `true` to `Systolic::CellArrayBuilder::fromPolynomialCoefs` or `Systolic::CellArrayBuilder::fromPolynomialEquation`, output the derivative of the polynomial through `Systolic::Container::getAuxiliaryOutputs`; the `Systolic::Backend::NewtonSolver` iterates many starting points over such an evaluation.
+ *
+ * A `Systolic::WideContainer` evaluates the polynomials given to `Systolic::CellArrayBuilder::fromPolynomialMatrix` over a single stream of X, with one output queue per polynomial.
+ *
+ * Cells are written against `Systolic::Cell::BasicICell`, templated on the type of their values, `Systolic::Cell::ICell` being its integer form. Polynomials over 64-bit integers, doubles or Q16.16 fixed-point numbers (`Systolic::Backend::Q16`) are run by a `Systolic::BasicContainer` whose cells are given by the `Systolic::BasicCellArrayBuilder`, the arithmetic of each type being provided by `Systolic::Backend::ValueTraits`.
+ *
+ * Modular polynomials are built with `Systolic::CellArrayBuilder::fromModularPolynomialCoefs` and their batches evaluated by the `Systolic::Backend::ModularEvaluator`, with Montgomery or Barrett reductions; the `Systolic::Backend::RollingHash` uses the same arithmetic to hash the windows of buffers and memory-mapped files.
+ *
+ * Polynomials can also be evaluated by a `Systolic::TreeContainer`, using the Estrin's scheme tree given by `Systolic::CellArrayBuilder::buildTree`, whose latency grows with the logarithm of the degree instead of the degree itself.
+ *
+ * FIR filters are built with `Systolic::CellArrayBuilder::fromFirTaps`, and their batches filtered chunk by chunk by the `Systolic::Backend::FirFilter`.
+ *
+ * Matrix multiplications are run by a `Systolic::Grid`, a two-dimensional array whose output stationary or weight stationary cells are given by the `Systolic::GridBuilder`.
+ *
+ * Products of band matrices by vectors are run by a `Systolic::BidirectionalContainer`, whose cells, one per diagonal given by the `Systolic::BandBuilder`, see X flowing forward and Y flowing backward.
+ *
+ * Streams are sorted by a `Systolic::SortArray`, a chain of compare-exchange cells running either an odd-even transposition or a systolic priority queue, optionally limited to the smallest values.
+ *
+ * The activity of the cells on each step can be recorded by a `Systolic::Trace`, given to `Systolic::Container::setTrace`, and exported in the Chrome trace event format.
+ *
+ * Independent polynomial evaluations, given as `Systolic::Job`s, are run concurrently by a `Systolic::JobRunner`, each on its own container.
+ *
+ * The cells of each step and the blocks of the batch computations are run by a `Systolic::Backend::Scheduler`, a work-stealing scheduler shared by the whole process, which keeps the busy threads at the core count and reports its queue depth and steals.
+ *
+ * `Systolic::Container::computeAsync` runs a container on the scheduler, tick by tick or tile by tile, reporting its progress and partial outputs to a `Systolic::ProgressCallback` until done or cancelled through a `Systolic::CancellationToken`.
+ *
+ * `Systolic::Container::saveCheckpoint` saves the registers of the cells, the inputs read and the outputs produced so far to a binary file replaced atomically, `Systolic::Container::loadCheckpoint` resumes from it, and `Systolic::Container::setCheckpoints` saves one periodically.
+ *
+ * A `Systolic::Container` built from a contiguous range of int, or given one through `Systolic::Container::setInputs`, borrows its inputs and reads them in place, that memory having to outlive the computations and to stay unchanged until every input went through.
+ *
+ * Results and logs of the computations, partial or completed, can be queried using respectively `Systolic::Container::dumpOutputs`, `Systolic::Container::getCurrentStateLog` or `Systolic::Container::getLog`; `Systolic::Container::getOutputView` gives the outputs without copying them.
  *
  * <hr>
  * \section Credits
@@ -0,0 +1,137 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BinaryFile.hpp
+ * Compact binary files, written atomically.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Util {
+
+	/**
+	 * Writer of binary files.
+	 * Appends values in their native representation to a buffer, then
+	 * writes it to a temporary file renamed over the destination, so
+	 * that the destination is either left untouched or entirely
+	 * replaced, even if the process is killed while writing.
+	 */
+	class BinaryWriter {
+	public:
+		/**
+		 * Append a trivially copyable value.
+		 */
+		template <typename T>
+		void put(const T &value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written.");
+			putBytes(&value, sizeof(T));
+		}
+		/**
+		 * Append raw bytes.
+		 */
+		void putBytes(const void *bytes, const std::size_t size);
+		/**
+		 * Append a string, preceded by its length.
+		 */
+		void putString(const std::string &value);
+		/**
+		 * Get the number of bytes appended so far.
+		 */
+		std::size_t getSize() const;
+		/**
+		 * Write the buffer to the given file.
+		 * The buffer is written and synced to path.tmp first, then
+		 * renamed to path.
+		 * @param path Path of the file.
+		 * @return false if the file could not be written, the
+		 * destination being left untouched.
+		 */
+		bool commit(const std::string &path) const;
+		/**
+		 * Write the buffer at the given offset of a file, in place.
+		 * What followed the offset is cut, and the file is synced, as
+		 * to append to logs of which another file records the size.
+		 * @param path Path of the file, created if missing.
+		 * @param offset Offset of the buffer, at most the size of the file.
+		 * @return false if the file could not be written.
+		 */
+		bool writeAt(const std::string &path, const std::uint64_t offset) const;
+
+	private:
+		std::vector<unsigned char> buffer;
+	};
+
+	/**
+	 * Reader of the values appended by a BinaryWriter.
+	 * Reads from memory, typically a MappedFile, without copying it.
+	 */
+	class BinaryReader {
+	public:
+		/**
+		 * Default constructor.
+		 * @param data Bytes to read, which must outlive the reader.
+		 * @param size Number of bytes.
+		 */
+		BinaryReader(const unsigned char *data, const std::size_t size);
+
+		/**
+		 * Read a trivially copyable value.
+		 * @throws std::runtime_error if the data is truncated.
+		 */
+		template <typename T>
+		T get()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read.");
+			T value;
+
+			std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+			return value;
+		}
+		/**
+		 * Read a string, preceded by its length.
+		 * @throws std::runtime_error if the data is truncated.
+		 */
+		std::string getString();
+		/**
+		 * Skip bytes.
+		 * @return The skipped bytes, read in place.
+		 * @throws std::runtime_error if the data is truncated.
+		 */
+		const unsigned char *skip(const std::size_t size);
+		/**
+		 * Get the number of bytes left.
+		 */
+		std::size_t getRemaining() const;
+
+	private:
+		const unsigned char *data;
+		std::size_t size;
+		std::size_t offset; /** Bytes read so far. */
+	};
+}
@@ -0,0 +1,72 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file MappedFile.hpp
+ * Read-only memory mapping of a file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Util {
+
+	/**
+	 * Read-only memory mapping of a whole file.
+	 * The file is mapped for the lifetime of the instance, so that its
+	 * content is read from the page cache without being copied.
+	 */
+	class MappedFile {
+	public:
+		/**
+		 * Default constructor.
+		 * Maps the given file, if possible.
+		 * @param path Path of the file.
+		 * @see isOpen
+		 */
+		MappedFile(const std::string &path);
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		/**
+		 * Unmaps the file.
+		 */
+		~MappedFile();
+
+		/**
+		 * Tell whether the file could be mapped.
+		 * Empty files are open, with a null data pointer.
+		 */
+		bool isOpen() const;
+		/**
+		 * Get the content of the file.
+		 */
+		const unsigned char *getData() const;
+		/**
+		 * Get the size of the file, in bytes.
+		 */
+		std::size_t getSize() const;
+
+	private:
+		const unsigned char *data;
+		std::size_t size;
+		bool open;
+	};
+}
@@ -0,0 +1,123 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file OutputWriter.hpp
+ * Buffered writer of the results.
+ */
+
+#pragma once
+
+#include "Util/RingBuffer.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Util {
+
+	/**
+	 * Layouts of the results.
+	 */
+	enum class OutputFormat {
+		Comma, /** Results separated by commas, on a single line. */
+		Newline, /** One result per line. */
+		Csv, /** A x,y header, then one line per input and result. */
+		Binary /** Results as native 32-bit integers, without separators. */
+	};
+
+	/**
+	 * Buffered writer of the results.
+	 * Formats the results with std::to_chars into a large buffer,
+	 * written to the file descriptor with a single system call each
+	 * time it is full, instead of going through the formatting and
+	 * locking of the standard streams for every value.
+	 */
+	class OutputWriter {
+	public:
+		/**
+		 * Get the format of the given name.
+		 * @param name One of comma, newline, csv or binary.
+		 * @throws std::invalid_argument if the name is unknown.
+		 */
+		static OutputFormat parseFormat(const std::string &name);
+
+		/**
+		 * Default constructor.
+		 * Writes to an open file descriptor, left open on destruction.
+		 * @param format Layout of the results.
+		 * @param fd File descriptor, the standard output by default.
+		 */
+		OutputWriter(const OutputFormat format, const int fd = 1);
+		/**
+		 * File constructor.
+		 * Creates, or truncates, the given file and writes to it.
+		 * @param format Layout of the results.
+		 * @param path Path of the file.
+		 * @see isOpen
+		 */
+		OutputWriter(const OutputFormat format, const std::string &path);
+		OutputWriter(const OutputWriter &) = delete;
+		OutputWriter &operator=(const OutputWriter &) = delete;
+		/**
+		 * Flushes the buffer, then closes the file opened by the writer, if any.
+		 */
+		~OutputWriter();
+
+		/**
+		 * Tell whether the file could be opened.
+		 */
+		bool isOpen() const;
+		/**
+		 * Write a list of results.
+		 * Buffered until the buffer is full or flush is called.
+		 * @param outputs Results, in order.
+		 * @param inputs Inputs of the results, only written by the CSV
+		 * format, whose x column is left empty past the last input.
+		 */
+		void write(const Util::RingView<int> &outputs, const Util::RingView<int> &inputs = Util::RingView<int>());
+		/**
+		 * Write the buffer to the file descriptor.
+		 * The standard output stream is flushed first when writing to
+		 * the standard output, as to keep the order of the messages.
+		 * @return false if the buffer could not be written.
+		 */
+		bool flush();
+		/**
+		 * Get the number of bytes written so far, buffered ones included.
+		 */
+		std::size_t getWrittenBytes() const;
+
+	private:
+		static constexpr std::size_t bufferSize = std::size_t(1) << 16;
+		static constexpr std::size_t maxValueSize = 24; /** Longest formatted value, with its separators. */
+
+		OutputFormat format;
+		int fd;
+		bool owned; /** Whether the file descriptor was opened by the writer. */
+		bool failed; /** Whether a write failed, as to report it once. */
+		std::vector<char> buffer;
+		std::size_t used; /** Bytes of the buffer in use. */
+		std::size_t written; /** Bytes written to the file descriptor. */
+
+		void reserve(const std::size_t bytes);
+		void append(const int value);
+		void append(const char c);
+	};
+}
@@ -26,9 +26,14 @@
 #include <string>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 #include <stdexcept>
 #include <regex>
 #include <cstring>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 
 namespace Util {
 
@@ -43,14 +48,18 @@ namespace Util {
 		 * Add the command line argument into the provided map.
 		 * Expected arguments are --with-x=[0-9]+ and either 
 		 * --coefs=[0-9]+(,[0-9]+, …) or 
-		 * --equation=Cn*X^N(+Cn-1*X^N-1+…).
+		 * --equation=Cn*X^N(+Cn-1*X^N-1+…), unless --hash-file is given.
+		 * With --hash-file or --jobs-file, no polynomial is expected.
+		 * Decimal values are accepted unless --type is int32 or int64,
+		 * and --equation only with those types.
 		 * @param map Map to fill.
 		 * @param args Command lines arguments.
 		 * @throw invalid_argument when the value of coefs 
 		 * with-x or equation is not properly formatted.
 		 * @return (1) true if all fields are set as expected or
-		 * (2) false if --with-x is not set and both --coefs and
-		 * --equation are either set or unset.
+		 * (2) false if, without --hash-file, --with-x is not set,
+		 * both --coefs and --equation are either set or unset, or
+		 * --equation is given with a non integer --type.
 		 */
 		static bool setArgs(std::unordered_map<std::string, std::string> &map, char **args);
 		/**
@@ -67,5 +76,30 @@ namespace Util {
 		 * @return A queue with all numbers in order.
 		 */
 		static std::queue<int> listToQueue(std::string strList);
+		/**
+		 * Split a comma-separated list into its items, as to convert them to any type.
+		 * @return The items in order, empty ones included.
+		 */
+		static std::vector<std::string> splitList(std::string strList);
+		/**
+		 * Read the jobs of a jobs file.
+		 * Each line holds the options of a job, separated by spaces:
+		 * either --coefs= or --equation=, and either --with-x= or
+		 * --with-x-file=, the values being the same as on the command
+		 * line. Blank lines and lines starting with # are ignored.
+		 * @param path Path of the jobs file.
+		 * @param jobs Filled with the options of each job, in order.
+		 * @return false, the reason being printed with the line number,
+		 * if the file cannot be read or a line is not a valid job.
+		 */
+		static bool readJobs(const std::string &path, std::vector<std::unordered_map<std::string, std::string>> &jobs);
+		/**
+		 * Read integers separated by commas, spaces or new lines from a file.
+		 * @param path Path of the file.
+		 * @param values Filled with the integers, in order.
+		 * @return false, the reason being printed, if the file cannot
+		 * be read or a value is not a valid integer.
+		 */
+		static bool readValues(const std::string &path, std::queue<int> &values);
 	};
 }
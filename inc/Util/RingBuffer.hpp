@@ -0,0 +1,323 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file RingBuffer.hpp
+ * Contiguous first in, first out queue and its views.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+namespace Util {
+
+	/**
+	 * Tells whether Range holds contiguous values of type T, as
+	 * std::vector, std::array or C arrays do.
+	 */
+	template <typename Range, typename T, typename = void>
+	struct IsContiguousRange : std::false_type {};
+
+	template <typename Range, typename T>
+	struct IsContiguousRange<Range, T, std::void_t<decltype(std::size(std::declval<const Range &>()))>>
+		: std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Range &>()))>>, T> {};
+
+	/**
+	 * Tells whether Iterator walks contiguous values of type T, as
+	 * pointers and std::vector iterators do.
+	 */
+	template <typename Iterator, typename T>
+	constexpr bool isContiguousIterator = std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iterator>>, T>
+		|| std::is_same_v<Iterator, typename std::vector<T>::iterator>
+		|| std::is_same_v<Iterator, typename std::vector<T>::const_iterator>;
+
+	/**
+	 * Read-only view over the content of a RingBuffer.
+	 * The content is made of at most two contiguous segments, the
+	 * second one being empty unless the content wraps around the end
+	 * of the buffer. Views do not copy anything, and are invalidated
+	 * by any change of their buffer.
+	 */
+	template <typename T>
+	class RingView {
+	public:
+		/**
+		 * Iterator over the values of a view, from the oldest one.
+		 */
+		class Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T *;
+			using reference = const T &;
+
+			Iterator() : view(nullptr), index(0) {}
+			Iterator(const RingView *view, const std::size_t index) : view(view), index(index) {}
+
+			reference operator*() const { return (*view)[index]; }
+			Iterator &operator++() { index++; return *this; }
+			Iterator operator++(int) { Iterator old = *this; index++; return old; }
+			bool operator==(const Iterator &other) const { return index == other.index; }
+			bool operator!=(const Iterator &other) const { return index != other.index; }
+
+		private:
+			const RingView *view;
+			std::size_t index;
+		};
+
+		/**
+		 * Default constructor, of an empty view.
+		 */
+		RingView() : first(nullptr), firstSize(0), second(nullptr), secondSize(0) {}
+		/**
+		 * View over two segments, the values of the first one coming first.
+		 */
+		RingView(const T *first, const std::size_t firstSize, const T *second, const std::size_t secondSize)
+			: first(first), firstSize(firstSize), second(second), secondSize(secondSize) {}
+		/**
+		 * View over a single segment.
+		 */
+		RingView(const T *values, const std::size_t size) : RingView(values, size, nullptr, 0) {}
+
+		/**
+		 * Get the number of values.
+		 */
+		std::size_t size() const { return firstSize + secondSize; }
+		/**
+		 * Tell whether there is no value.
+		 */
+		bool empty() const { return size() == 0; }
+		/**
+		 * Get the i-th value, from the oldest one.
+		 */
+		const T &operator[](const std::size_t i) const { return (i < firstSize ? first[i] : second[i - firstSize]); }
+		const T &front() const { return (*this)[0]; }
+		const T &back() const { return (*this)[size() - 1]; }
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, size()); }
+		/**
+		 * Get the oldest values, contiguous in memory.
+		 */
+		const T *getFirstSegment() const { return first; }
+		std::size_t getFirstSize() const { return firstSize; }
+		/**
+		 * Get the values following the first segment, contiguous in memory.
+		 */
+		const T *getSecondSegment() const { return second; }
+		std::size_t getSecondSize() const { return secondSize; }
+		/**
+		 * Copy the values, in order.
+		 */
+		std::vector<T> toVector() const
+		{
+			std::vector<T> res(first, first + firstSize);
+
+			res.insert(res.end(), second, second + secondSize);
+			return res;
+		}
+
+		bool operator==(const RingView &other) const
+		{
+			return size() == other.size() && std::equal(begin(), end(), other.begin());
+		}
+		bool operator!=(const RingView &other) const { return !(*this == other); }
+
+	private:
+		const T *first;
+		std::size_t firstSize;
+		const T *second;
+		std::size_t secondSize;
+	};
+
+	/**
+	 * First in, first out queue over a single contiguous buffer.
+	 * Values are pushed after the newest one and popped from the
+	 * oldest one, wrapping around the end of the buffer, so that no
+	 * allocation happens as long as the capacity is enough. When it is
+	 * not, the capacity doubles and the values are moved back to the
+	 * start of the buffer.
+	 * A buffer can also borrow values from the memory of its caller,
+	 * popping them from there without copying them, until a value is
+	 * pushed: the values left are then copied into the buffer first.
+	 */
+	template <typename T>
+	class RingBuffer {
+	public:
+		/**
+		 * Default constructor.
+		 * @param capacity Number of values to allocate room for.
+		 */
+		RingBuffer(const std::size_t capacity = 0) : buffer(capacity), borrowed(nullptr), head(0), count(0) {}
+
+		/**
+		 * Replace the content by values read from the caller memory.
+		 * The memory must outlive the buffer, or the next push or
+		 * clear, and stay unchanged meanwhile.
+		 * @param values First value, the oldest one.
+		 * @param size Number of values.
+		 */
+		void borrow(const T *values, const std::size_t size)
+		{
+			borrowed = values;
+			head = 0;
+			count = size;
+		}
+		/**
+		 * Tell whether the values are read from the caller memory.
+		 */
+		bool isBorrowed() const { return borrowed != nullptr; }
+		/**
+		 * Allocate room for at least the given number of values.
+		 * Never shrinks the buffer.
+		 */
+		void reserve(const std::size_t capacity)
+		{
+			if (capacity <= buffer.size()) {
+				return;
+			}
+			if (borrowed != nullptr) { // Nothing to move, the values are elsewhere.
+				buffer.resize(capacity);
+				return;
+			}
+
+			std::vector<T> grown(capacity);
+
+			for (std::size_t i = 0; i != count; i++) {
+				grown[i] = std::move(buffer[index(i)]);
+			}
+			buffer.swap(grown);
+			head = 0;
+		}
+		/**
+		 * Add a value after the newest one.
+		 */
+		void push(const T &value)
+		{
+			if (borrowed != nullptr) {
+				adopt();
+			}
+			if (count == buffer.size()) {
+				reserve(std::max<std::size_t>(16, buffer.size() * 2));
+			}
+			buffer[index(count)] = value;
+			count++;
+		}
+		/**
+		 * Remove the oldest value.
+		 * Calling it on an empty buffer is undefined, as for std::queue.
+		 */
+		void pop()
+		{
+			head = (borrowed == nullptr && head + 1 == buffer.size() ? 0 : head + 1);
+			count--;
+		}
+		/**
+		 * Remove the given number of oldest values.
+		 * Removing more values than there are is undefined.
+		 */
+		void pop(const std::size_t values)
+		{
+			head = (borrowed == nullptr ? index(values) : head + values);
+			count -= values;
+		}
+		/**
+		 * Replace the i-th value, from the oldest one.
+		 * Borrowed values are copied into the buffer first.
+		 */
+		void set(const std::size_t i, const T &value)
+		{
+			if (borrowed != nullptr) {
+				adopt();
+			}
+			buffer[index(i)] = value;
+		}
+		/**
+		 * Remove every value, keeping the capacity.
+		 */
+		void clear()
+		{
+			borrowed = nullptr;
+			head = 0;
+			count = 0;
+		}
+		const T &front() const { return (borrowed != nullptr ? borrowed[head] : buffer[head]); }
+		const T &back() const { return (borrowed != nullptr ? borrowed[head + count - 1] : buffer[index(count - 1)]); }
+		std::size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		std::size_t capacity() const { return buffer.size(); }
+		/**
+		 * Get a view over the values, from the oldest one.
+		 * @see RingView
+		 */
+		RingView<T> view() const
+		{
+			if (borrowed != nullptr) {
+				return RingView<T>(borrowed + head, count);
+			}
+
+			const std::size_t firstSize = std::min(count, buffer.size() - head);
+
+			return RingView<T>(buffer.data() + head, firstSize, buffer.data(), count - firstSize);
+		}
+		/**
+		 * Copy the values into a queue, from the oldest one.
+		 */
+		std::queue<T> toQueue() const
+		{
+			std::queue<T> res;
+
+			for (const T &value : view()) {
+				res.push(value);
+			}
+			return res;
+		}
+
+	private:
+		std::vector<T> buffer;
+		const T *borrowed; /** Caller memory holding the values, if any. */
+		std::size_t head; /** Index of the oldest value. */
+		std::size_t count; /** Number of values. */
+
+		/* Copy the borrowed values left into the buffer. */
+		void adopt()
+		{
+			std::vector<T> own(std::max<std::size_t>(16, std::max(buffer.size(), count * 2)));
+
+			std::copy(borrowed + head, borrowed + head + count, own.begin());
+			buffer.swap(own);
+			borrowed = nullptr;
+			head = 0;
+		}
+
+		/* Index in the buffer of the i-th value. */
+		std::size_t index(const std::size_t i) const
+		{
+			const std::size_t j = head + i;
+
+			return (j >= buffer.size() ? j - buffer.size() : j);
+		}
+	};
+}
@@ -0,0 +1,69 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicPolynomialEvaluator.cpp
+ * Implementation of BasicPolynomialEvaluator.
+ */
+
+#include "Systolic/Backend/BasicPolynomialEvaluator.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+
+template <typename T>
+Systolic::Backend::BasicPolynomialEvaluator<T>::BasicPolynomialEvaluator(const std::vector<T> &coefs)
+	: coefs(coefs)
+{
+}
+
+template <typename T>
+void Systolic::Backend::BasicPolynomialEvaluator<T>::evaluate(const T *xs, T *outputs, const std::size_t count) const
+{
+	const std::size_t blocks = (count + blockSize - 1) / blockSize;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(blocks, [&](const std::size_t b){
+			T sum[blockSize];
+			const std::size_t start = b * blockSize;
+			const std::size_t length = std::min(blockSize, count - start);
+			const T *x = xs + start;
+
+			std::fill(sum, sum + length, T{});
+			for (const T coef : coefs) {
+				for (std::size_t i = 0; i != length; i++) {
+					sum[i] = ValueTraits<T>::multiplyAdd(sum[i], x[i], coef);
+				}
+			}
+			std::copy(sum, sum + length, outputs + start);
+		});
+}
+
+template <typename T>
+std::vector<T> Systolic::Backend::BasicPolynomialEvaluator<T>::evaluate(const std::vector<T> &xs) const
+{
+	std::vector<T> res(xs.size());
+
+	evaluate(xs.data(), res.data(), xs.size());
+	return res;
+}
+
+template class Systolic::Backend::BasicPolynomialEvaluator<std::int32_t>;
+template class Systolic::Backend::BasicPolynomialEvaluator<std::int64_t>;
+template class Systolic::Backend::BasicPolynomialEvaluator<double>;
+template class Systolic::Backend::BasicPolynomialEvaluator<Systolic::Backend::Q16>;
@@ -0,0 +1,91 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file FirFilter.cpp
+ * Implementation of FirFilter.
+ */
+
+#include "Systolic/Backend/FirFilter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+Systolic::Backend::FirFilter::FirFilter(const std::vector<int> &taps)
+	: reversedTaps(taps.rbegin(), taps.rend()), window(taps.size() + blockSize, 0)
+{
+	if (taps.empty()) {
+		throw std::invalid_argument("Cannot declare a FIR filter without taps.");
+	}
+}
+
+void Systolic::Backend::FirFilter::process(const int *samples, int *outputs, const std::size_t count)
+{
+	const std::size_t taps = reversedTaps.size();
+	const std::uint32_t *h = reversedTaps.data();
+	std::uint32_t *w = window.data();
+
+	for (std::size_t start = 0; start < count; start += blockSize) {
+		const std::size_t length = std::min(blockSize, count - start);
+
+		/* The window holds the last samples of the previous block followed by the current one. */
+		std::copy(samples + start, samples + start + length, w + taps);
+		for (std::size_t i = 0; i != length; i++) {
+			const std::uint32_t *x = w + i + 1; // Oldest sample used by this output.
+			std::uint32_t sum = 0;
+
+			for (std::size_t k = 0; k != taps; k++) { // Unsigned arithmetic, as to wrap around as FirCell does.
+				sum += h[k] * x[k];
+			}
+			outputs[start + i] = static_cast<int>(sum);
+		}
+		std::copy(w + length, w + length + taps, w);
+	}
+}
+
+std::vector<int> Systolic::Backend::FirFilter::process(const std::vector<int> &samples)
+{
+	std::vector<int> res(samples.size());
+
+	process(samples.data(), res.data(), samples.size());
+	return res;
+}
+
+void Systolic::Backend::FirFilter::reset()
+{
+	std::fill(window.begin(), window.end(), 0);
+}
+
+std::vector<int> Systolic::Backend::FirFilter::getHistory() const
+{
+	return std::vector<int>(window.begin(), window.begin() + reversedTaps.size());
+}
+
+void Systolic::Backend::FirFilter::setHistory(const std::vector<int> &history)
+{
+	if (history.size() != reversedTaps.size()) {
+		throw std::invalid_argument("FIR filter history must have as many samples as taps.");
+	}
+	std::copy(history.begin(), history.end(), window.begin());
+}
+
+std::size_t Systolic::Backend::FirFilter::getTapCount() const
+{
+	return reversedTaps.size();
+}
@@ -0,0 +1,79 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ModularEvaluator.cpp
+ * Implementation of ModularEvaluator.
+ */
+
+#include "Systolic/Backend/ModularEvaluator.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+
+Systolic::Backend::ModularEvaluator::ModularEvaluator(const std::vector<std::int64_t> &coefs, const std::uint64_t modulus,
+						      const Reduction reduction)
+	: modulus(modulus), reduction(reduction)
+{
+	withArithmetic(modulus, reduction, [](const auto &) {}); // Checks the modulus.
+	for (std::int64_t coef : coefs) {
+		this->coefs.push_back(residue<std::uint64_t>(coef, modulus));
+	}
+}
+
+void Systolic::Backend::ModularEvaluator::evaluate(const std::int64_t *xs, std::uint64_t *outputs, const std::size_t count) const
+{
+	withArithmetic(modulus, reduction, [&](const auto &arithmetic) {
+			using Word = std::decay_t<decltype(arithmetic.getModulus())>;
+
+			const std::vector<Word> c(coefs.begin(), coefs.end());
+			const std::size_t blocks = (count + blockSize - 1) / blockSize;
+
+			Systolic::Backend::Scheduler::getInstance().parallelFor(blocks, [&](const std::size_t b){
+					Word x[blockSize];
+					Word sum[blockSize];
+					const std::size_t start = b * blockSize;
+					const std::size_t length = std::min(blockSize, count - start);
+
+					for (std::size_t i = 0; i != length; i++) {
+						x[i] = arithmetic.prepare(residue<Word>(xs[start + i], arithmetic.getModulus()));
+						sum[i] = 0;
+					}
+					for (Word coef : c) {
+						for (std::size_t i = 0; i != length; i++) {
+							sum[i] = arithmetic.add(arithmetic.multiply(sum[i], x[i]), coef);
+						}
+					}
+					std::copy(sum, sum + length, outputs + start);
+				});
+		});
+}
+
+std::vector<std::uint64_t> Systolic::Backend::ModularEvaluator::evaluate(const std::vector<std::int64_t> &xs) const
+{
+	std::vector<std::uint64_t> res(xs.size());
+
+	evaluate(xs.data(), res.data(), xs.size());
+	return res;
+}
+
+std::uint64_t Systolic::Backend::ModularEvaluator::getModulus() const
+{
+	return modulus;
+}
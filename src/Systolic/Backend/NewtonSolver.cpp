@@ -0,0 +1,99 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file NewtonSolver.cpp
+ * Implementation of NewtonSolver.
+ */
+
+#include "Systolic/Backend/NewtonSolver.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+#include "Systolic/Backend/PolynomialEvaluator.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+Systolic::Backend::NewtonSolver::NewtonSolver(const std::vector<int> &coefs)
+	: coefs(coefs)
+{
+	if (coefs.empty()) {
+		throw std::invalid_argument("Cannot declare a Newton solver without coefficients.");
+	}
+}
+
+std::vector<Systolic::Backend::NewtonRoot>
+Systolic::Backend::NewtonSolver::solve(const std::vector<int> &starts, const std::size_t maxIterations) const
+{
+	std::vector<NewtonRoot> roots(starts.size());
+	const std::size_t blocks = (starts.size() + blockSize - 1) / blockSize;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(blocks, [&](const std::size_t b){
+			std::vector<std::size_t> active; // Indexes of the points still moving.
+			std::vector<int> xs;
+			std::vector<int> previous;
+			std::vector<int> derivatives;
+			const std::size_t end = std::min(starts.size(), (b + 1) * blockSize);
+
+			for (std::size_t i = b * blockSize; i != end; i++) {
+				roots[i] = {starts[i], 0, false};
+				active.push_back(i);
+				xs.push_back(starts[i]);
+			}
+			previous = xs;
+			for (std::size_t iteration = 1; !active.empty() && iteration <= maxIterations; iteration++) {
+				const std::vector<int> values = PolynomialEvaluator::evaluateWithDerivative(coefs, xs, derivatives);
+				std::size_t kept = 0;
+
+				// Points that stop are dropped, the other ones being compacted in place.
+				for (std::size_t k = 0; k != active.size(); k++) {
+					NewtonRoot &root = roots[active[k]];
+					const long long value = values[k];
+					const long long derivative = derivatives[k];
+
+					root.iterations = iteration;
+					if (value == 0 || derivative == 0) {
+						root.converged = (value == 0);
+						continue;
+					}
+
+					long long step = value / derivative;
+
+					if (step == 0) {
+						step = ((value > 0) == (derivative > 0) ? 1 : -1);
+					}
+
+					const long long moved = static_cast<long long>(xs[k]) - step;
+
+					if (moved == previous[k] || moved < INT_MIN || moved > INT_MAX) {
+						continue;
+					}
+					root.root = static_cast<int>(moved);
+					active[kept] = active[k];
+					previous[kept] = xs[k];
+					xs[kept] = root.root;
+					kept++;
+				}
+				active.resize(kept);
+				xs.resize(kept);
+				previous.resize(kept);
+			}
+		});
+	return roots;
+}
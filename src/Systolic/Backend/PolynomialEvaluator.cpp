@@ -0,0 +1,486 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file PolynomialEvaluator.cpp
+ * Implementation of PolynomialEvaluator.
+ */
+
+#include "Systolic/Backend/PolynomialEvaluator.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+	/* Polynomial over the integers modulo 2^32, by increasing degree. */
+	using Poly = std::vector<std::uint32_t>;
+
+	/* X evaluated together by the Horner's method, as to vectorize across them. */
+	constexpr std::size_t blockSize = 256;
+	/* X given to a single task of the scheduler. */
+	constexpr std::size_t tileSize = 16 * blockSize;
+
+	/* Size under which products are computed by the schoolbook method, which vectorizes well. */
+	constexpr std::size_t schoolbookSize = 256;
+
+	/*
+	 * Number theoretic transform over the prime P, of primitive root G.
+	 * Values are kept in Montgomery form (x * 2^32 mod P) during the transforms,
+	 * as to replace the divisions of the reductions by multiplications.
+	 */
+	template <std::uint32_t P, std::uint32_t G>
+	struct Ntt {
+		static constexpr std::uint32_t negInv()
+		{
+			std::uint32_t inv = P;
+
+			for (int i = 0; i != 5; i++) { // Newton's iterations, doubling the correct bits each time.
+				inv *= 2 - P * inv;
+			}
+			return 0u - inv;
+		}
+
+		static constexpr std::uint32_t pNegInv = negInv(); /* -P^-1 mod 2^32. */
+		static constexpr std::uint32_t r2 = static_cast<std::uint32_t>((((std::uint64_t(1) << 32) % P)
+										  * ((std::uint64_t(1) << 32) % P)) % P); /* 2^64 mod P. */
+
+		static std::uint32_t reduce(const std::uint64_t t)
+		{
+			std::uint32_t m = static_cast<std::uint32_t>(t) * pNegInv;
+			std::uint32_t u = static_cast<std::uint32_t>((t + std::uint64_t(m) * P) >> 32);
+
+			return (u >= P ? u - P : u);
+		}
+
+		/* Montgomery product, a * b / 2^32 mod P. */
+		static std::uint32_t mul(const std::uint32_t a, const std::uint32_t b)
+		{
+			return reduce(std::uint64_t(a) * b);
+		}
+
+		static std::uint32_t power(std::uint64_t base, std::uint64_t exp)
+		{
+			std::uint64_t res = 1;
+
+			for (base %= P; exp != 0; exp >>= 1) {
+				if (exp & 1) {
+					res = res * base % P;
+				}
+				base = base * base % P;
+			}
+			return static_cast<std::uint32_t>(res);
+		}
+
+		static void transform(std::vector<std::uint32_t> &a, const bool invert)
+		{
+			const std::size_t n = a.size();
+			std::vector<std::uint32_t> roots(n / 2 + 1);
+
+			for (std::size_t i = 1, j = 0; i < n; i++) { // Bit-reversal permutation.
+				std::size_t bit = n >> 1;
+
+				for (; j & bit; bit >>= 1) {
+					j ^= bit;
+				}
+				j ^= bit;
+				if (i < j) {
+					std::swap(a[i], a[j]);
+				}
+			}
+			for (std::size_t len = 2; len <= n; len <<= 1) {
+				std::uint32_t root = power(G, (P - 1) / len);
+
+				if (invert) {
+					root = power(root, P - 2);
+				}
+				root = mul(root, r2);
+				roots[0] = mul(1, r2);
+				for (std::size_t k = 1; k < len / 2; k++) {
+					roots[k] = mul(roots[k - 1], root);
+				}
+				for (std::size_t i = 0; i < n; i += len) {
+					std::uint32_t *lo = a.data() + i;
+					std::uint32_t *hi = lo + len / 2;
+
+					for (std::size_t k = 0; k < len / 2; k++) {
+						std::uint32_t u = lo[k];
+						std::uint32_t v = mul(hi[k], roots[k]);
+
+						lo[k] = (u + v >= P ? u + v - P : u + v);
+						hi[k] = (u >= v ? u - v : u + P - v);
+					}
+				}
+			}
+		}
+
+		/* Cyclic convolution of length size of a and b, modulo P. */
+		static std::vector<std::uint32_t> convolve(const Poly &a, const Poly &b, const std::size_t size)
+		{
+			std::vector<std::uint32_t> fa(size, 0);
+			std::vector<std::uint32_t> fb(size, 0);
+			const std::uint32_t scale = power(size, P - 2); // Plain 1/size, also leaving the Montgomery form.
+
+			for (std::size_t i = 0; i != a.size(); i++) {
+				fa[i] = mul(a[i] % P, r2);
+			}
+			for (std::size_t i = 0; i != b.size(); i++) {
+				fb[i] = mul(b[i] % P, r2);
+			}
+			transform(fa, false);
+			transform(fb, false);
+			for (std::size_t i = 0; i != size; i++) {
+				fa[i] = mul(fa[i], fb[i]);
+			}
+			transform(fa, true);
+			for (std::uint32_t &value : fa) {
+				value = mul(value, scale);
+			}
+			return fa;
+		}
+	};
+
+	constexpr std::uint32_t p1 = 998244353;
+	constexpr std::uint32_t p2 = 167772161;
+	constexpr std::uint32_t p3 = 469762049;
+	using Ntt1 = Ntt<p1, 3>;
+	using Ntt2 = Ntt<p2, 3>;
+	using Ntt3 = Ntt<p3, 3>;
+
+	/* Longest convolution whose coefficients, below size * 2^64, stay below p1 * p2 * p3. */
+	constexpr std::size_t maxConvolutionSize = std::size_t(1) << 22;
+
+	static_assert(static_cast<long double>(maxConvolutionSize) * 18446744073709551616.0L
+		      < static_cast<long double>(p1) * p2 * p3, "Convolutions would wrap around the product of the primes.");
+
+	/*
+	 * Cyclic convolution of a and b modulo 2^32, of length size.
+	 * Coefficients of the exact integer product are below size * 2^64, which is
+	 * reconstructed from its residues modulo three primes (their product being
+	 * about 2^86) with the Garner's algorithm, then truncated to 32 bits.
+	 * The reconstruction is only exact up to maxConvolutionSize.
+	 */
+	Poly convolve(const Poly &a, const Poly &b, const std::size_t size)
+	{
+		if (size > maxConvolutionSize) {
+			throw std::logic_error("Convolutions over " + std::to_string(maxConvolutionSize)
+					       + " coefficients cannot be reconstructed from three primes.");
+		}
+		std::vector<std::uint32_t> r1 = Ntt1::convolve(a, b, size);
+		std::vector<std::uint32_t> r2 = Ntt2::convolve(a, b, size);
+		std::vector<std::uint32_t> r3 = Ntt3::convolve(a, b, size);
+		const std::uint64_t p1InvP2 = Ntt2::power(p1, p2 - 2);
+		const std::uint64_t p1p2InvP3 = Ntt3::power(std::uint64_t(p1) * p2 % p3, p3 - 2);
+		const std::uint32_t p1p2 = p1 * p2; // Modulo 2^32.
+		Poly res(size);
+
+		for (std::size_t i = 0; i != size; i++) {
+			std::uint64_t v1 = r1[i];
+			std::uint64_t v2 = (r2[i] + p2 - v1 % p2) % p2 * p1InvP2 % p2;
+			std::uint64_t t = (r3[i] + p3 - v1 % p3) % p3;
+
+			t = (t + p3 - v2 * (p1 % p3) % p3) % p3;
+			std::uint64_t v3 = t * p1p2InvP3 % p3;
+
+			res[i] = static_cast<std::uint32_t>(v1) + static_cast<std::uint32_t>(v2) * p1
+				+ static_cast<std::uint32_t>(v3) * p1p2;
+		}
+		return res;
+	}
+
+	std::size_t powerOfTwo(const std::size_t min)
+	{
+		std::size_t size = 1;
+
+		while (size < min) {
+			size <<= 1;
+		}
+		return size;
+	}
+
+	/* Product of two polynomials modulo 2^32. */
+	Poly multiply(const Poly &a, const Poly &b)
+	{
+		if (a.empty() || b.empty()) {
+			return Poly();
+		}
+		if (std::min(a.size(), b.size()) <= schoolbookSize) {
+			Poly res(a.size() + b.size() - 1, 0);
+
+			for (std::size_t i = 0; i != a.size(); i++) {
+				for (std::size_t j = 0; j != b.size(); j++) {
+					res[i + j] += a[i] * b[j];
+				}
+			}
+			return res;
+		}
+
+		Poly res = convolve(a, b, powerOfTwo(a.size() + b.size() - 1));
+
+		res.resize(a.size() + b.size() - 1);
+		return res;
+	}
+
+	/*
+	 * Transposed product of a by b, modulo 2^32.
+	 * Computes res[k] = sum of a[k + j] * b[j], for k from 0 to |a| - |b|.
+	 * Those are the middle coefficients of a * reverse(b), which are left
+	 * untouched by the wraparound of a cyclic convolution of length |a|.
+	 */
+	Poly middleProduct(const Poly &a, const Poly &b)
+	{
+		Poly res(a.size() - b.size() + 1, 0);
+
+		if (std::min(b.size(), res.size()) <= schoolbookSize) {
+			for (std::size_t k = 0; k != res.size(); k++) {
+				for (std::size_t j = 0; j != b.size(); j++) {
+					res[k] += a[k + j] * b[j];
+				}
+			}
+			return res;
+		}
+
+		Poly product = convolve(a, Poly(b.rbegin(), b.rend()), powerOfTwo(a.size()));
+
+		std::copy(product.begin() + (b.size() - 1), product.begin() + a.size(), res.begin());
+		return res;
+	}
+
+	/* Inverse of f modulo x^k by Newton's iterations, f(0) being 1. */
+	Poly inverse(const Poly &f, const std::size_t k)
+	{
+		Poly g(1, 1);
+
+		for (std::size_t len = 1; len < k;) {
+			len = std::min(len * 2, k);
+			Poly t = multiply(Poly(f.begin(), f.begin() + std::min(len, f.size())), g);
+
+			t.resize(len, 0);
+			for (std::uint32_t &value : t) {
+				value = 0u - value;
+			}
+			t[0] += 2;
+			g = multiply(g, t);
+			g.resize(len, 0);
+		}
+		g.resize(k, 0);
+		return g;
+	}
+
+	/*
+	 * Subproduct tree over a set of points, evaluated by transposition.
+	 * Level 0 holds (1 - x X) for every point x, each upper level the products
+	 * of pairs of nodes of the level below.
+	 * For a polynomial P of N coefficients, each node v holds during the
+	 * evaluation the sequence A(v)[k] = sum of P[j + k] * [X^j](1 / Q(v)),
+	 * which at a leaf of point x is P(x). The sequence of a child is the
+	 * transposed product of the one of its parent by the subproduct of its
+	 * sibling, that is one middle product per node instead of the inversions
+	 * and divisions of a remainder tree.
+	 */
+	class SubproductTree {
+	public:
+		SubproductTree(const std::uint32_t *points, const std::size_t count)
+			: count(count)
+		{
+			levels.emplace_back();
+			for (std::size_t i = 0; i != count; i++) {
+				levels.back().push_back(Poly{1, 0u - points[i]});
+			}
+			while (levels.back().size() > 1) {
+				const std::vector<Poly> &below = levels.back();
+				std::vector<Poly> level;
+
+				for (std::size_t i = 0; i < below.size(); i += 2) {
+					level.push_back(i + 1 < below.size() ? multiply(below[i], below[i + 1]) : below[i]);
+				}
+				levels.push_back(std::move(level));
+			}
+		}
+
+		void evaluate(const Poly &p, std::uint32_t *results) const
+		{
+			Poly padded(p);
+
+			padded.resize(p.size() + count - 1, 0);
+			descend(levels.size() - 1, 0, middleProduct(padded, inverse(levels.back().front(), p.size())), results);
+		}
+
+	private:
+		const std::size_t count;
+		std::vector<std::vector<Poly>> levels;
+
+		void descend(const std::size_t level, const std::size_t index, const Poly &a, std::uint32_t *results) const
+		{
+			if (level == 0) {
+				results[index] = a[0];
+				return;
+			}
+
+			const std::vector<Poly> &below = levels[level - 1];
+
+			if (2 * index + 1 == below.size()) { // Node carried over from the level below.
+				descend(level - 1, 2 * index, a, results);
+				return;
+			}
+			descend(level - 1, 2 * index, middleProduct(a, below[2 * index + 1]), results);
+			descend(level - 1, 2 * index + 1, middleProduct(a, below[2 * index]), results);
+		}
+	};
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluate(const std::vector<int> &coefs,
+								   const std::vector<int> &xs)
+{
+	return evaluate(coefs, xs.data(), xs.size());
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluate(const std::vector<int> &coefs, const int *xs,
+								   const std::size_t count)
+{
+	if (!coefs.empty() && usesMultipoint(coefs.size() - 1, count)) {
+		return evaluateMultipoint(coefs, xs, count);
+	}
+	return evaluateHorner(coefs, xs, count);
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateHorner(const std::vector<int> &coefs,
+									 const std::vector<int> &xs)
+{
+	return evaluateHorner(coefs, xs.data(), xs.size());
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateHorner(const std::vector<int> &coefs, const int *xs,
+									 const std::size_t total)
+{
+	std::vector<int> res(total);
+
+	// Tiles of X are spread over the scheduler, each evaluated by blocks.
+	Systolic::Backend::Scheduler::getInstance().parallelFor((total + tileSize - 1) / tileSize, [&](const std::size_t tile){
+			const std::size_t end = std::min(total, (tile + 1) * tileSize);
+			std::uint32_t x[blockSize];
+			std::uint32_t sum[blockSize];
+
+			for (std::size_t start = tile * tileSize; start < end; start += blockSize) {
+				const std::size_t count = std::min(blockSize, end - start);
+
+				for (std::size_t i = 0; i != count; i++) {
+					x[i] = static_cast<std::uint32_t>(xs[start + i]);
+					sum[i] = 0;
+				}
+				for (int coef : coefs) { // Unsigned arithmetic, as to wrap around as PolynomialCell does.
+					const std::uint32_t c = static_cast<std::uint32_t>(coef);
+
+					for (std::size_t i = 0; i != count; i++) {
+						sum[i] = sum[i] * x[i] + c;
+					}
+				}
+				for (std::size_t i = 0; i != count; i++) {
+					res[start + i] = static_cast<int>(sum[i]);
+				}
+			}
+		});
+	return res;
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateWithDerivative(const std::vector<int> &coefs,
+										 const std::vector<int> &xs,
+										 std::vector<int> &derivatives)
+{
+	return evaluateWithDerivative(coefs, xs.data(), xs.size(), derivatives);
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateWithDerivative(const std::vector<int> &coefs, const int *xs,
+										 const std::size_t total,
+										 std::vector<int> &derivatives)
+{
+	std::vector<int> res(total);
+
+	derivatives.resize(total);
+	// Tiles of X are spread over the scheduler, the value and the derivative of each block being computed in a single pass.
+	Systolic::Backend::Scheduler::getInstance().parallelFor((total + tileSize - 1) / tileSize, [&](const std::size_t tile){
+			const std::size_t end = std::min(total, (tile + 1) * tileSize);
+			std::uint32_t x[blockSize];
+			std::uint32_t sum[blockSize];
+			std::uint32_t derivative[blockSize];
+
+			for (std::size_t start = tile * tileSize; start < end; start += blockSize) {
+				const std::size_t count = std::min(blockSize, end - start);
+
+				for (std::size_t i = 0; i != count; i++) {
+					x[i] = static_cast<std::uint32_t>(xs[start + i]);
+					sum[i] = 0;
+					derivative[i] = 0;
+				}
+				for (int coef : coefs) { // (S + D e) * X + C, with e^2 = 0.
+					const std::uint32_t c = static_cast<std::uint32_t>(coef);
+
+					for (std::size_t i = 0; i != count; i++) {
+						derivative[i] = derivative[i] * x[i] + sum[i];
+						sum[i] = sum[i] * x[i] + c;
+					}
+				}
+				for (std::size_t i = 0; i != count; i++) {
+					res[start + i] = static_cast<int>(sum[i]);
+					derivatives[start + i] = static_cast<int>(derivative[i]);
+				}
+			}
+		});
+	return res;
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateMultipoint(const std::vector<int> &coefs,
+									     const std::vector<int> &xs)
+{
+	return evaluateMultipoint(coefs, xs.data(), xs.size());
+}
+
+std::vector<int> Systolic::Backend::PolynomialEvaluator::evaluateMultipoint(const std::vector<int> &coefs, const int *xs,
+									     const std::size_t count)
+{
+	if (coefs.empty()) {
+		return std::vector<int>(count, 0);
+	}
+	if (coefs.size() - 1 > multipointMaxDegree) { // Convolutions would be longer than the primes allow.
+		return evaluateHorner(coefs, xs, count);
+	}
+
+	Poly p(coefs.rbegin(), coefs.rend());
+	std::vector<std::uint32_t> points(xs, xs + count);
+	std::vector<std::uint32_t> results(count);
+	/* Points are split in chunks about the size of the degree, each with its own tree. */
+	const std::size_t chunkSize = std::max<std::size_t>(p.size(), schoolbookSize);
+	const std::size_t chunks = (points.size() + chunkSize - 1) / chunkSize;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(chunks, [&](const std::size_t c){
+			const std::size_t start = c * chunkSize;
+			SubproductTree tree(points.data() + start, std::min(chunkSize, points.size() - start));
+
+			tree.evaluate(p, results.data() + start);
+		});
+	return std::vector<int>(results.begin(), results.end());
+}
+
+bool Systolic::Backend::PolynomialEvaluator::usesMultipoint(const std::size_t degree, const std::size_t points)
+{
+	return degree >= multipointMinDegree && degree <= multipointMaxDegree && points >= multipointMinPoints;
+}
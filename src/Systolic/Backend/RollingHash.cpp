@@ -0,0 +1,214 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file RollingHash.cpp
+ * Implementation of RollingHash.
+ */
+
+#include "Systolic/Backend/RollingHash.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+#include "Util/MappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+	/* value^exponent mod M, by squaring. */
+	template <typename Arithmetic, typename Word>
+	Word power(const Arithmetic &arithmetic, Word value, std::uint64_t exponent)
+	{
+		Word res = 1 % arithmetic.getModulus();
+
+		for (; exponent != 0; exponent >>= 1) {
+			if (exponent & 1) {
+				res = arithmetic.multiply(res, arithmetic.prepare(value));
+			}
+			value = arithmetic.multiply(value, arithmetic.prepare(value));
+		}
+		return res;
+	}
+}
+
+Systolic::Backend::RollingHash::RollingHash(const std::uint64_t base, const std::uint64_t modulus, const std::size_t window,
+					     const Reduction reduction)
+	: base(base), modulus(modulus), window(window), reduction(reduction)
+{
+	if (window == 0) {
+		throw std::invalid_argument("Cannot declare a rolling hash over empty windows.");
+	}
+	withArithmetic(modulus, reduction, [](const auto &) {}); // Checks the modulus.
+}
+
+void Systolic::Backend::RollingHash::scan(const unsigned char *data, const std::size_t size, std::uint64_t *hashes) const
+{
+	const std::size_t count = getHashCount(size);
+
+	if (count == 0) {
+		return;
+	}
+	withArithmetic(modulus, reduction, [&](const auto &arithmetic) {
+			using Word = std::decay_t<decltype(arithmetic.getModulus())>;
+
+			const Word m = arithmetic.getModulus();
+			const Word b = arithmetic.prepare(static_cast<Word>(base % m));
+			const Word high = power(arithmetic, static_cast<Word>(base % m), window); // B^W.
+			std::array<Word, 256> entering; // Residue of each byte.
+			std::array<Word, 256> leaving; // Opposite of each byte times B^W.
+
+			for (std::size_t v = 0; v != 256; v++) {
+				entering[v] = static_cast<Word>(v % m);
+				leaving[v] = static_cast<Word>((m - arithmetic.multiply(entering[v], arithmetic.prepare(high))) % m);
+			}
+
+			/* Chunks are long enough for the first hash of each lane, computed from scratch, to stay marginal. */
+			const std::size_t chunkSize = std::max<std::size_t>(std::size_t(1) << 16, lanes * window * 16);
+			const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+			Systolic::Backend::Scheduler::getInstance().parallelFor(chunks, [&, b](const std::size_t c) {
+					const auto local = arithmetic; // Kept in registers, as bytes and hashes may alias any member.
+					const std::size_t start = c * chunkSize;
+					const std::size_t length = std::min(chunkSize, count - start);
+					const std::size_t laneSize = (length + lanes - 1) / lanes;
+					const std::size_t used = (length + laneSize - 1) / laneSize; // Only the last lane may be shorter.
+					const std::size_t lastSize = length - (used - 1) * laneSize;
+					const std::size_t steps = (used == lanes ? lastSize - 1 : 0); // Windows hashed by every lane in lockstep.
+					Word h[lanes];
+
+					for (std::size_t k = 0; k != used; k++) {
+						const unsigned char *first = data + start + k * laneSize;
+						Word value = 0;
+
+						for (std::size_t j = 0; j != window; j++) {
+							value = local.add(local.multiply(value, b), entering[first[j]]);
+						}
+						h[k] = value;
+					}
+					/* Leaving and entering bytes are summed apart, as to keep a single multiplication per roll on the hash dependency. */
+					for (std::size_t j = 0; j != steps; j++) {
+						for (std::size_t k = 0; k != lanes; k++) {
+							const std::size_t i = start + k * laneSize + j;
+
+							hashes[i] = h[k];
+							h[k] = local.add(local.multiply(h[k], b), local.add(leaving[data[i]], entering[data[i + window]]));
+						}
+					}
+					for (std::size_t k = 0; k != used; k++) {
+						const std::size_t size = (k + 1 == used ? lastSize : laneSize);
+						Word value = h[k];
+
+						for (std::size_t j = steps; j != size; j++) {
+							const std::size_t i = start + k * laneSize + j;
+
+							hashes[i] = value;
+							if (j + 1 != size) {
+								value = local.add(local.multiply(value, b), local.add(leaving[data[i]], entering[data[i + window]]));
+							}
+						}
+					}
+				});
+		});
+}
+
+bool Systolic::Backend::RollingHash::scanFile(const std::string &path, const Consumer &consumer) const
+{
+	Util::MappedFile file(path);
+
+	if (!file.isOpen()) {
+		std::cerr << "Err: Cannot map file " << path << "." << std::endl;
+		return false;
+	}
+
+	const std::size_t count = getHashCount(file.getSize());
+	std::vector<std::uint64_t> hashes(std::min(count, fileChunk));
+
+	for (std::size_t first = 0; first < count; first += fileChunk) {
+		const std::size_t length = std::min(fileChunk, count - first);
+
+		scan(file.getData() + first, length + window - 1, hashes.data());
+		consumer(first, hashes.data(), length);
+	}
+	return true;
+}
+
+std::uint64_t Systolic::Backend::RollingHash::fingerprint(const unsigned char *data, const std::size_t size) const
+{
+	return withArithmetic(modulus, reduction, [&](const auto &arithmetic) {
+			using Word = std::decay_t<decltype(arithmetic.getModulus())>;
+
+			const Word m = arithmetic.getModulus();
+			const Word b = arithmetic.prepare(static_cast<Word>(base % m));
+			constexpr std::size_t chunkSize = std::size_t(1) << 20;
+			constexpr std::size_t laneSize = chunkSize / lanes;
+			const std::size_t chunks = (size + chunkSize - 1) / chunkSize;
+			const Word laneShift = arithmetic.prepare(power(arithmetic, static_cast<Word>(base % m), laneSize));
+			std::vector<Word> partials(chunks);
+
+			/* Each chunk is hashed as interleaved lanes, each lane being shifted by B^(bytes after it) when combined. */
+			Systolic::Backend::Scheduler::getInstance().parallelFor(chunks, [&, b, laneShift](const std::size_t c) {
+					const auto local = arithmetic;
+					const unsigned char *first = data + c * chunkSize;
+					Word h[lanes] = {};
+					std::array<Word, 256> entering;
+
+					for (std::size_t v = 0; v != 256; v++) {
+						entering[v] = static_cast<Word>(v % m);
+					}
+					if ((c + 1) * chunkSize > size) { // Last, partial, chunk.
+						for (std::size_t i = 0; i != size - c * chunkSize; i++) {
+							h[0] = local.add(local.multiply(h[0], b), entering[first[i]]);
+						}
+						partials[c] = h[0];
+						return;
+					}
+					for (std::size_t j = 0; j != laneSize; j++) {
+						for (std::size_t k = 0; k != lanes; k++) {
+							h[k] = local.add(local.multiply(h[k], b), entering[first[k * laneSize + j]]);
+						}
+					}
+					for (std::size_t k = 1; k != lanes; k++) {
+						h[0] = local.add(local.multiply(h[0], laneShift), h[k]);
+					}
+					partials[c] = h[0];
+				});
+
+			const Word shift = arithmetic.prepare(power(arithmetic, static_cast<Word>(base % m), chunkSize));
+			const Word lastShift = arithmetic.prepare(power(arithmetic, static_cast<Word>(base % m),
+									size - (chunks == 0 ? 0 : (chunks - 1) * chunkSize)));
+			Word res = 0;
+
+			for (std::size_t c = 0; c != chunks; c++) {
+				res = arithmetic.add(arithmetic.multiply(res, (c + 1 == chunks ? lastShift : shift)), partials[c]);
+			}
+			return static_cast<std::uint64_t>(res);
+		});
+}
+
+std::size_t Systolic::Backend::RollingHash::getHashCount(const std::size_t size) const
+{
+	return (size >= window ? size - window + 1 : 0);
+}
+
+std::size_t Systolic::Backend::RollingHash::getWindow() const
+{
+	return window;
+}
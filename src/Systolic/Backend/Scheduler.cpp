@@ -0,0 +1,241 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Scheduler.cpp
+ * Implementation of Scheduler.
+ */
+
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+
+	/* Scheduler and deque of the current thread, when it is a worker. */
+	thread_local const Systolic::Backend::Scheduler *currentScheduler = nullptr;
+	thread_local std::size_t currentIndex = 0;
+}
+
+Systolic::Backend::Scheduler &Systolic::Backend::Scheduler::getInstance()
+{
+	static Scheduler instance;
+
+	return instance;
+}
+
+Systolic::Backend::Scheduler::Scheduler(const std::size_t workers)
+	: stopping(false), pending(0), maxPending(0), submitted(0), executed(0), stolen(0), withdrawn(0), nextQueue(0)
+{
+	const std::size_t count = (workers != 0 ? workers
+				   : std::max<std::size_t>(1, std::thread::hardware_concurrency()) - 1);
+
+	for (std::size_t i = 0; i != std::max<std::size_t>(1, count); i++) {
+		queues.push_back(std::make_unique<Queue>());
+	}
+	for (std::size_t i = 0; i != queues.size(); i++) {
+		threads.emplace_back([this, i]{ work(i); });
+	}
+}
+
+Systolic::Backend::Scheduler::~Scheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+}
+
+void Systolic::Backend::Scheduler::submit(std::function<void()> task)
+{
+	push({std::move(task), nullptr});
+}
+
+void Systolic::Backend::Scheduler::parallelFor(const std::size_t count, const std::function<void(const std::size_t)> &body)
+{
+	/* Shared with the helper tasks, which may only start once the loop is over. */
+	struct Loop {
+		std::atomic<std::size_t> next;
+		std::atomic<std::size_t> done;
+		std::atomic<std::size_t> started; /** Helpers started. */
+		std::size_t count;
+		const std::function<void(const std::size_t)> *body;
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+	if (count <= 1) {
+		if (count == 1) {
+			body(0);
+		}
+		return;
+	}
+
+	std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+	const std::function<void()> drain = [loop]{
+		loop->started++;
+		for (std::size_t i = loop->next++; i < loop->count; i = loop->next++) {
+			try {
+				(*loop->body)(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(loop->errorMutex);
+
+				if (loop->error == nullptr) {
+					loop->error = std::current_exception();
+				}
+			}
+			loop->done++;
+		}
+	};
+
+	loop->next = 0;
+	loop->done = 0;
+	loop->started = 0;
+	loop->count = count;
+	loop->body = &body;
+
+	const std::size_t helpers = std::min(queues.size(), count - 1);
+
+	for (std::size_t h = 0; h != helpers; h++) {
+		push({drain, loop.get()});
+	}
+	drain();
+	while (loop->done.load() != count) {
+		if (!runOne(currentWorker())) {
+			std::this_thread::yield();
+		}
+	}
+	// Counting the caller, which ran drain itself.
+	if (loop->started.load() != helpers + 1) {
+		withdraw(loop.get());
+	}
+	if (loop->error != nullptr) {
+		std::rethrow_exception(loop->error);
+	}
+}
+
+Systolic::Backend::SchedulerStats Systolic::Backend::Scheduler::getStats() const
+{
+	return {queues.size(), submitted.load(), executed.load(), stolen.load(), withdrawn.load(), pending.load(),
+		maxPending.load()};
+}
+
+std::size_t Systolic::Backend::Scheduler::getWorkers() const
+{
+	return queues.size();
+}
+
+/* Privates functions. */
+
+void Systolic::Backend::Scheduler::push(Task task)
+{
+	const std::size_t self = currentWorker();
+	Queue &queue = *queues[self != queues.size() ? self : nextQueue++ % queues.size()];
+	const std::size_t depth = ++pending; // Counted before it can be popped.
+	std::size_t max = maxPending.load();
+
+	while (depth > max && !maxPending.compare_exchange_weak(max, depth)) {
+	}
+	submitted++;
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		queue.tasks.push_back(std::move(task));
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex); // Orders the wake up after a worker found nothing to run.
+	}
+	wake.notify_one();
+}
+
+void Systolic::Backend::Scheduler::withdraw(const void *loop)
+{
+	for (std::unique_ptr<Queue> &queue : queues) {
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		const std::size_t size = queue->tasks.size();
+
+		queue->tasks.erase(std::remove_if(queue->tasks.begin(), queue->tasks.end(),
+						  [loop](const Task &task){ return task.loop == loop; }),
+				   queue->tasks.end());
+		pending -= size - queue->tasks.size();
+		withdrawn += size - queue->tasks.size();
+	}
+}
+
+void Systolic::Backend::Scheduler::work(const std::size_t self)
+{
+	currentScheduler = this;
+	currentIndex = self;
+	for (;;) {
+		if (runOne(self)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+
+		wake.wait(lock, [this]{ return stopping || pending.load() != 0; });
+		if (stopping && pending.load() == 0) {
+			return;
+		}
+	}
+}
+
+bool Systolic::Backend::Scheduler::runOne(const std::size_t self)
+{
+	std::function<void()> task;
+
+	/* Newest task of the own deque first, as its data is likely in the cache. */
+	if (self != queues.size()) {
+		std::lock_guard<std::mutex> lock(queues[self]->mutex);
+
+		if (!queues[self]->tasks.empty()) {
+			task = std::move(queues[self]->tasks.back().run);
+			queues[self]->tasks.pop_back();
+		}
+	}
+	/* Otherwise the oldest task of another deque. */
+	for (std::size_t k = 1; task == nullptr && k <= queues.size(); k++) {
+		Queue &victim = *queues[(self + k) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if (!victim.tasks.empty()) {
+			task = std::move(victim.tasks.front().run);
+			victim.tasks.pop_front();
+			stolen++;
+		}
+	}
+	if (task == nullptr) {
+		return false;
+	}
+	pending--;
+	task();
+	executed++;
+	return true;
+}
+
+std::size_t Systolic::Backend::Scheduler::currentWorker() const
+{
+	return (currentScheduler == this ? currentIndex : queues.size());
+}
@@ -0,0 +1,90 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BandBuilder.cpp
+ * Implementation of BandBuilder.
+ */
+
+#include "Systolic/Container/BandBuilder.hpp"
+
+#include <algorithm>
+
+std::shared_ptr<Systolic::BandBuilder> Systolic::BandBuilder::getNew()
+{
+	return std::make_shared<Systolic::BandBuilder>();
+}
+
+std::shared_ptr<Systolic::BandBuilder>
+Systolic::BandBuilder::fromDense(const std::vector<std::vector<int>> &matrix)
+{
+	if (matrix.empty() || matrix.front().empty()) {
+		throw std::invalid_argument("Cannot declare an empty band matrix.");
+	}
+
+	const int rows = static_cast<int>(matrix.size());
+	const int cols = static_cast<int>(matrix.front().size());
+	int lower = 0;
+	int upper = 0;
+
+	for (int i = 0; i != rows; i++) {
+		if (matrix[i].size() != matrix.front().size()) {
+			throw std::invalid_argument("Every row of the matrix must have the same size.");
+		}
+		for (int j = 0; j != cols; j++) {
+			if (matrix[i][j] != 0) {
+				lower = std::max(lower, i - j);
+				upper = std::max(upper, j - i);
+			}
+		}
+	}
+
+	std::vector<std::vector<int>> diagonals;
+
+	for (int offset = upper; offset >= -lower; offset--) {
+		diagonals.emplace_back(rows, 0);
+		for (int i = std::max(0, -offset); i < rows && i + offset < cols; i++) {
+			diagonals.back()[i] = matrix[i][i + offset];
+		}
+	}
+	return fromDiagonals(diagonals, upper);
+}
+
+std::shared_ptr<Systolic::BandBuilder>
+Systolic::BandBuilder::fromDiagonals(const std::vector<std::vector<int>> &diagonals, const int upper)
+{
+	if (diagonals.empty() || diagonals.front().empty()) {
+		throw std::invalid_argument("Cannot declare an empty band matrix.");
+	}
+	for (const std::vector<int> &diagonal : diagonals) {
+		if (diagonal.size() != diagonals.front().size()) {
+			throw std::invalid_argument("Every diagonal must have one element per row.");
+		}
+	}
+	cells.clear();
+	for (std::size_t k = 0; k != diagonals.size(); k++) {
+		cells.push_back(std::make_unique<Systolic::Cell::BandCell>(diagonals[k], upper - static_cast<int>(k)));
+	}
+	return shared_from_this();
+}
+
+std::vector<std::unique_ptr<Systolic::Cell::BandCell>> Systolic::BandBuilder::build()
+{
+	return std::move(cells);
+}
@@ -0,0 +1,73 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicCellArrayBuilder.cpp
+ * Implementation of BasicCellArrayBuilder.
+ */
+
+#include "Systolic/Container/BasicCellArrayBuilder.hpp"
+
+template <typename T>
+std::shared_ptr<Systolic::BasicCellArrayBuilder<T>> Systolic::BasicCellArrayBuilder<T>::getNew()
+{
+	return std::make_shared<Systolic::BasicCellArrayBuilder<T>>();
+}
+
+template <typename T>
+std::shared_ptr<Systolic::BasicCellArrayBuilder<T>>
+Systolic::BasicCellArrayBuilder<T>::add(std::unique_ptr<Systolic::Cell::BasicICell<T>> cell)
+{
+	if (cell == nullptr) {
+		throw std::invalid_argument("Cannot add a NULL cell.");
+	}
+	cellArray.push_back(std::move(cell));
+	return this->shared_from_this();
+}
+
+template <typename T>
+std::shared_ptr<Systolic::BasicCellArrayBuilder<T>>
+Systolic::BasicCellArrayBuilder<T>::fromPolynomialCoefs(const std::initializer_list<T> coefs)
+{
+	for (const T coef : coefs) {
+		cellArray.push_back(std::make_unique<Systolic::Cell::BasicPolynomialCell<T>>(coef));
+	}
+	return this->shared_from_this();
+}
+
+template <typename T>
+std::shared_ptr<Systolic::BasicCellArrayBuilder<T>>
+Systolic::BasicCellArrayBuilder<T>::fromPolynomialCoefs(std::queue<T> coefs)
+{
+	for (; !coefs.empty(); coefs.pop()) {
+		cellArray.push_back(std::make_unique<Systolic::Cell::BasicPolynomialCell<T>>(coefs.front()));
+	}
+	return this->shared_from_this();
+}
+
+template <typename T>
+std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> Systolic::BasicCellArrayBuilder<T>::build()
+{
+	return std::move(cellArray);
+}
+
+template class Systolic::BasicCellArrayBuilder<std::int32_t>;
+template class Systolic::BasicCellArrayBuilder<std::int64_t>;
+template class Systolic::BasicCellArrayBuilder<double>;
+template class Systolic::BasicCellArrayBuilder<Systolic::Backend::Q16>;
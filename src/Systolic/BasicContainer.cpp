@@ -0,0 +1,309 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicContainer.cpp
+ * Implementation of BasicContainer.
+ */
+
+#include "Systolic/Container/BasicContainer.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+#include "Systolic/Backend/ModularEvaluator.hpp"
+#include "Systolic/Cell/ModularPolynomialCell.hpp"
+
+#include <type_traits>
+
+namespace {
+
+	/* Whether modular cells carry values of type T, 64-bit ones needing 128-bit integers. */
+	template <typename T>
+	constexpr bool hasModularCells = std::is_same_v<T, std::int32_t>
+#ifdef __SIZEOF_INT128__
+		|| std::is_same_v<T, std::int64_t>
+#endif
+		;
+
+	/* Residues of a chain of modular cells sharing their modulus and reduction, or nothing for any other chain. */
+	template <typename T>
+	std::optional<std::vector<T>> evaluateModular(const std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> &cells,
+						      const std::vector<T> &xs)
+	{
+		using ModularCell = Systolic::Cell::BasicModularPolynomialCell<T>;
+		const ModularCell *head = dynamic_cast<const ModularCell *>(cells.front().get());
+		std::vector<std::int64_t> coefs;
+
+		for (const std::unique_ptr<Systolic::Cell::BasicICell<T>> &cell : cells) {
+			const ModularCell *modular = dynamic_cast<const ModularCell *>(cell.get());
+
+			if (modular == nullptr || modular->getModulus() != head->getModulus() || modular->getReduction() != head->getReduction()) {
+				return std::nullopt;
+			}
+			coefs.push_back(modular->getCoef());
+		}
+
+		const Systolic::Backend::ModularEvaluator evaluator(coefs, static_cast<std::uint64_t>(head->getModulus()), head->getReduction());
+		const std::vector<std::uint64_t> residues = evaluator.evaluate(std::vector<std::int64_t>(xs.begin(), xs.end()));
+
+		return std::vector<T>(residues.begin(), residues.end()); // Residues are below the modulus, itself a T.
+	}
+}
+
+template <typename T>
+Systolic::BasicContainer<T>::BasicContainer(const std::queue<T> entries)
+	: inputs(entries)
+{
+}
+
+template <typename T>
+Systolic::BasicContainer<T>::BasicContainer(const std::initializer_list<T> entries)
+{
+	for (const T entry : entries) {
+		inputs.push(entry);
+	}
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::setCells(std::vector<std::unique_ptr<Systolic::Cell::BasicICell<T>>> cells)
+{
+	this->cells = std::move(cells);
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::setCells(std::shared_ptr<Systolic::BasicCellArrayBuilder<T>> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setCells(builder->build());
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::step()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Warn: Cannot compute container step: No cells available." << std::endl;
+		return;
+	}
+
+	// Feeds the first cell with a value from the inputs queue.
+	if (!inputs.empty()) {
+		cells.at(0)->feed(std::make_tuple(std::nullopt, inputs.front()));
+		inputs.pop();
+	} else {
+		cells.at(0)->feed(std::make_tuple(std::nullopt, std::nullopt)); // Feeds empty value.
+	}
+
+	// Feed all other cells with the partials (results) of the previous cell.
+	for (std::size_t i = 1; i < cells.size(); i++) {
+		cells.at(i)->feed(cells.at(i - 1)->getPartial());
+	}
+
+	// Compute the current value of each cells, the cells being spread over the scheduler.
+	std::vector<std::tuple<std::optional<T>, std::optional<T>>> partials(cells.size());
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(cells.size(), [this, &partials](const std::size_t i){
+			partials[i] = cells.at(i)->compute();
+		});
+
+	// Add the last cell partial (final result) to the output queue if available.
+	std::optional<T> lastCellOutput = std::get<0>(partials.back());
+
+	if (lastCellOutput.has_value()) {
+		outputs.push(lastCellOutput.value());
+	}
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::compute()
+{
+	std::size_t ioSize = inputs.size();
+
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (ioSize == 0) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	ioSize += outputs.size();
+	do {
+		logs.push_back(makeLogEntry());
+		step();
+	} while (outputs.size() != ioSize);
+	logs.push_back(makeLogEntry());
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::computeBatch()
+{
+	std::vector<T> xs;
+	std::vector<T> coefs;
+
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (inputs.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	for (; !inputs.empty(); inputs.pop()) {
+		xs.push_back(inputs.front());
+	}
+	for (const std::unique_ptr<Systolic::Cell::BasicICell<T>> &cell : cells) {
+		const Systolic::Cell::BasicPolynomialCell<T> *polynomial =
+			dynamic_cast<const Systolic::Cell::BasicPolynomialCell<T> *>(cell.get());
+
+		if (polynomial == nullptr) {
+			coefs.clear();
+			break;
+		}
+		coefs.push_back(polynomial->getCoef());
+	}
+
+	// Chains of polynomial cells are evaluated by blocks, any other one input by input.
+	if (!coefs.empty()) {
+		for (const T output : Systolic::Backend::BasicPolynomialEvaluator<T>(coefs).evaluate(xs)) {
+			outputs.push(output);
+		}
+		return;
+	}
+	if constexpr (hasModularCells<T>) { // As are chains of modular cells, by the ModularEvaluator.
+		if (const std::optional<std::vector<T>> residues = evaluateModular(cells, xs)) {
+			for (const T output : residues.value()) {
+				outputs.push(output);
+			}
+			return;
+		}
+	}
+	for (const T x : xs) {
+		std::tuple<std::optional<T>, std::optional<T>> partial(std::nullopt, x);
+
+		for (std::unique_ptr<Systolic::Cell::BasicICell<T>> &cell : cells) {
+			cell->feed(partial);
+			partial = cell->compute();
+		}
+		if (std::get<0>(partial).has_value()) {
+			outputs.push(std::get<0>(partial).value());
+		}
+	}
+}
+
+template <typename T>
+void Systolic::BasicContainer<T>::dumpOutputs() const
+{
+	std::queue<T> copy = outputs;
+
+	while (!copy.empty()) {
+		std::cout << Systolic::Backend::ValueTraits<T>::toString(copy.front()) << (copy.size() > 1 ? "," : "");
+		copy.pop();
+	}
+	std::cout << std::endl;
+}
+
+template <typename T>
+std::queue<T> Systolic::BasicContainer<T>::getOutputs() const
+{
+	return outputs;
+}
+
+template <typename T>
+std::string Systolic::BasicContainer<T>::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+template <typename T>
+std::string Systolic::BasicContainer<T>::getLog() const
+{
+	std::stringstream ss;
+
+	for (const std::string &entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+template <typename T>
+std::string Systolic::BasicContainer<T>::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying remaning values waiting in the input queue. */
+	ss << "inputs: ";
+	for (std::queue<T> iCopy = inputs; iCopy.size() > 0; iCopy.pop()) {
+		ss << Systolic::Backend::ValueTraits<T>::toString(iCopy.front()) << (iCopy.size() != 1 ? ", " : "");
+	}
+	ss << std::endl << std::endl;
+
+	/* Displaying the inputs of the cells on the left side and its partials on the right. */
+	for (std::size_t i = 0; i != cells.size(); i++) {
+		/* First line (sums). */
+		ss << std::setw(8) << optionalToString(std::get<0>(cells.at(i)->getInputs()))
+		   << " -- |" << std::setw(19) << std::setfill('-') << "| -- " << std::setfill(' ')
+		   << optionalToString(std::get<0>(cells.at(i)->getPartial()))
+		   << std::endl
+		/* Middle line (cell description) */
+		   << std::setw(14) << "| "
+		   << std::setw(12) << std::left << cells.at(i)->getCellDescription() << std::right
+		   << " | "
+		   << std::endl
+		/* Bottom line (inputs). */
+		   << std::setw(8) << optionalToString(std::get<1>(cells.at(i)->getInputs()))
+		   << " -- |" << std::setw(19) << std::setfill('-') << "| -- " << std::setfill(' ')
+		   << optionalToString(std::get<1>(cells.at(i)->getPartial()))
+		   << std::endl << std::endl;
+	}
+	ss << "outputs: ";
+
+	/* Displaying the values stored in the outputs queue. */
+	for (std::queue<T> oCopy = outputs; oCopy.size() > 0; oCopy.pop()) {
+		ss << Systolic::Backend::ValueTraits<T>::toString(oCopy.front()) << (oCopy.size() != 1 ? ", " : "");
+	}
+	ss << std::endl;
+
+	return ss.str();
+}
+
+template <typename T>
+std::string Systolic::BasicContainer<T>::optionalToString(std::optional<T> value) const
+{
+	if (value.has_value()) {
+		return Systolic::Backend::ValueTraits<T>::toString(value.value());
+	} else {
+		return "{}";
+	}
+}
+
+template class Systolic::BasicContainer<std::int32_t>;
+template class Systolic::BasicContainer<std::int64_t>;
+template class Systolic::BasicContainer<double>;
+template class Systolic::BasicContainer<Systolic::Backend::Q16>;
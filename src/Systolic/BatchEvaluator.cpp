@@ -0,0 +1,384 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BatchEvaluator.cpp
+ * Implementation of BatchEvaluator.
+ */
+
+#include "Systolic/Container/BatchEvaluator.hpp"
+
+#include "Systolic/Cell/Types.hpp"
+#include "Systolic/Cell/DualPolynomialCell.hpp"
+#include "Systolic/Cell/ModularPolynomialCell.hpp"
+#include "Systolic/Cell/ContainerCell.hpp"
+#include "Systolic/Backend/PolynomialEvaluator.hpp"
+#include "Systolic/Backend/ModularEvaluator.hpp"
+#include "Systolic/Backend/FirFilter.hpp"
+
+#include <algorithm>
+
+namespace {
+
+	/* Open-addressing set of distinct values, numbered in order of insertion. */
+	class DistinctValues {
+	public:
+		DistinctValues()
+			: slots(64, -1)
+		{
+		}
+
+		/* Index of x among the distinct values, x being added if new. */
+		std::size_t indexOf(const int x)
+		{
+			if (2 * (values.size() + 1) > slots.size()) {
+				grow();
+			}
+
+			std::size_t i = slot(x);
+
+			if (slots[i] == -1) {
+				slots[i] = static_cast<long>(values.size());
+				values.push_back(x);
+			}
+			return static_cast<std::size_t>(slots[i]);
+		}
+
+		const std::vector<int> &getValues() const
+		{
+			return values;
+		}
+
+	private:
+		std::vector<long> slots; /** Index of the value of each slot, -1 if free. */
+		std::vector<int> values;
+
+		/* Slot holding x, or the free slot where it belongs. */
+		std::size_t slot(const int x) const
+		{
+			std::size_t i = (static_cast<std::uint32_t>(x) * 0x9e3779b1u) & (slots.size() - 1);
+
+			while (slots[i] != -1 && values[slots[i]] != x) {
+				i = (i + 1) & (slots.size() - 1);
+			}
+			return i;
+		}
+
+		void grow()
+		{
+			slots.assign(slots.size() * 2, -1);
+			for (std::size_t k = 0; k != values.size(); k++) {
+				slots[slot(values[k])] = static_cast<long>(k);
+			}
+		}
+	};
+}
+
+Systolic::BatchEvaluator::BatchEvaluator(std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells, Util::RingBuffer<int> &auxiliaryOutputs)
+	: cells(cells), auxiliaryOutputs(auxiliaryOutputs), backend(Systolic::BatchBackend::Cells), evaluated(0)
+{
+}
+
+std::vector<int> Systolic::BatchEvaluator::evaluate(const Util::RingView<int> &xs, Systolic::ResultCache *cache, const std::uint64_t pipelineId)
+{
+	const bool stateless = std::all_of(cells.begin(), cells.end(),
+					   [](const std::unique_ptr<Systolic::Cell::ICell> &cell) { return cell->isStateless(); });
+	const bool auxiliary = std::any_of(cells.begin(), cells.end(),
+					   [](const std::unique_ptr<Systolic::Cell::ICell> &cell) { return cell->hasAuxiliary(); });
+
+	// Only the distinct values missing from the cache go through the cells of stateless chains.
+	if (cache != nullptr && stateless && !auxiliary) {
+		return evaluateMemoized(xs, *cache, pipelineId);
+	}
+	evaluated += xs.size();
+	return evaluateBatch(xs);
+}
+
+Systolic::BatchBackend Systolic::BatchEvaluator::getBackend() const
+{
+	return backend;
+}
+
+std::size_t Systolic::BatchEvaluator::getEvaluated() const
+{
+	return evaluated;
+}
+
+const char *Systolic::BatchEvaluator::getBackendName(const Systolic::BatchBackend backend)
+{
+	switch (backend) {
+	case Systolic::BatchBackend::Polynomial:
+		return "polynomial";
+	case Systolic::BatchBackend::Dual:
+		return "dual";
+	case Systolic::BatchBackend::Modular:
+		return "modular";
+	case Systolic::BatchBackend::Fir:
+		return "fir";
+	case Systolic::BatchBackend::Nested:
+		return "nested";
+	default:
+		return "cells";
+	}
+}
+
+/* Privates functions. */
+
+std::vector<int> Systolic::BatchEvaluator::evaluateBatch(const Util::RingView<int> &xs)
+{
+	std::vector<int> coefs;
+	std::vector<int> results;
+
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		const Systolic::Cell::PolynomialCell *polynomial = dynamic_cast<const Systolic::Cell::PolynomialCell *>(cell.get());
+
+		if (polynomial == nullptr) {
+			coefs.clear();
+			break;
+		}
+		coefs.push_back(polynomial->getCoef());
+	}
+
+	// Chains of polynomial cells have a dedicated backend.
+	if (!coefs.empty()) {
+		backend = Systolic::BatchBackend::Polynomial;
+		if (xs.getSecondSize() == 0) { // Contiguous inputs, borrowed ones included, are evaluated in place.
+			return Systolic::Backend::PolynomialEvaluator::evaluate(coefs, xs.getFirstSegment(), xs.size());
+		}
+
+		const std::vector<int> contiguous = xs.toVector();
+
+		return Systolic::Backend::PolynomialEvaluator::evaluate(coefs, contiguous.data(), contiguous.size());
+	}
+
+	// And chains of dual polynomial cells, whose derivatives are auxiliary outputs.
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		const Systolic::Cell::DualPolynomialCell *dual = dynamic_cast<const Systolic::Cell::DualPolynomialCell *>(cell.get());
+
+		if (dual == nullptr) {
+			coefs.clear();
+			break;
+		}
+		coefs.push_back(dual->getCoef());
+	}
+	if (!coefs.empty()) {
+		std::vector<int> derivatives;
+
+		if (xs.getSecondSize() == 0) { // Contiguous inputs are evaluated in place, as for polynomial chains.
+			results = Systolic::Backend::PolynomialEvaluator::evaluateWithDerivative(coefs, xs.getFirstSegment(), xs.size(),
+												 derivatives);
+		} else {
+			results = Systolic::Backend::PolynomialEvaluator::evaluateWithDerivative(coefs, xs.toVector(), derivatives);
+		}
+		auxiliaryOutputs.reserve(auxiliaryOutputs.size() + derivatives.size());
+		for (int derivative : derivatives) {
+			auxiliaryOutputs.push(derivative);
+		}
+		backend = Systolic::BatchBackend::Dual;
+		return results;
+	}
+
+	// And chains of modular polynomial cells sharing their modulus and reduction.
+	std::vector<std::int64_t> residues;
+	const Systolic::Cell::ModularPolynomialCell *head = dynamic_cast<const Systolic::Cell::ModularPolynomialCell *>(cells.front().get());
+
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		const Systolic::Cell::ModularPolynomialCell *modular
+			= dynamic_cast<const Systolic::Cell::ModularPolynomialCell *>(cell.get());
+
+		if (modular == nullptr || modular->getModulus() != head->getModulus() || modular->getReduction() != head->getReduction()) {
+			residues.clear();
+			break;
+		}
+		residues.push_back(modular->getCoef());
+	}
+	if (!residues.empty()) {
+		Systolic::Backend::ModularEvaluator evaluator(residues, static_cast<std::uint64_t>(head->getModulus()), head->getReduction());
+		const std::vector<std::uint64_t> values = evaluator.evaluate(std::vector<std::int64_t>(xs.begin(), xs.end()));
+
+		backend = Systolic::BatchBackend::Modular;
+		return std::vector<int>(values.begin(), values.end()); // Residues are below the modulus of the cells, itself an int.
+	}
+
+	// So do chains of FIR cells, whose delay registers are kept in sync with the filter history.
+	std::vector<Systolic::Cell::FirCell *> firCells;
+
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		Systolic::Cell::FirCell *fir = dynamic_cast<Systolic::Cell::FirCell *>(cell.get());
+
+		if (fir == nullptr) {
+			firCells.clear();
+			break;
+		}
+		firCells.push_back(fir);
+	}
+	if (!firCells.empty()) {
+		std::vector<int> taps;
+		std::vector<int> history(firCells.size());
+
+		for (std::size_t k = 0; k != firCells.size(); k++) { // The k-th cell holds the k-th latest sample.
+			taps.push_back(firCells[k]->getTap());
+			history[firCells.size() - 1 - k] = firCells[k]->getDelay();
+		}
+
+		Systolic::Backend::FirFilter filter(taps);
+
+		filter.setHistory(history);
+		results = filter.process(xs.toVector());
+		history = filter.getHistory();
+		for (std::size_t k = 0; k != firCells.size(); k++) {
+			firCells[k]->setDelay(history[firCells.size() - 1 - k]);
+		}
+		backend = Systolic::BatchBackend::Fir;
+		return results;
+	}
+
+	// Chains of container cells run the whole batch through each nested chain, feeding it or adding up its results.
+	std::vector<Systolic::Cell::ContainerCell *> nested;
+
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		Systolic::Cell::ContainerCell *container = dynamic_cast<Systolic::Cell::ContainerCell *>(cell.get());
+
+		if (container == nullptr) {
+			nested.clear();
+			break;
+		}
+		nested.push_back(container);
+	}
+	if (!nested.empty()) {
+		const std::vector<int> contiguous = xs.toVector();
+		std::vector<int> sums; // Empty until the first nested chain, as the sum fed to the first cell.
+
+		for (Systolic::Cell::ContainerCell *container : nested) {
+			if (container->getMode() == Systolic::Cell::NestedMode::Stage) {
+				const std::vector<int> &values = (sums.empty() ? contiguous : sums);
+
+				sums = container->evaluate(values.data(), values.size());
+				continue;
+			}
+
+			const std::vector<int> values = container->evaluate(contiguous.data(), contiguous.size());
+
+			sums.resize(values.size(), 0);
+			for (std::size_t i = 0; i != values.size(); i++) { // Unsigned, as to wrap around as the cells do.
+				sums[i] = static_cast<int>(static_cast<std::uint32_t>(sums[i]) + static_cast<std::uint32_t>(values[i]));
+			}
+		}
+		backend = Systolic::BatchBackend::Nested;
+		return sums;
+	}
+
+	// Any other chain computes each input from its first to its last cell.
+	for (int x : xs) {
+		std::tuple<std::optional<int>, std::optional<int>> token = std::make_tuple(std::nullopt, x);
+		std::optional<int> auxiliary;
+
+		for (std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+			cell->feed(token);
+			cell->feedAuxiliary(auxiliary);
+			token = cell->compute();
+			auxiliary = cell->getAuxiliary();
+		}
+		results.push_back(std::get<0>(token).value());
+		if (cells.back()->hasAuxiliary()) {
+			auxiliaryOutputs.push(auxiliary.value());
+		}
+	}
+	for (std::unique_ptr<Systolic::Cell::ICell> &cell : cells) { // Leaves the cells empty, as compute does.
+		cell->feed(std::make_tuple(std::nullopt, std::nullopt));
+		cell->feedAuxiliary(std::nullopt);
+		cell->compute();
+	}
+	backend = Systolic::BatchBackend::Cells;
+	return results;
+}
+
+std::vector<int> Systolic::BatchEvaluator::evaluateMemoized(const Util::RingView<int> &xs, Systolic::ResultCache &cache,
+							     const std::uint64_t pipelineId)
+{
+	const auto bounds = std::minmax_element(xs.begin(), xs.end());
+	const long long low = *bounds.first;
+	const std::size_t domain = static_cast<std::size_t>(*bounds.second - low + 1);
+	std::vector<int> results(xs.size());
+	std::vector<int> uniques; // Distinct values missing from the cache.
+	std::vector<int> missingResults; // Results of the distinct values missing from the cache.
+
+	if (domain <= denseDomain) {
+		// Small domains are deduplicated by a dense table of the known results, indexed by X.
+		std::vector<int> table(domain);
+		std::vector<std::uint8_t> known(domain, 0); // 0 if unknown, 1 if known, 2 if to evaluate.
+
+		for (int x : xs) {
+			const std::size_t i = static_cast<std::size_t>(x - low);
+
+			if (known[i] == 0) {
+				std::optional<int> cached = cache.find(pipelineId, x);
+
+				if (cached.has_value()) {
+					table[i] = cached.value();
+					known[i] = 1;
+				} else {
+					uniques.push_back(x);
+					known[i] = 2;
+				}
+			}
+		}
+		missingResults = evaluateBatch(Util::RingView<int>(uniques.data(), uniques.size()));
+		for (std::size_t k = 0; k != uniques.size(); k++) {
+			table[static_cast<std::size_t>(uniques[k] - low)] = missingResults[k];
+			cache.insert(pipelineId, uniques[k], missingResults[k]);
+		}
+		for (std::size_t i = 0; i != xs.size(); i++) {
+			results[i] = table[static_cast<std::size_t>(xs[i] - low)];
+		}
+	} else {
+		// Wide domains are deduplicated by a hash table first, only the distinct values being looked up in the cache.
+		DistinctValues distinct;
+		std::vector<std::size_t> indexes(xs.size()); // Index of the distinct value of each X.
+
+		for (std::size_t i = 0; i != xs.size(); i++) {
+			indexes[i] = distinct.indexOf(xs[i]);
+		}
+
+		const std::vector<int> &values = distinct.getValues();
+		std::vector<int> table(values.size());
+		std::vector<std::size_t> missing; // Index of the distinct values missing from the cache.
+
+		for (std::size_t k = 0; k != values.size(); k++) {
+			std::optional<int> cached = cache.find(pipelineId, values[k]);
+
+			if (cached.has_value()) {
+				table[k] = cached.value();
+			} else {
+				missing.push_back(k);
+				uniques.push_back(values[k]);
+			}
+		}
+		missingResults = evaluateBatch(Util::RingView<int>(uniques.data(), uniques.size()));
+		for (std::size_t k = 0; k != uniques.size(); k++) {
+			table[missing[k]] = missingResults[k];
+			cache.insert(pipelineId, uniques[k], missingResults[k]);
+		}
+		for (std::size_t i = 0; i != xs.size(); i++) {
+			results[i] = table[indexes[i]];
+		}
+	}
+	evaluated += uniques.size();
+	return results;
+}
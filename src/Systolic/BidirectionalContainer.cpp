@@ -0,0 +1,285 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BidirectionalContainer.cpp
+ * Implementation of BidirectionalContainer.
+ */
+
+#include "Systolic/Container/BidirectionalContainer.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+Systolic::BidirectionalContainer::BidirectionalContainer(const std::vector<std::vector<int>> vectors)
+	: vectors(vectors), current(0), tick(0)
+{
+}
+
+void Systolic::BidirectionalContainer::setCells(std::vector<std::unique_ptr<Systolic::Cell::BandCell>> cells)
+{
+	for (std::size_t k = 0; k != cells.size(); k++) {
+		if (cells[k] == nullptr || cells[k]->getDiagonal().size() != cells.front()->getDiagonal().size()) {
+			throw std::invalid_argument("Every cell must hold a diagonal of the same matrix.");
+		}
+		if (cells[k]->getOffset() != cells.front()->getOffset() - static_cast<int>(k)) {
+			throw std::invalid_argument("Cells must hold consecutive diagonals, from the highest to the lowest.");
+		}
+	}
+	this->cells = std::move(cells);
+	current = 0;
+	tick = 0;
+	result.clear();
+}
+
+void Systolic::BidirectionalContainer::setCells(std::shared_ptr<Systolic::BandBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setCells(builder->build());
+}
+
+void Systolic::BidirectionalContainer::step()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Warn: Cannot compute container step: No cells available." << std::endl;
+		return;
+	}
+	if (isDone()) {
+		return;
+	}
+
+	const std::vector<int> &x = vectors[current];
+	const std::size_t t = tick;
+	const std::size_t forwardDelay = getForwardDelay();
+	const std::size_t backwardDelay = getBackwardDelay();
+
+	if (result.size() == current) {
+		result.emplace_back(getRows(), 0);
+	}
+
+	// Feeds X on the left end and Y on the right end every other step, and every other cell with its neighbours' partials.
+	for (std::size_t k = 0; k != cells.size(); k++) {
+		std::optional<int> forward;
+		std::optional<int> backward;
+
+		if (k != 0) {
+			forward = std::get<0>(cells[k - 1]->getPartial());
+		} else if (t >= forwardDelay && (t - forwardDelay) % 2 == 0 && (t - forwardDelay) / 2 < x.size()) {
+			forward = x[(t - forwardDelay) / 2];
+		}
+		if (k + 1 != cells.size()) {
+			backward = std::get<1>(cells[k + 1]->getPartial());
+		} else if (t >= backwardDelay && (t - backwardDelay) % 2 == 0 && (t - backwardDelay) / 2 < getRows()) {
+			backward = 0;
+		}
+		cells[k]->feed(forward, backward);
+	}
+
+	// Compute the current value of each cell, spread over the scheduler.
+	Systolic::Backend::Scheduler::getInstance().parallelFor(cells.size(), [this](const std::size_t k){
+			cells[k]->compute();
+		});
+
+	// Collects the element of Y leaving the first cell, the one of row i leaving after 2i + w - 1 steps.
+	std::optional<int> y = std::get<1>(cells.front()->getPartial());
+
+	if (y.has_value()) {
+		result[current][(t - backwardDelay - (cells.size() - 1)) / 2] = y.value();
+	}
+	if (++tick == getStepCount()) {
+		for (std::unique_ptr<Systolic::Cell::BandCell> &cell : cells) {
+			cell->reset();
+		}
+		tick = 0;
+		current++;
+	}
+}
+
+void Systolic::BidirectionalContainer::compute()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (vectors.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	while (!isDone()) {
+		logs.push_back(makeLogEntry());
+		step();
+	}
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::BidirectionalContainer::computeBatch()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (vectors.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+
+	const std::size_t rows = getRows();
+	/* Unsigned values, as to wrap around as the cells do. */
+	std::vector<std::uint32_t> diagonals;
+	std::vector<std::uint32_t> ys(vectors.size() * rows, 0);
+
+	for (const std::unique_ptr<Systolic::Cell::BandCell> &cell : cells) {
+		diagonals.insert(diagonals.end(), cell->getDiagonal().begin(), cell->getDiagonal().end());
+	}
+
+	/* Groups of vectors are spread over the scheduler, each group going through the rows block by block. */
+	constexpr std::size_t groupSize = 8;
+	constexpr std::size_t blockRows = 2048;
+	const std::size_t groups = (vectors.size() + groupSize - 1) / groupSize;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(groups, [&](const std::size_t group){
+			const std::size_t vEnd = std::min(vectors.size(), (group + 1) * groupSize);
+
+			for (std::size_t ii = 0; ii < rows; ii += blockRows) {
+				for (std::size_t v = group * groupSize; v != vEnd; v++) {
+					const std::vector<int> &x = vectors[v];
+					std::uint32_t *y = ys.data() + v * rows;
+
+					for (std::size_t k = 0; k != cells.size(); k++) {
+						const long offset = cells[k]->getOffset();
+						const std::uint32_t *diagonal = diagonals.data() + k * rows;
+						/* Rows whose column i + offset is in X. */
+						const long first = std::max<long>(ii, -offset);
+						const long last = std::min<long>(std::min(rows, ii + blockRows),
+										 static_cast<long>(x.size()) - offset);
+
+						for (long i = first; i < last; i++) {
+							y[i] += diagonal[i] * static_cast<std::uint32_t>(x[i + offset]);
+						}
+					}
+				}
+			}
+		});
+	result.assign(vectors.size(), std::vector<int>(rows));
+	for (std::size_t v = 0; v != vectors.size(); v++) {
+		std::copy(ys.begin() + v * rows, ys.begin() + (v + 1) * rows, result[v].begin());
+	}
+	current = vectors.size();
+	tick = 0;
+}
+
+bool Systolic::BidirectionalContainer::isDone() const
+{
+	return !cells.empty() && current >= vectors.size();
+}
+
+std::vector<std::vector<int>> Systolic::BidirectionalContainer::getResult() const
+{
+	return result;
+}
+
+void Systolic::BidirectionalContainer::dumpResult() const
+{
+	for (const std::vector<int> &row : result) {
+		for (std::size_t j = 0; j != row.size(); j++) {
+			std::cout << row[j] << (j + 1 != row.size() ? "," : "");
+		}
+		std::cout << std::endl;
+	}
+}
+
+std::string Systolic::BidirectionalContainer::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::BidirectionalContainer::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+std::size_t Systolic::BidirectionalContainer::getRows() const
+{
+	return cells.front()->getDiagonal().size();
+}
+
+std::size_t Systolic::BidirectionalContainer::getForwardDelay() const
+{
+	// X and Y must meet in the cell holding their diagonal, which requires upper - lower steps between both.
+	const int upper = cells.front()->getOffset();
+	const int lower = -cells.back()->getOffset();
+
+	return static_cast<std::size_t>(std::max(0, lower - upper));
+}
+
+std::size_t Systolic::BidirectionalContainer::getBackwardDelay() const
+{
+	const int upper = cells.front()->getOffset();
+	const int lower = -cells.back()->getOffset();
+
+	return static_cast<std::size_t>(std::max(0, upper - lower));
+}
+
+std::size_t Systolic::BidirectionalContainer::getStepCount() const
+{
+	// The last element of Y leaves the first cell after 2(m - 1) + w steps.
+	return 2 * (getRows() - 1) + getBackwardDelay() + cells.size();
+}
+
+std::string Systolic::BidirectionalContainer::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying every cell as [forward, backward | description]. */
+	for (const std::unique_ptr<Systolic::Cell::BandCell> &cell : cells) {
+		ss << "[" << std::setw(6) << optionalToString(std::get<0>(cell->getInputs()))
+		   << "," << std::setw(6) << optionalToString(std::get<1>(cell->getInputs()))
+		   << " | " << std::setw(8) << std::left << cell->getCellDescription() << std::right << "] ";
+	}
+	ss << std::endl << std::endl;
+	return ss.str();
+}
+
+std::string Systolic::BidirectionalContainer::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
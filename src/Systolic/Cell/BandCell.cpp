@@ -0,0 +1,83 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BandCell.cpp
+ * Implementation of BandCell.
+ */
+
+#include "Systolic/Cell/BandCell.hpp"
+
+Systolic::Cell::BandCell::BandCell(const std::vector<int> diagonal, const int offset)
+	: diagonal(diagonal), offset(offset), row(0), forward{}, backward{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::BandCell::compute()
+{
+	std::optional<int> sum = backward;
+
+	if (backward.has_value()) {
+		if (forward.has_value() && row < diagonal.size()) {
+			sum = backward.value() + diagonal[row] * forward.value();
+		}
+		row++;
+	}
+	partial = std::make_tuple(forward, sum);
+	return partial;
+}
+
+void Systolic::Cell::BandCell::feed(const std::optional<int> forward, const std::optional<int> backward)
+{
+	this->forward = forward;
+	this->backward = backward;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::BandCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::BandCell::getInputs() const
+{
+	return std::make_tuple(forward, backward);
+}
+
+const std::vector<int> &Systolic::Cell::BandCell::getDiagonal() const
+{
+	return diagonal;
+}
+
+int Systolic::Cell::BandCell::getOffset() const
+{
+	return offset;
+}
+
+void Systolic::Cell::BandCell::reset()
+{
+	row = 0;
+	forward = std::nullopt;
+	backward = std::nullopt;
+	partial = std::make_tuple(std::nullopt, std::nullopt);
+}
+
+std::string Systolic::Cell::BandCell::getCellDescription() const
+{
+	return ("diag " + std::to_string(offset));
+}
@@ -0,0 +1,79 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BasicPolynomialCell.cpp
+ * Implementation of BasicPolynomialCell.
+ */
+
+#include "Systolic/Cell/BasicPolynomialCell.hpp"
+
+template <typename T>
+Systolic::Cell::BasicPolynomialCell<T>::BasicPolynomialCell(const T coef)
+	: coef(coef), input{}, sum{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicPolynomialCell<T>::compute()
+{
+	if (input.has_value()) {
+		partial = std::make_tuple(Systolic::Backend::ValueTraits<T>::multiplyAdd(sum.value_or(T{}), input.value(), coef),
+					  input.value());
+	} else {
+		partial = std::make_tuple(std::nullopt, std::nullopt);
+	}
+	return partial;
+}
+
+template <typename T>
+void Systolic::Cell::BasicPolynomialCell<T>::feed(const std::tuple<std::optional<T>, std::optional<T>> input)
+{
+	this->input = std::get<1>(input);
+	this->sum = std::get<0>(input);
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicPolynomialCell<T>::getPartial() const
+{
+	return partial;
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicPolynomialCell<T>::getInputs() const
+{
+	return std::make_tuple(sum, input);
+}
+
+template <typename T>
+std::string Systolic::Cell::BasicPolynomialCell<T>::getCellDescription() const
+{
+	return ("* X + " + Systolic::Backend::ValueTraits<T>::toString(coef));
+}
+
+template <typename T>
+T Systolic::Cell::BasicPolynomialCell<T>::getCoef() const
+{
+	return coef;
+}
+
+template class Systolic::Cell::BasicPolynomialCell<std::int32_t>;
+template class Systolic::Cell::BasicPolynomialCell<std::int64_t>;
+template class Systolic::Cell::BasicPolynomialCell<double>;
+template class Systolic::Cell::BasicPolynomialCell<Systolic::Backend::Q16>;
@@ -0,0 +1,86 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file CompareExchangeCell.cpp
+ * Implementation of CompareExchangeCell.
+ */
+
+#include "Systolic/Cell/CompareExchangeCell.hpp"
+
+#include <utility>
+
+Systolic::Cell::CompareExchangeCell::CompareExchangeCell()
+	: value{}, incoming{}, partial{}
+{
+}
+
+std::optional<int> Systolic::Cell::CompareExchangeCell::compute()
+{
+	if (!value.has_value()) {
+		value = incoming;
+		partial = std::nullopt;
+	} else if (incoming.has_value() && incoming.value() < value.value()) {
+		partial = value;
+		value = incoming;
+	} else {
+		partial = incoming;
+	}
+	return partial;
+}
+
+void Systolic::Cell::CompareExchangeCell::feed(const std::optional<int> incoming)
+{
+	this->incoming = incoming;
+}
+
+void Systolic::Cell::CompareExchangeCell::exchange(Systolic::Cell::CompareExchangeCell &right)
+{
+	if (right.value.has_value() && (!value.has_value() || right.value.value() < value.value())) {
+		std::swap(value, right.value);
+	}
+}
+
+std::optional<int> Systolic::Cell::CompareExchangeCell::shift(const std::optional<int> incoming)
+{
+	std::optional<int> previous = value;
+
+	value = incoming;
+	return previous;
+}
+
+std::optional<int> Systolic::Cell::CompareExchangeCell::getValue() const
+{
+	return value;
+}
+
+std::optional<int> Systolic::Cell::CompareExchangeCell::getPartial() const
+{
+	return partial;
+}
+
+std::optional<int> Systolic::Cell::CompareExchangeCell::getInputs() const
+{
+	return incoming;
+}
+
+std::string Systolic::Cell::CompareExchangeCell::getCellDescription() const
+{
+	return (value.has_value() ? "min " + std::to_string(value.value()) : "min {}");
+}
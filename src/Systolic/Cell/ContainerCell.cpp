@@ -0,0 +1,159 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ContainerCell.cpp
+ * Implementation of ContainerCell.
+ */
+
+#include "Systolic/Cell/ContainerCell.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+Systolic::Cell::ContainerCell::ContainerCell(std::vector<std::unique_ptr<ICell>> cells, const NestedMode mode)
+	: container(std::make_unique<Systolic::Container>(std::queue<int>())), mode(mode), stateless(true), dirty(false),
+	  input{}, sum{}, partial(std::nullopt, std::nullopt)
+{
+	if (cells.empty()) {
+		throw std::invalid_argument("Nested containers need at least one cell.");
+	}
+	description = std::string(mode == NestedMode::Sum ? "+ [" : "> [") + cells.front()->getCellDescription();
+	if (cells.size() > 2) {
+		description += " | ... (" + std::to_string(cells.size() - 2) + " more)";
+	}
+	if (cells.size() > 1) {
+		description += " | " + cells.back()->getCellDescription();
+	}
+	description += "]";
+	for (const std::unique_ptr<ICell> &cell : cells) {
+		stateless = stateless && cell->isStateless();
+		chain.push_back(cell.get());
+	}
+	container->setCells(std::move(cells));
+}
+
+Systolic::Cell::ContainerCell::ContainerCell(std::shared_ptr<Systolic::CellArrayBuilder> builder, const NestedMode mode)
+	: ContainerCell((builder != nullptr ? builder->build() : throw std::invalid_argument("Builder is NULL.")), mode)
+{
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::ContainerCell::compute()
+{
+	if (!input.has_value()) {
+		partial = std::make_tuple(std::nullopt, std::nullopt);
+	} else if (mode == NestedMode::Stage) {
+		partial = std::make_tuple(evaluateOne(sum.value_or(input.value())), input);
+	} else {
+		// Unsigned arithmetic, as to wrap around on overflow.
+		const std::uint32_t value = static_cast<std::uint32_t>(sum.value_or(0)) + static_cast<std::uint32_t>(evaluateOne(input.value()));
+
+		partial = std::make_tuple(static_cast<int>(value), input);
+	}
+	return partial;
+}
+
+void Systolic::Cell::ContainerCell::feed(const std::tuple<std::optional<int>, std::optional<int>> input)
+{
+	this->input = std::get<1>(input);
+	this->sum = std::get<0>(input);
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::ContainerCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::ContainerCell::getInputs() const
+{
+	return std::make_tuple(sum, input);
+}
+
+std::string Systolic::Cell::ContainerCell::getCellDescription() const
+{
+	return description;
+}
+
+void Systolic::Cell::ContainerCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (!stateless) {
+		throw std::logic_error("Cell " + description + " cannot restore the state of its nested cells.");
+	}
+	if (registers.size() != 4) {
+		throw std::invalid_argument("Cells have 4 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+}
+
+bool Systolic::Cell::ContainerCell::isStateless() const
+{
+	return stateless;
+}
+
+Systolic::Cell::NestedMode Systolic::Cell::ContainerCell::getMode() const
+{
+	return mode;
+}
+
+std::vector<int> Systolic::Cell::ContainerCell::evaluate(const int *xs, const std::size_t count)
+{
+	if (count == 0) {
+		return {};
+	}
+	if (dirty) { // Empties the nested cells, or the container would flush their values as outputs.
+		for (ICell *cell : chain) {
+			cell->feed(std::make_tuple(std::nullopt, std::nullopt));
+			cell->feedAuxiliary(std::nullopt);
+			cell->compute();
+		}
+		dirty = false;
+	}
+	container->setInputs(xs, count);
+	container->computeBatch();
+	return container->takeOutputs();
+}
+
+int Systolic::Cell::ContainerCell::evaluateOne(const int x)
+{
+	std::tuple<std::optional<int>, std::optional<int>> token = std::make_tuple(std::nullopt, x);
+	std::optional<int> auxiliary;
+
+	// A single value goes from the first nested cell to the last one within the tick, without a batch.
+	for (ICell *cell : chain) {
+		cell->feed(token);
+		cell->feedAuxiliary(auxiliary);
+		token = cell->compute();
+		auxiliary = cell->getAuxiliary();
+	}
+	dirty = true;
+	return std::get<0>(token).value();
+}
+
+Systolic::CellCost Systolic::Cell::ContainerCell::getCost(const Systolic::CostModel &model) const
+{
+	Systolic::CellCost cost{0, 1};
+
+	for (const Systolic::CellCost &cell : container->getCellCosts(model)) {
+		cost.latency += cell.latency;
+		cost.interval = std::max(cost.interval, cell.interval);
+	}
+	return cost;
+}
@@ -0,0 +1,105 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file DualPolynomialCell.cpp
+ * Implementation of DualPolynomialCell.
+ */
+
+#include "Systolic/Cell/DualPolynomialCell.hpp"
+
+Systolic::Cell::DualPolynomialCell::DualPolynomialCell(const int coef)
+	: coef(coef), input{}, sum{}, derivative{}, partial(std::nullopt, std::nullopt), partialDerivative{}
+{
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::DualPolynomialCell::compute()
+{
+	if (input.has_value()) {
+		// Unsigned arithmetic, as to wrap around as the batch evaluation does.
+		const unsigned x = static_cast<unsigned>(input.value());
+		const unsigned s = static_cast<unsigned>(sum.value_or(0));
+		const unsigned d = static_cast<unsigned>(derivative.value_or(0));
+
+		partialDerivative = static_cast<int>(d * x + s);
+		partial = std::make_tuple(static_cast<int>(s * x + static_cast<unsigned>(coef)), input.value());
+	} else {
+		partialDerivative = std::nullopt;
+		partial = std::make_tuple(std::nullopt, std::nullopt);
+	}
+	return partial;
+}
+
+void Systolic::Cell::DualPolynomialCell::feed(const std::tuple<std::optional<int>, std::optional<int>> input)
+{
+	this->input = std::get<1>(input);
+	this->sum = std::get<0>(input);
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::DualPolynomialCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::DualPolynomialCell::getInputs() const
+{
+	return std::make_tuple(sum, input);
+}
+
+std::string Systolic::Cell::DualPolynomialCell::getCellDescription() const
+{
+	return ("* X + " + std::to_string(coef) + " d/dX");
+}
+
+std::vector<std::optional<int>> Systolic::Cell::DualPolynomialCell::getRegisters() const
+{
+	return {sum, input, std::get<0>(partial), std::get<1>(partial), derivative, partialDerivative};
+}
+
+void Systolic::Cell::DualPolynomialCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (registers.size() != 6) {
+		throw std::invalid_argument("Dual polynomial cells have 6 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+	derivative = registers[4];
+	partialDerivative = registers[5];
+}
+
+bool Systolic::Cell::DualPolynomialCell::hasAuxiliary() const
+{
+	return true;
+}
+
+void Systolic::Cell::DualPolynomialCell::feedAuxiliary(const std::optional<int> auxiliary)
+{
+	derivative = auxiliary;
+}
+
+std::optional<int> Systolic::Cell::DualPolynomialCell::getAuxiliary() const
+{
+	return partialDerivative;
+}
+
+int Systolic::Cell::DualPolynomialCell::getCoef() const
+{
+	return coef;
+}
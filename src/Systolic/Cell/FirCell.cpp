@@ -0,0 +1,98 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file FirCell.cpp
+ * Implementation of FirCell.
+ */
+
+#include "Systolic/Cell/FirCell.hpp"
+
+Systolic::Cell::FirCell::FirCell(const int tap)
+	: tap(tap), delay(0), input{}, sum{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::FirCell::compute()
+{
+	if (input.has_value()) {
+		partial = std::make_tuple(sum.value_or(0) + tap * input.value(), delay);
+		delay = input.value();
+	} else {
+		partial = std::make_tuple(std::nullopt, std::nullopt);
+	}
+	return partial;
+}
+
+void Systolic::Cell::FirCell::feed(const std::tuple<std::optional<int>, std::optional<int>> input)
+{
+	this->input = std::get<1>(input);
+	this->sum = std::get<0>(input);
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::FirCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::FirCell::getInputs() const
+{
+	return std::make_tuple(sum, input);
+}
+
+std::string Systolic::Cell::FirCell::getCellDescription() const
+{
+	return ("+ X * " + std::to_string(tap) + " z-1");
+}
+
+std::vector<std::optional<int>> Systolic::Cell::FirCell::getRegisters() const
+{
+	return {sum, input, std::get<0>(partial), std::get<1>(partial), delay};
+}
+
+void Systolic::Cell::FirCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (registers.size() != 5 || !registers[4].has_value()) {
+		throw std::invalid_argument("FIR cells have 5 registers, the last one being set.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+	delay = registers[4].value();
+}
+
+bool Systolic::Cell::FirCell::isStateless() const
+{
+	return false;
+}
+
+int Systolic::Cell::FirCell::getTap() const
+{
+	return tap;
+}
+
+int Systolic::Cell::FirCell::getDelay() const
+{
+	return delay;
+}
+
+void Systolic::Cell::FirCell::setDelay(const int delay)
+{
+	this->delay = delay;
+}
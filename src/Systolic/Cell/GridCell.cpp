@@ -0,0 +1,91 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GridCell.cpp
+ * Implementation of GridCell.
+ */
+
+#include "Systolic/Cell/GridCell.hpp"
+
+Systolic::Cell::GridCell::GridCell()
+	: dataflow(Dataflow::OutputStationary), weight(0), accumulator(0),
+	  west{}, north{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+Systolic::Cell::GridCell::GridCell(const int weight)
+	: dataflow(Dataflow::WeightStationary), weight(weight), accumulator(0),
+	  west{}, north{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::GridCell::compute()
+{
+	if (dataflow == Dataflow::OutputStationary) {
+		if (west.has_value() && north.has_value()) {
+			accumulator += west.value() * north.value();
+		}
+		partial = std::make_tuple(west, north);
+	} else if (west.has_value()) {
+		partial = std::make_tuple(west, north.value_or(0) + west.value() * weight);
+	} else {
+		partial = std::make_tuple(std::nullopt, north);
+	}
+	return partial;
+}
+
+void Systolic::Cell::GridCell::feed(const std::optional<int> west, const std::optional<int> north)
+{
+	this->west = west;
+	this->north = north;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::GridCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>> Systolic::Cell::GridCell::getInputs() const
+{
+	return std::make_tuple(west, north);
+}
+
+int Systolic::Cell::GridCell::getAccumulator() const
+{
+	return accumulator;
+}
+
+int Systolic::Cell::GridCell::getWeight() const
+{
+	return weight;
+}
+
+Systolic::Cell::Dataflow Systolic::Cell::GridCell::getDataflow() const
+{
+	return dataflow;
+}
+
+std::string Systolic::Cell::GridCell::getCellDescription() const
+{
+	if (dataflow == Dataflow::OutputStationary) {
+		return ("acc " + std::to_string(accumulator));
+	}
+	return ("w " + std::to_string(weight));
+}
@@ -0,0 +1,126 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ModularPolynomialCell.cpp
+ * Implementation of BasicModularPolynomialCell.
+ */
+
+#include "Systolic/Cell/ModularPolynomialCell.hpp"
+
+namespace {
+
+	template <typename Word>
+	std::variant<Systolic::Backend::Montgomery<Word>, Systolic::Backend::Barrett<Word>>
+	makeArithmetic(const std::int64_t modulus, const Systolic::Backend::Reduction reduction)
+	{
+		if (modulus < 2) {
+			throw std::invalid_argument("Modulus of a modular cell must be at least 2.");
+		}
+		if (reduction == Systolic::Backend::Reduction::Montgomery) {
+			return Systolic::Backend::Montgomery<Word>(static_cast<Word>(modulus));
+		}
+		return Systolic::Backend::Barrett<Word>(static_cast<Word>(modulus));
+	}
+}
+
+template <typename T>
+Systolic::Cell::BasicModularPolynomialCell<T>::BasicModularPolynomialCell(const T coef, const T modulus,
+									 const Systolic::Backend::Reduction reduction)
+	: coef(coef), reduction(reduction), arithmetic(makeArithmetic<Word>(modulus, reduction)),
+	  input{}, sum{}, partial(std::nullopt, std::nullopt)
+{
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicModularPolynomialCell<T>::compute()
+{
+	if (input.has_value()) {
+		const Word res = std::visit([this](const auto &a) {
+				const Word x = Systolic::Backend::residue<Word>(input.value(), a.getModulus());
+				const Word s = Systolic::Backend::residue<Word>(sum.value_or(0), a.getModulus());
+
+				return a.add(a.multiply(s, a.prepare(x)), Systolic::Backend::residue<Word>(coef, a.getModulus()));
+			}, arithmetic);
+
+		partial = std::make_tuple(static_cast<T>(res), input.value()); // Residues are below the modulus, itself a T.
+	} else {
+		partial = std::make_tuple(std::nullopt, std::nullopt);
+	}
+	return partial;
+}
+
+template <typename T>
+void Systolic::Cell::BasicModularPolynomialCell<T>::feed(const std::tuple<std::optional<T>, std::optional<T>> input)
+{
+	this->input = std::get<1>(input);
+	this->sum = std::get<0>(input);
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicModularPolynomialCell<T>::getPartial() const
+{
+	return partial;
+}
+
+template <typename T>
+std::tuple<std::optional<T>, std::optional<T>> Systolic::Cell::BasicModularPolynomialCell<T>::getInputs() const
+{
+	return std::make_tuple(sum, input);
+}
+
+template <typename T>
+std::string Systolic::Cell::BasicModularPolynomialCell<T>::getCellDescription() const
+{
+	return ("* X + " + std::to_string(coef) + " % " + std::to_string(getModulus()));
+}
+
+template <typename T>
+void Systolic::Cell::BasicModularPolynomialCell<T>::setRegisters(const std::vector<std::optional<T>> &registers)
+{
+	if (registers.size() != 4) {
+		throw std::invalid_argument("Cells have 4 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+}
+
+template <typename T>
+T Systolic::Cell::BasicModularPolynomialCell<T>::getCoef() const
+{
+	return coef;
+}
+
+template <typename T>
+T Systolic::Cell::BasicModularPolynomialCell<T>::getModulus() const
+{
+	return static_cast<T>(std::visit([](const auto &a) { return a.getModulus(); }, arithmetic));
+}
+
+template <typename T>
+Systolic::Backend::Reduction Systolic::Cell::BasicModularPolynomialCell<T>::getReduction() const
+{
+	return reduction;
+}
+
+template class Systolic::Cell::BasicModularPolynomialCell<std::int32_t>;
+#ifdef __SIZEOF_INT128__
+template class Systolic::Cell::BasicModularPolynomialCell<std::int64_t>;
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file MultiplyAddCell.cpp
+ * Implementation of MultiplyAddCell.
+ */
+
+#include "Systolic/Cell/MultiplyAddCell.hpp"
+
+Systolic::Cell::MultiplyAddCell::MultiplyAddCell()
+	: isLeaf(false), low{}, high{}, power{}, partial{}
+{
+}
+
+Systolic::Cell::MultiplyAddCell::MultiplyAddCell(const int low, const int high)
+	: isLeaf(true), low(low), high(high), power{}, partial{}
+{
+}
+
+std::optional<int> Systolic::Cell::MultiplyAddCell::compute()
+{
+	if (power.has_value() && low.has_value() && high.has_value()) {
+		partial = low.value() + high.value() * power.value();
+	} else {
+		partial = std::nullopt;
+	}
+	return partial;
+}
+
+void Systolic::Cell::MultiplyAddCell::feed(const std::optional<int> low, const std::optional<int> high,
+					   const std::optional<int> power)
+{
+	if (!isLeaf) {
+		this->low = low;
+		this->high = high;
+	}
+	this->power = power;
+}
+
+std::optional<int> Systolic::Cell::MultiplyAddCell::getPartial() const
+{
+	return partial;
+}
+
+std::tuple<std::optional<int>, std::optional<int>, std::optional<int>>
+Systolic::Cell::MultiplyAddCell::getInputs() const
+{
+	return std::make_tuple(low, high, power);
+}
+
+std::string Systolic::Cell::MultiplyAddCell::getCellDescription() const
+{
+	if (isLeaf) {
+		return (std::to_string(low.value()) + " + " + std::to_string(high.value()) + " * P");
+	}
+	return "L + H * P";
+}
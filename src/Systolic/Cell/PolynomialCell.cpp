@@ -59,3 +59,23 @@ std::string Systolic::Cell::PolynomialCell::getCellDescription() const
 {
 	return ("* X + " + std::to_string(coef));
 }
+
+void Systolic::Cell::PolynomialCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (registers.size() != 4) {
+		throw std::invalid_argument("Cells have 4 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+}
+
+int Systolic::Cell::PolynomialCell::getCoef() const
+{
+	return coef;
+}
+
+void Systolic::Cell::PolynomialCell::setCoef(const int coef)
+{
+	this->coef = coef;
+}
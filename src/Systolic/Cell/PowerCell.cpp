@@ -59,3 +59,13 @@ std::string Systolic::Cell::PowerCell::getCellDescription() const
 {
 	return ("+ X^" + std::to_string(coef));
 }
+
+void Systolic::Cell::PowerCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (registers.size() != 4) {
+		throw std::invalid_argument("Cells have 4 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+}
@@ -59,3 +59,13 @@ std::string Systolic::Cell::SquareCell::getCellDescription() const
 {
 	return "+ X^2";
 }
+
+void Systolic::Cell::SquareCell::setRegisters(const std::vector<std::optional<int>> &registers)
+{
+	if (registers.size() != 4) {
+		throw std::invalid_argument("Cells have 4 registers.");
+	}
+	sum = registers[0];
+	input = registers[1];
+	partial = std::make_tuple(registers[2], registers[3]);
+}
@@ -0,0 +1,100 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file WidePolynomialCell.cpp
+ * Implementation of WidePolynomialCell.
+ */
+
+#include "Systolic/Cell/WidePolynomialCell.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+Systolic::Cell::WidePolynomialCell::WidePolynomialCell(const std::vector<int> &coefs)
+	: coefs(coefs), input{}, partial{}
+{
+	if (coefs.empty()) {
+		throw std::invalid_argument("Cannot declare a wide cell without coefficients.");
+	}
+}
+
+std::optional<int> Systolic::Cell::WidePolynomialCell::compute()
+{
+	partial = input;
+	if (!input.has_value()) {
+		partialSums.clear();
+		return partial;
+	}
+
+	// Unsigned arithmetic, as to wrap around as PolynomialCell does.
+	const std::uint32_t x = static_cast<std::uint32_t>(input.value());
+
+	partialSums.resize(coefs.size());
+	for (std::size_t m = 0; m != coefs.size(); m++) {
+		const std::uint32_t sum = (sums.empty() ? 0 : static_cast<std::uint32_t>(sums[m]));
+
+		partialSums[m] = static_cast<int>(sum * x + static_cast<std::uint32_t>(coefs[m]));
+	}
+	return partial;
+}
+
+void Systolic::Cell::WidePolynomialCell::feed(const std::optional<int> input, const std::vector<int> &sums)
+{
+	if (!sums.empty() && sums.size() != coefs.size()) {
+		throw std::invalid_argument("Wide cells must be fed as many sums as they have coefficients.");
+	}
+	this->input = input;
+	this->sums = sums;
+}
+
+std::optional<int> Systolic::Cell::WidePolynomialCell::getPartial() const
+{
+	return partial;
+}
+
+const std::vector<int> &Systolic::Cell::WidePolynomialCell::getSums() const
+{
+	return partialSums;
+}
+
+std::optional<int> Systolic::Cell::WidePolynomialCell::getInput() const
+{
+	return input;
+}
+
+const std::vector<int> &Systolic::Cell::WidePolynomialCell::getCoefs() const
+{
+	return coefs;
+}
+
+std::size_t Systolic::Cell::WidePolynomialCell::getWidth() const
+{
+	return coefs.size();
+}
+
+std::string Systolic::Cell::WidePolynomialCell::getCellDescription() const
+{
+	std::string description = "* X + [";
+
+	for (std::size_t m = 0; m != coefs.size(); m++) {
+		description += std::to_string(coefs[m]) + (m + 1 != coefs.size() ? "," : "]");
+	}
+	return description;
+}
@@ -24,11 +24,159 @@
 
 #include "Systolic/Container/CellArrayBuilder.hpp"
 
+#include "Systolic/Cell/ContainerCell.hpp"
+#include "Util/BinaryFile.hpp"
+#include "Util/MappedFile.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+	const char pipelineMagic[4] = {'S', 'Y', 'P', 'L'}; /** First bytes of the pipeline files. */
+
+	std::mutex customCellsMutex;
+	std::unordered_map<std::string, std::function<int(const int)>> customCells; /** Registered custom functions, by name. */
+
+	std::function<int(const int)> findCustomCell(const std::string &name)
+	{
+		std::lock_guard<std::mutex> lock(customCellsMutex);
+		auto it = customCells.find(name);
+
+		return (it != customCells.end() ? it->second : nullptr);
+	}
+
+	/**
+	 * Cursor over a pipeline description.
+	 * Skips the blanks and comments between words and keeps track of
+	 * the line being read, for the error messages.
+	 */
+	class DescriptionReader {
+	public:
+		DescriptionReader(const std::string &text)
+			: text(text), pos(0), line(1), lineStart(0)
+		{
+		}
+
+		bool atEnd()
+		{
+			skipBlanks();
+			return pos == text.size();
+		}
+
+		/** Tell whether the current stage ends, on a |, a new line or the end of the description. */
+		bool atSeparator()
+		{
+			return atEnd() || text[pos] == '|' || text[pos] == '\n';
+		}
+
+		char peek() const
+		{
+			return text[pos];
+		}
+
+		/** Move past the current separator. */
+		void next()
+		{
+			if (text[pos] == '\n') {
+				line++;
+				lineStart = pos + 1;
+			}
+			pos++;
+		}
+
+		std::size_t getPosition()
+		{
+			skipBlanks();
+			return pos;
+		}
+
+		std::string word()
+		{
+			const std::size_t start = getPosition();
+
+			while (pos != text.size() && !std::isspace(static_cast<unsigned char>(text[pos])) && text[pos] != '|' && text[pos] != '#') {
+				pos++;
+			}
+			return text.substr(start, pos - start);
+		}
+
+		int integer(const std::string &cell)
+		{
+			const std::size_t at = getPosition();
+			const std::string value = word();
+			int result = 0;
+			const std::from_chars_result parsed = std::from_chars(value.data(), value.data() + value.size(), result);
+
+			if (value.empty() || parsed.ec != std::errc() || parsed.ptr != value.data() + value.size()) {
+				fail("Expected an integer after " + cell + (value.empty() ? "." : ", got " + value + "."), at);
+			}
+			return result;
+		}
+
+		/** Read the integers up to the end of the stage or the first word, at least one being required. */
+		std::vector<int> integers(const std::string &cell)
+		{
+			std::vector<int> values = {integer(cell)};
+
+			while (!atSeparator() && (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '-')) {
+				values.push_back(integer(cell));
+			}
+			return values;
+		}
+
+		[[noreturn]] void fail(const std::string &message)
+		{
+			fail(message, pos);
+		}
+
+		[[noreturn]] void fail(const std::string &message, const std::size_t at) const
+		{
+			throw std::invalid_argument("Pipeline description, line " + std::to_string(line) + ", column "
+						    + std::to_string(at - lineStart + 1) + ": " + message);
+		}
+	private:
+		const std::string &text;
+		std::size_t pos;
+		std::size_t line; /** Line of pos, from 1. */
+		std::size_t lineStart; /** Position of the first character of that line. */
+
+		/** Skip the blanks and comments, up to a new line at most. */
+		void skipBlanks()
+		{
+			while (pos != text.size() && text[pos] != '\n') {
+				if (text[pos] == '#') {
+					pos = std::min(text.find('\n', pos), text.size());
+				} else if (std::isspace(static_cast<unsigned char>(text[pos]))) {
+					pos++;
+				} else {
+					break;
+				}
+			}
+		}
+	};
+}
+
 std::shared_ptr<Systolic::CellArrayBuilder> Systolic::CellArrayBuilder::getNew()
 {
 	return std::make_shared<Systolic::CellArrayBuilder>();
 }
 
+void Systolic::CellArrayBuilder::registerCustomCell(const std::string &name, const std::function<int(const int)> customFunc)
+{
+	if (name.empty() || customFunc == nullptr) {
+		throw std::invalid_argument("Custom cells must be registered with a name and a function.");
+	}
+
+	std::lock_guard<std::mutex> lock(customCellsMutex);
+
+	customCells[name] = customFunc;
+}
+
 std::shared_ptr<Systolic::CellArrayBuilder>
 Systolic::CellArrayBuilder::add(const Systolic::Cell::Types cellType,
 				const int term)
@@ -36,7 +184,7 @@ Systolic::CellArrayBuilder::add(const Systolic::Cell::Types cellType,
 	if (cellType == Systolic::Cell::Types::Custom) {
 		throw std::invalid_argument("Cannot declare a custom cell with a single integer term.");
 	}
-	cellArray.push_back(std::move(getInstanceFromEnum(cellType, term)));
+	append(getInstanceFromEnum(cellType, term), {static_cast<std::uint8_t>(cellType), 0, 0, term, 0});
 	return shared_from_this();
 }
 
@@ -47,50 +195,423 @@ Systolic::CellArrayBuilder::add(const Systolic::Cell::Types cellType,
 	if (cellType != Systolic::Cell::Types::Custom) {
 		throw std::invalid_argument("Cannot use a custom function on a predefined cell.");
 	}
-	cellArray.push_back(std::make_unique<Systolic::Cell::CustomCell>(customFunc));
+	append(std::make_unique<Systolic::Cell::CustomCell>(customFunc),
+	       {static_cast<std::uint8_t>(cellType), 0, anonymousName, 0, 0});
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::add(const Systolic::Cell::Types cellType, const std::string &name)
+{
+	if (cellType != Systolic::Cell::Types::Custom) {
+		throw std::invalid_argument("Cannot use a custom function on a predefined cell.");
+	}
+
+	const std::function<int(const int)> customFunc = findCustomCell(name);
+	auto it = std::find(customNames.begin(), customNames.end(), name);
+
+	if (customFunc == nullptr) {
+		throw std::invalid_argument("No custom cell is registered as " + name + ".");
+	}
+	if (it == customNames.end()) {
+		if (customNames.size() == anonymousName) {
+			throw std::invalid_argument("Too many custom cell names.");
+		}
+		it = customNames.insert(customNames.end(), name);
+	}
+	append(std::make_unique<Systolic::Cell::CustomCell>(customFunc),
+	       {static_cast<std::uint8_t>(cellType), 0, static_cast<std::uint16_t>(it - customNames.begin()), 0, 0});
 	return shared_from_this();
 }
 
 std::shared_ptr<Systolic::CellArrayBuilder>
-Systolic::CellArrayBuilder::fromPolynomialCoefs(const std::initializer_list<int> coefs)
+Systolic::CellArrayBuilder::addNested(std::shared_ptr<CellArrayBuilder> nested, const Systolic::Cell::NestedMode mode)
 {
+	if (nested == nullptr || nested.get() == this) {
+		throw std::invalid_argument("Cannot nest a null builder or the builder itself.");
+	}
+	append(std::make_unique<Systolic::Cell::ContainerCell>(nested, mode), {nestedType, 0, 0, 0, 0});
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromPolynomialCoefs(const std::initializer_list<int> coefs, const bool withDerivative)
+{
+	using Systolic::Cell::Types;
+
 	for (int coef : coefs) {
-		cellArray.push_back(getInstanceFromEnum(Systolic::Cell::Types::Polynomial, coef));
+		add(withDerivative ? Types::DualPolynomial : Types::Polynomial, coef);
 	}
 	return shared_from_this();
 }
 
 std::shared_ptr<Systolic::CellArrayBuilder>
-Systolic::CellArrayBuilder::fromPolynomialCoefs(const std::queue<int> coefs)
+Systolic::CellArrayBuilder::fromPolynomialCoefs(const std::queue<int> coefs, const bool withDerivative)
 {
+	using Systolic::Cell::Types;
 	std::queue<int> ccoefs = coefs;
 
 	while (!ccoefs.empty()) {
-		cellArray.push_back(getInstanceFromEnum(Systolic::Cell::Types::Polynomial, ccoefs.front()));
+		add(withDerivative ? Types::DualPolynomial : Types::Polynomial, ccoefs.front());
 		ccoefs.pop();
 	}
 	return shared_from_this();
 }
 
 std::shared_ptr<Systolic::CellArrayBuilder>
-Systolic::CellArrayBuilder::fromPolynomialEquation(std::string equation)
+Systolic::CellArrayBuilder::fromPolynomialEquation(std::string equation, const bool withDerivative)
 {
+	using Systolic::Cell::Types;
 	std::vector<std::pair<int, int>> res = getCoefsPair(reformat(equation));
 
 	fillMissingCoefs(res);
 	for (std::pair<int, int> pr : res) {
-		add(Systolic::Cell::Types::Polynomial, std::get<0>(pr));
+		add(withDerivative ? Types::DualPolynomial : Types::Polynomial, std::get<0>(pr));
+	}
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromModularPolynomialCoefs(const std::initializer_list<int> coefs, const int modulus,
+						       const Systolic::Backend::Reduction reduction)
+{
+	for (int coef : coefs) {
+		append(std::make_unique<Systolic::Cell::ModularPolynomialCell>(coef, modulus, reduction),
+		       {modularType, static_cast<std::uint8_t>(reduction), 0, coef, modulus});
+	}
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromModularPolynomialCoefs(const std::queue<int> coefs, const int modulus,
+						       const Systolic::Backend::Reduction reduction)
+{
+	std::queue<int> ccoefs = coefs;
+
+	while (!ccoefs.empty()) {
+		append(std::make_unique<Systolic::Cell::ModularPolynomialCell>(ccoefs.front(), modulus, reduction),
+		       {modularType, static_cast<std::uint8_t>(reduction), 0, ccoefs.front(), modulus});
+		ccoefs.pop();
+	}
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromPolynomialMatrix(const std::vector<std::vector<int>> &coefs)
+{
+	for (const std::vector<int> &row : coefs) {
+		const std::size_t degree = (polynomialMatrix.empty() ? coefs.front().size() : polynomialMatrix.front().size());
+
+		if (row.empty() || row.size() != degree) {
+			throw std::invalid_argument("Every polynomial of the matrix must have the same, non-zero, number of coefficients.");
+		}
+	}
+	polynomialMatrix.insert(polynomialMatrix.end(), coefs.begin(), coefs.end());
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromFirTaps(const std::initializer_list<int> taps)
+{
+	for (int tap : taps) {
+		add(Systolic::Cell::Types::Fir, tap);
 	}
 	return shared_from_this();
 }
 
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromFirTaps(const std::queue<int> taps)
+{
+	std::queue<int> ctaps = taps;
+
+	while (!ctaps.empty()) {
+		add(Systolic::Cell::Types::Fir, ctaps.front());
+		ctaps.pop();
+	}
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder> Systolic::CellArrayBuilder::fromPipelineFile(const std::string &path)
+{
+	using Systolic::Cell::Types;
+	Util::MappedFile file(path);
+
+	if (!file.isOpen()) {
+		throw std::runtime_error("Cannot open pipeline file " + path + ".");
+	}
+
+	Util::BinaryReader reader(file.getData(), file.getSize());
+
+	if (std::memcmp(reader.skip(sizeof(pipelineMagic)), pipelineMagic, sizeof(pipelineMagic)) != 0
+	    || reader.get<std::uint32_t>() != pipelineVersion) {
+		throw std::runtime_error(path + " is not a pipeline file of this version.");
+	}
+
+	const std::uint64_t count = reader.get<std::uint64_t>();
+	std::vector<std::string> names(reader.get<std::uint16_t>());
+	std::vector<std::function<int(const int)>> functions;
+
+	for (std::string &name : names) {
+		name = reader.getString();
+		functions.push_back(findCustomCell(name));
+		if (functions.back() == nullptr) {
+			throw std::runtime_error("Pipeline file " + path + " uses the unregistered custom cell " + name + ".");
+		}
+	}
+	if (count > reader.getRemaining() / sizeof(CellRecord)) {
+		throw std::runtime_error("Truncated file.");
+	}
+
+	// Entries are read in place from the mapping, and the cells only added once all of them are valid.
+	const unsigned char *entries = reader.skip(count * sizeof(CellRecord));
+	std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells;
+	std::vector<CellRecord> entryRecords(count);
+
+	cells.reserve(count);
+	if (count != 0) {
+		std::memcpy(entryRecords.data(), entries, count * sizeof(CellRecord));
+	}
+	for (CellRecord &record : entryRecords) {
+		if (record.type == modularType && record.reduction <= static_cast<std::uint8_t>(Systolic::Backend::Reduction::Barrett)) {
+			cells.push_back(std::make_unique<Systolic::Cell::ModularPolynomialCell>(
+						record.term, record.modulus, static_cast<Systolic::Backend::Reduction>(record.reduction)));
+		} else if (record.type == static_cast<std::uint8_t>(Types::Custom) && record.name < functions.size()) {
+			cells.push_back(std::make_unique<Systolic::Cell::CustomCell>(functions[record.name]));
+		} else if (record.type <= static_cast<std::uint8_t>(Types::DualPolynomial) && record.type != static_cast<std::uint8_t>(Types::Custom)) {
+			cells.push_back(getInstanceFromEnum(static_cast<Types>(record.type), record.term));
+		} else {
+			throw std::runtime_error("Pipeline file " + path + " has an invalid entry.");
+		}
+	}
+
+	appendImported(std::move(cells), std::move(entryRecords), names);
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::CellArrayBuilder>
+Systolic::CellArrayBuilder::fromPipelineDescription(const std::string &description)
+{
+	using Systolic::Cell::Types;
+	DescriptionReader reader(description);
+	std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells;
+	std::vector<CellRecord> entryRecords;
+	std::vector<std::string> names;
+	bool pending = false; // Whether a stage must follow a |.
+
+	// Cells are only added once the whole description is valid, as for pipeline files.
+	while (!reader.atEnd()) {
+		if (reader.atSeparator()) {
+			if (reader.peek() == '|') {
+				reader.fail("Empty stage.");
+			}
+			reader.next();
+			continue;
+		}
+
+		const std::size_t at = reader.getPosition();
+		const std::string cell = reader.word();
+
+		pending = false;
+		std::vector<std::pair<Types, int>> stage; // Predefined cells of the stage.
+
+		if (cell == "add" || cell == "mul" || cell == "div" || cell == "pow") {
+			const Types type = (cell == "add" ? Types::Addition : cell == "mul" ? Types::Multiplication
+					    : cell == "div" ? Types::Division : Types::Power);
+			const int term = reader.integer(cell);
+
+			if (type == Types::Division && term == 0) {
+				reader.fail("Division by zero.", at);
+			}
+			stage.emplace_back(type, term);
+		} else if (cell == "square") {
+			stage.emplace_back(Types::Square, 0);
+		} else if (cell == "poly" || cell == "dual" || cell == "fir") {
+			const Types type = (cell == "poly" ? Types::Polynomial : cell == "dual" ? Types::DualPolynomial : Types::Fir);
+
+			for (int term : reader.integers(cell)) {
+				stage.emplace_back(type, term);
+			}
+		} else if (cell == "mod") {
+			const int modulus = reader.integer(cell);
+			const std::vector<int> coefs = reader.integers(cell);
+			Systolic::Backend::Reduction reduction = Systolic::Backend::Reduction::Montgomery;
+
+			if (!reader.atSeparator()) {
+				const std::size_t wordAt = reader.getPosition();
+				const std::string word = reader.word();
+
+				if (word == "barrett") {
+					reduction = Systolic::Backend::Reduction::Barrett;
+				} else if (word != "montgomery") {
+					reader.fail("Expected montgomery or barrett, got " + word + ".", wordAt);
+				}
+			}
+			try {
+				for (int coef : coefs) {
+					cells.push_back(std::make_unique<Systolic::Cell::ModularPolynomialCell>(coef, modulus, reduction));
+					entryRecords.push_back({modularType, static_cast<std::uint8_t>(reduction), 0, coef, modulus});
+				}
+			} catch (const std::invalid_argument &e) {
+				reader.fail(e.what(), at);
+			}
+		} else if (cell == "custom") {
+			const std::size_t nameAt = reader.getPosition();
+			const std::string name = reader.word();
+			auto it = std::find(names.begin(), names.end(), name);
+
+			if (name.empty()) {
+				reader.fail("Expected the name of a custom cell.", nameAt);
+			}
+			if (findCustomCell(name) == nullptr) {
+				reader.fail("No custom cell is registered as " + name + ".", nameAt);
+			}
+			if (it == names.end()) {
+				it = names.insert(names.end(), name);
+			}
+			cells.push_back(std::make_unique<Systolic::Cell::CustomCell>(findCustomCell(name)));
+			entryRecords.push_back({static_cast<std::uint8_t>(Types::Custom), 0,
+						static_cast<std::uint16_t>(it - names.begin()), 0, 0});
+		} else {
+			reader.fail("Unknown cell " + cell + ".", at);
+		}
+		for (const std::pair<Types, int> &entry : stage) {
+			cells.push_back(getInstanceFromEnum(entry.first, entry.second));
+			entryRecords.push_back({static_cast<std::uint8_t>(entry.first), 0, 0, entry.second, 0});
+		}
+		if (!reader.atSeparator()) {
+			const std::size_t extraAt = reader.getPosition();
+
+			reader.fail("Unexpected " + reader.word() + " at the end of the stage.", extraAt);
+		}
+		pending = (!reader.atEnd() && reader.peek() == '|'); // A | may end a line, the next stage being on the following one.
+		if (!reader.atEnd()) {
+			reader.next();
+		}
+	}
+	if (pending) {
+		reader.fail("Expected a stage after |.");
+	}
+	if (cells.empty()) {
+		reader.fail("Pipeline description has no stage.");
+	}
+	appendImported(std::move(cells), std::move(entryRecords), names);
+	return shared_from_this();
+}
+
+bool Systolic::CellArrayBuilder::savePipeline(const std::string &path) const
+{
+	Util::BinaryWriter writer;
+
+	for (const CellRecord &record : records) {
+		if (record.type == static_cast<std::uint8_t>(Systolic::Cell::Types::Custom) && record.name == anonymousName) {
+			throw std::invalid_argument("Cannot save a custom cell added without a registered name.");
+		}
+		if (record.type == nestedType) {
+			throw std::invalid_argument("Cannot save a nested container cell.");
+		}
+	}
+	writer.putBytes(pipelineMagic, sizeof(pipelineMagic));
+	writer.put(pipelineVersion);
+	writer.put(static_cast<std::uint64_t>(records.size()));
+	writer.put(static_cast<std::uint16_t>(customNames.size()));
+	for (const std::string &name : customNames) {
+		writer.putString(name);
+	}
+	writer.putBytes(records.data(), records.size() * sizeof(CellRecord));
+	return writer.commit(path);
+}
+
 std::vector<std::unique_ptr<Systolic::Cell::ICell>> Systolic::CellArrayBuilder::build()
 {
+	records.clear();
+	customNames.clear();
 	return std::move(cellArray);
 }
 
+std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> Systolic::CellArrayBuilder::buildTree()
+{
+	std::vector<std::unique_ptr<Systolic::Cell::ICell>> chain = build();
+	std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> levels;
+	std::vector<int> coefs; // Coefficients by increasing degree.
+	std::size_t width = 2;
+
+	for (auto it = chain.rbegin(); it != chain.rend(); it++) {
+		const Systolic::Cell::PolynomialCell *cell = dynamic_cast<const Systolic::Cell::PolynomialCell *>(it->get());
+
+		if (cell == nullptr) {
+			throw std::invalid_argument("Estrin's scheme tree can only be built from polynomial cells.");
+		}
+		coefs.push_back(cell->getCoef());
+	}
+	while (width < coefs.size()) {
+		width *= 2;
+	}
+	coefs.resize(width, 0);
+
+	/* Leaves are a(2i) + a(2i+1) * X, each upper level halves the number of nodes. */
+	levels.emplace_back();
+	for (std::size_t i = 0; i != width; i += 2) {
+		levels.back().push_back(std::make_unique<Systolic::Cell::MultiplyAddCell>(coefs[i], coefs[i + 1]));
+	}
+	for (std::size_t nodes = width / 4; nodes != 0; nodes /= 2) {
+		levels.emplace_back();
+		for (std::size_t i = 0; i != nodes; i++) {
+			levels.back().push_back(std::make_unique<Systolic::Cell::MultiplyAddCell>());
+		}
+	}
+	return levels;
+}
+
+std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> Systolic::CellArrayBuilder::buildWide()
+{
+	std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> cells;
+
+	if (polynomialMatrix.empty()) {
+		throw std::invalid_argument("Wide cells can only be built from a polynomial matrix.");
+	}
+	for (std::size_t k = 0; k != polynomialMatrix.front().size(); k++) { // Transposes the matrix, one cell per degree.
+		std::vector<int> coefs;
+
+		for (const std::vector<int> &row : polynomialMatrix) {
+			coefs.push_back(row[k]);
+		}
+		cells.push_back(std::make_unique<Systolic::Cell::WidePolynomialCell>(coefs));
+	}
+	polynomialMatrix.clear();
+	return cells;
+}
+
 /* Privates functions. */
 
+void Systolic::CellArrayBuilder::append(std::unique_ptr<Systolic::Cell::ICell> cell, const CellRecord &record)
+{
+	cellArray.push_back(std::move(cell));
+	records.push_back(record);
+}
+
+void Systolic::CellArrayBuilder::appendImported(std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells,
+						std::vector<CellRecord> entryRecords, const std::vector<std::string> &names)
+{
+	// Custom names are renumbered after the ones of the builder.
+	for (CellRecord &record : entryRecords) {
+		if (record.type == static_cast<std::uint8_t>(Systolic::Cell::Types::Custom)) {
+			auto it = std::find(customNames.begin(), customNames.end(), names[record.name]);
+
+			if (it == customNames.end()) {
+				if (customNames.size() == anonymousName) {
+					throw std::invalid_argument("Too many custom cell names.");
+				}
+				it = customNames.insert(customNames.end(), names[record.name]);
+			}
+			record.name = static_cast<std::uint16_t>(it - customNames.begin());
+		}
+	}
+	cellArray.reserve(cellArray.size() + cells.size());
+	for (std::size_t i = 0; i != cells.size(); i++) {
+		append(std::move(cells[i]), entryRecords[i]);
+	}
+}
+
 std::unique_ptr<Systolic::Cell::ICell>
 Systolic::CellArrayBuilder::getInstanceFromEnum(const Systolic::Cell::Types type, const int term)
 {
@@ -109,6 +630,10 @@ Systolic::CellArrayBuilder::getInstanceFromEnum(const Systolic::Cell::Types type
 		return std::make_unique<PowerCell>(term);
 	case Types::Polynomial:
 		return std::make_unique<PolynomialCell>(term);
+	case Types::Fir:
+		return std::make_unique<FirCell>(term);
+	case Types::DualPolynomial:
+		return std::make_unique<DualPolynomialCell>(term);
 	default:
 		throw std::runtime_error("Use of an unimplemented cell.");
 	}
@@ -0,0 +1,257 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Checkpointer.cpp
+ * Implementation of Checkpointer.
+ */
+
+#include "Systolic/Container/Checkpointer.hpp"
+
+#include "Util/BinaryFile.hpp"
+#include "Util/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+	const char checkpointMagic[4] = {'S', 'Y', 'C', 'K'}; /** First bytes of the checkpoint files. */
+
+	/* FNV-1a hash of the descriptions of the cells, telling whether a checkpoint was saved by the same chain. */
+	std::uint64_t fingerprintOf(const std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+
+		for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+			for (char c : cell->getCellDescription() + '\n') {
+				hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+}
+
+Systolic::Checkpointer::Checkpointer()
+	: steps(0), failures(0), outputLogSize(0), loggedOutputs{0, 0}
+{
+}
+
+bool Systolic::Checkpointer::save(const std::string &path, const std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells,
+				  const Systolic::CheckpointState &state, const Util::RingView<int> &outputs,
+				  const Util::RingView<int> &auxiliaryOutputs)
+{
+	const Util::RingView<int> *queues[2] = {&outputs, &auxiliaryOutputs};
+	const std::string log = path + ".out";
+	Util::BinaryWriter writer;
+	Util::BinaryWriter appended;
+	std::size_t logged[2] = {loggedOutputs[0], loggedOutputs[1]};
+
+	if (log != outputLog) { // A new log starts from the outputs still in the queues.
+		logged[0] = state.taken[0];
+		logged[1] = state.taken[1];
+	}
+
+	const std::uint64_t logStart = (log != outputLog ? 0 : outputLogSize);
+
+	writer.putBytes(checkpointMagic, sizeof(checkpointMagic));
+	writer.put(version);
+	writer.put(static_cast<std::uint64_t>(cells.size()));
+	writer.put(fingerprintOf(cells));
+	writer.put(state.tick);
+	writer.put(state.consumed);
+	writer.put(state.total);
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		const std::vector<std::optional<int>> registers = cell->getRegisters();
+
+		writer.put(static_cast<std::uint8_t>(registers.size()));
+		for (const std::optional<int> &value : registers) { // Presence flag, then the value if any.
+			writer.put(static_cast<std::uint8_t>(value.has_value()));
+			if (value.has_value()) {
+				writer.put(value.value());
+			}
+		}
+	}
+
+	// Only the outputs not logged yet are appended, preceded by the index of the first one and their count.
+	for (std::size_t q = 0; q != 2; q++) {
+		const Util::RingView<int> &view = *queues[q];
+		const std::size_t taken = static_cast<std::size_t>(state.taken[q]);
+		const std::size_t from = std::max(logged[q], taken) - taken;
+
+		writer.put(static_cast<std::uint64_t>(taken));
+		writer.put(static_cast<std::uint64_t>(taken + view.size()));
+		appended.put(static_cast<std::uint64_t>(taken + from));
+		appended.put(static_cast<std::uint64_t>(view.size() - from));
+		if (from < view.getFirstSize()) {
+			appended.putBytes(view.getFirstSegment() + from, (view.getFirstSize() - from) * sizeof(int));
+			appended.putBytes(view.getSecondSegment(), view.getSecondSize() * sizeof(int));
+		} else {
+			appended.putBytes(view.getSecondSegment() + (from - view.getFirstSize()), (view.size() - from) * sizeof(int));
+		}
+		logged[q] = taken + view.size();
+	}
+	writer.put(static_cast<std::uint64_t>(logStart + appended.getSize()));
+
+	// The log is written first, the bytes appended only counting once the checkpoint recording them is.
+	if (!appended.writeAt(log, logStart) || !writer.commit(path)) {
+		return false;
+	}
+	outputLog = log;
+	outputLogSize = logStart + appended.getSize();
+	loggedOutputs[0] = logged[0];
+	loggedOutputs[1] = logged[1];
+	return true;
+}
+
+bool Systolic::Checkpointer::load(const std::string &path, const std::vector<std::unique_ptr<Systolic::Cell::ICell>> &cells,
+				  const std::uint64_t consumed, const std::uint64_t total, Systolic::CheckpointState &state)
+{
+	Util::MappedFile file(path);
+
+	if (!file.isOpen()) {
+		std::cerr << "Err: Cannot open checkpoint " << path << "." << std::endl;
+		return false;
+	}
+	try {
+		Util::BinaryReader reader(file.getData(), file.getSize());
+
+		if (std::memcmp(reader.skip(sizeof(checkpointMagic)), checkpointMagic, sizeof(checkpointMagic)) != 0
+		    || reader.get<std::uint32_t>() != version) {
+			std::cerr << "Err: " << path << " is not a checkpoint of this version." << std::endl;
+			return false;
+		}
+		if (reader.get<std::uint64_t>() != cells.size() || reader.get<std::uint64_t>() != fingerprintOf(cells)) {
+			std::cerr << "Err: Checkpoint " << path << " was saved by other cells." << std::endl;
+			return false;
+		}
+
+		Systolic::CheckpointState saved;
+		std::uint64_t produced[2];
+
+		saved.tick = reader.get<std::uint64_t>();
+		saved.consumed = reader.get<std::uint64_t>();
+		saved.total = reader.get<std::uint64_t>();
+		if (saved.total != total || saved.consumed < consumed || saved.consumed > saved.total) {
+			std::cerr << "Err: Checkpoint " << path << " was saved at input " << saved.consumed << " of " << saved.total
+				  << ", while the container read " << consumed << " of " << total << "." << std::endl;
+			return false;
+		}
+		saved.registers.resize(cells.size());
+		for (std::size_t i = 0; i != cells.size(); i++) {
+			const std::uint8_t count = reader.get<std::uint8_t>();
+
+			if (count != cells[i]->getRegisters().size()) {
+				std::cerr << "Err: Checkpoint " << path << " has " << +count << " registers for cell " << i << "." << std::endl;
+				return false;
+			}
+			for (std::uint8_t r = 0; r != count; r++) {
+				saved.registers[i].push_back(reader.get<std::uint8_t>() != 0 ? std::optional<int>(reader.get<int>()) : std::nullopt);
+			}
+		}
+		for (std::size_t q = 0; q != 2; q++) {
+			saved.taken[q] = reader.get<std::uint64_t>();
+			produced[q] = reader.get<std::uint64_t>();
+			if (produced[q] < saved.taken[q]) {
+				throw std::runtime_error("Corrupted file.");
+			}
+			saved.outputs[q].resize(produced[q] - saved.taken[q]);
+		}
+
+		// The log holds chunks of outputs, later ones holding the outputs updated since, the checkpoint covering its first bytes.
+		const std::uint64_t logSize = reader.get<std::uint64_t>();
+		const std::string log = path + ".out";
+		Util::MappedFile logFile(log);
+
+		if (logSize != 0 && (!logFile.isOpen() || logFile.getSize() < logSize)) {
+			std::cerr << "Err: Checkpoint " << path << " misses outputs from " << log << "." << std::endl;
+			return false;
+		}
+
+		Util::BinaryReader chunks(logFile.getData(), logSize);
+
+		while (chunks.getRemaining() != 0) {
+			for (std::size_t q = 0; q != 2; q++) {
+				const std::uint64_t first = chunks.get<std::uint64_t>();
+				const std::uint64_t count = chunks.get<std::uint64_t>();
+
+				if (count > chunks.getRemaining() / sizeof(int)) {
+					throw std::runtime_error("Truncated file.");
+				}
+
+				const unsigned char *values = chunks.skip(count * sizeof(int));
+				const std::uint64_t begin = std::max(first, saved.taken[q]);
+				const std::uint64_t end = std::min(first + count, produced[q]);
+
+				if (begin < end) {
+					std::memcpy(saved.outputs[q].data() + (begin - saved.taken[q]), values + (begin - first) * sizeof(int),
+						    (end - begin) * sizeof(int));
+				}
+			}
+		}
+		state = std::move(saved);
+		outputLog = log;
+		outputLogSize = logSize;
+		loggedOutputs[0] = produced[0];
+		loggedOutputs[1] = produced[1];
+	} catch (const std::runtime_error &e) {
+		std::cerr << "Err: Cannot read checkpoint " << path << ": " << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void Systolic::Checkpointer::rewind(const std::size_t first)
+{
+	loggedOutputs[0] = std::min(loggedOutputs[0], first);
+}
+
+void Systolic::Checkpointer::setPeriodic(const std::string &path, const std::size_t steps)
+{
+	if (!path.empty() && steps == 0) {
+		throw std::invalid_argument("Checkpoints must be at least one step apart.");
+	}
+	this->path = path;
+	this->steps = steps;
+	failures = 0;
+}
+
+const std::string &Systolic::Checkpointer::getPath() const
+{
+	return path;
+}
+
+bool Systolic::Checkpointer::isDue(const std::size_t steps, const bool cancelled) const
+{
+	return !path.empty() && (cancelled || steps % this->steps == 0);
+}
+
+void Systolic::Checkpointer::addFailure()
+{
+	// A checkpoint not saved leaves the previous one in place, from which a run can still resume.
+	failures++;
+	std::cerr << "Warn: Checkpoint " << path << " could not be saved, the previous one being kept." << std::endl;
+}
+
+std::size_t Systolic::Checkpointer::getFailures() const
+{
+	return failures;
+}
@@ -24,23 +24,80 @@
 
 #include "Systolic/Container/Container.hpp"
 
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+	std::atomic<std::uint64_t> nextPipelineId(0); /** Id of the next pipeline, shared by every container. */
+
+#ifndef NDEBUG
+	/* Checksum of borrowed inputs, telling whether their memory changed. */
+	std::size_t checksumOf(const int *values, const std::size_t count)
+	{
+		return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char *>(values), count * sizeof(int)));
+	}
+#endif
+}
+
+double Systolic::ContainerStats::getHitRate() const
+{
+	return (inputs != 0 ? static_cast<double>(inputs - evaluated) / inputs : 0);
+}
+
+Systolic::CancellationToken::CancellationToken()
+	: cancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+void Systolic::CancellationToken::cancel()
+{
+	cancelled->store(true);
+}
+
+bool Systolic::CancellationToken::isCancelled() const
+{
+	return cancelled->load();
+}
+
+Systolic::Container::Container()
+	: borrowedEntries(nullptr), borrowedCount(0), borrowedChecksum(0), consumed(0), tick(0), takenOutputs(0), takenAuxiliary(0),
+	  incremental(false), cachedFirst(0), pipelineId(nextPipelineId++), stats{0, 0}
+{
+}
+
 Systolic::Container::Container(const int entries, ...)
+	: Container()
 {
 	va_list args;
 
 	va_start(args, entries);
+	inputs.reserve(entries);
 	for (int i = 0; i != entries; i++) {
 		inputs.push(va_arg(args, int));
 	}
+	va_end(args);
+}
+
+Systolic::Container::Container(std::queue<int> entries)
+	: Container()
+{
+	inputs.reserve(entries.size());
+	for (; !entries.empty(); entries.pop()) {
+		inputs.push(entries.front());
+	}
 }
 
-Systolic::Container::Container(const std::queue<int> entries)
+Systolic::Container::Container(const int *entries, const std::size_t count)
+	: Container()
 {
-	inputs = entries;
+	setInputs(entries, count);
 }
 
 Systolic::Container::Container(const std::initializer_list<const int> entries)
+	: Container()
 {
+	inputs.reserve(entries.size());
 	for (int entry : entries) {
 		inputs.push(entry);
 	}
@@ -62,6 +119,8 @@ void Systolic::Container::addCell(std::unique_ptr<Systolic::Cell::ICell> cell) /
 void Systolic::Container::setCells(std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells)
 {
 	this->cells = std::move(cells);
+	setIncremental(incremental); // Kept results belong to the previous cells.
+	pipelineId = nextPipelineId++;
 }
 
 void Systolic::Container::setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder)
@@ -69,7 +128,26 @@ void Systolic::Container::setCells(std::shared_ptr<Systolic::CellArrayBuilder> b
 	if (builder == nullptr) {
 		throw std::invalid_argument("Builder is NULL.");
 	}
-	this->cells = builder->build();
+	setCells(builder->build());
+}
+
+void Systolic::Container::setInputs(const int *entries, const std::size_t count)
+{
+	if (entries == nullptr && count != 0) {
+		throw std::invalid_argument("Inputs are NULL.");
+	}
+	inputs.borrow(entries, count);
+	borrowedEntries = entries;
+	borrowedCount = count;
+	consumed = 0;
+#ifndef NDEBUG
+	borrowedChecksum = checksumOf(entries, count);
+#endif
+}
+
+void Systolic::Container::setTrace(std::shared_ptr<Systolic::Trace> trace)
+{
+	this->trace = trace;
 }
 
 void Systolic::Container::step()
@@ -79,80 +157,337 @@ void Systolic::Container::step()
 		return;
 	}
 
+	const double stepStart = (trace != nullptr ? trace->now() : 0);
+
 	// Feeds the first cell with a value from the inputs queue.
 	if (!inputs.empty()) {
+		if (trace != nullptr) {
+			trace->instant("cells", 0, "inject", stepStart, {{"value", inputs.front()}, {"tick", tick}});
+		}
 		cells.at(0)->feed(std::make_tuple(std::nullopt, inputs.front()));
 		inputs.pop();
+		consumed++;
 	} else {
 		cells.at(0)->feed(std::make_tuple(std::nullopt, std::nullopt)); // Feeds empty value.
 	}
+	cells.at(0)->feedAuxiliary(std::nullopt);
 
 	// Feed all other cells with the partials (results) of the previous cell.
 	for(std::size_t i = 1; i < cells.size(); i++) {
 		cells.at(i)->feed(cells.at(i - 1)->getPartial());
+		cells.at(i)->feedAuxiliary(cells.at(i - 1)->getAuxiliary());
+	}
+	if (trace != nullptr) {
+		long long active = 0;
+
+		for (std::size_t i = 0; i != cells.size(); i++) {
+			trace->nameLane("cells", i, "cell " + std::to_string(i) + ": " + cells.at(i)->getCellDescription());
+			active += std::get<1>(cells.at(i)->getInputs()).has_value();
+		}
+		trace->counter("active cells", stepStart, {{"active", active}, {"idle", cells.size() - active}});
+		trace->counter("queue depth", stepStart, {{"inputs", inputs.size()}, {"outputs", outputs.size()}});
 	}
 
 	// Compute the current value of each cells.
-	std::queue<std::future<std::tuple<std::optional<int>, std::optional<int>>>> futures;
-
-	for (std::size_t i = 0; i != cells.size(); i++) {
-		/* 
-		 * Each computation is started in its own thread.
-		 * std::async returns a std::future to access the thread's return
-		 * value (or exception).
-		 * This way, larger computation can be started without preventing the
-		 * start of other computations.
-		 */
-		futures.push(std::async(std::launch::async, [this, j = i]{ return cells.at(j)->compute(); }));
-	}
+	std::vector<std::tuple<std::optional<int>, std::optional<int>>> partials(cells.size());
+
+	/*
+	 * The cells are spread over the scheduler shared by every container,
+	 * so that running many containers does not start more threads than
+	 * the hardware has cores.
+	 */
+	Systolic::Backend::Scheduler::getInstance().parallelFor(cells.size(), [this, &partials](const std::size_t j){
+			if (trace == nullptr) {
+				partials[j] = cells.at(j)->compute();
+				return;
+			}
+
+			const double start = trace->now();
+			partials[j] = cells.at(j)->compute();
+			const double end = trace->now();
+			const bool busy = std::get<1>(cells.at(j)->getInputs()).has_value();
+
+			trace->span("cells", j, (busy ? "compute" : "idle"), start, end, {{"tick", tick}});
+			trace->span("threads", trace->getThreadLane(), "cell " + std::to_string(j), start, end,
+				    {{"tick", tick}});
+		});
 
 	// Add the last cell partial (final result) to the output queue if available.
-	std::optional<int> lastCellOutput = std::get<0>(futures.back().get());
+	std::optional<int> lastCellOutput = std::get<0>(partials.back());
 
 	if (lastCellOutput.has_value()) {
 		outputs.push(lastCellOutput.value());
 	}
 
-	// Wait for each computation to be completed.
-	while (futures.size() != 1) { // Last handle have been used by lastCellOutput.
-		futures.front().wait();
-		futures.pop();
+	// Along with its auxiliary value, if any.
+	if (lastCellOutput.has_value() && cells.back()->hasAuxiliary()) {
+		auxiliaryOutputs.push(cells.back()->getAuxiliary().value());
+	}
+	if (trace != nullptr) {
+		const double stepEnd = trace->now();
+
+		if (lastCellOutput.has_value()) {
+			trace->instant("cells", cells.size() - 1, "output", stepEnd,
+				       {{"value", lastCellOutput.value()}, {"tick", tick}});
+		}
+		trace->nameLane("container", 0, "steps");
+		trace->span("container", 0, "step " + std::to_string(tick), stepStart, stepEnd, {{"tick", tick}});
 	}
+	tick++;
 }
 
 void Systolic::Container::compute()
 {
-	std::size_t ioSize = inputs.size();
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (inputs.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	checkBorrowedInputs();
+	runSteps(nullptr, CancellationToken());
+}
+
+std::future<bool> Systolic::Container::computeAsync(Systolic::ProgressCallback progress, Systolic::CancellationToken token,
+						    const std::size_t tileSize)
+{
+	std::shared_ptr<std::promise<bool>> promise = std::make_shared<std::promise<bool>>();
+	std::future<bool> future = promise->get_future();
+
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		promise->set_value(false);
+		return future;
+	}
+	if (inputs.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		promise->set_value(false);
+		return future;
+	}
+	checkBorrowedInputs();
+	Systolic::Backend::Scheduler::getInstance().submit([this, promise, progress, token, tileSize]{
+			try {
+				promise->set_value(tileSize == 0 ? runSteps(progress, token) : runTiles(progress, token, tileSize));
+			} catch (...) {
+				promise->set_exception(std::current_exception());
+			}
+		});
+	return future;
+}
+
+void Systolic::Container::computeBatch()
+{
+	std::vector<int> results;
+	Systolic::BatchBackend backend = Systolic::BatchBackend::Cells;
 
 	if (cells.size() == 0) {
 		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
 		return;
 	}
-	if (ioSize == 0) {
+	if (inputs.empty()) {
 		std::cerr << "Err: No inputs available." << std::endl;
 		return;
 	}
-	do {
-		logs.push_back(makeLogEntry());
-		step();
-	} while (outputs.size() != ioSize);
-	logs.push_back(makeLogEntry());
+	checkBorrowedInputs();
+	flushInFlight();
+
+	// Borrowed inputs are read in place, without being copied.
+	const Util::RingView<int> xs = inputs.view();
+	const std::size_t count = xs.size();
+	const double batchStart = (trace != nullptr ? trace->now() : 0);
+
+	results = evaluateInputs(xs, backend);
+	outputs.reserve(outputs.size() + results.size());
+	for (int output : results) {
+		outputs.push(output);
+	}
+	if (incremental && backend == Systolic::BatchBackend::Polynomial) {
+		cachedInputs = xs.toVector();
+		cachedOutputs.assign(results.begin(), results.end());
+		cachedFirst = takenOutputs + outputs.size() - results.size();
+		cachedPowers.clear();
+	}
+	inputs.clear();
+	consumed += count;
+	if (trace != nullptr) {
+		trace->nameLane("container", 0, "steps");
+		trace->span("container", 0, std::string("computeBatch: ") + Systolic::BatchEvaluator::getBackendName(backend), batchStart, trace->now(), {{"inputs", count}});
+	}
 }
 
-void Systolic::Container::dumpOutputs() const
+void Systolic::Container::setIncremental(const bool incremental)
+{
+	this->incremental = incremental;
+	cachedInputs.clear();
+	cachedOutputs.clear();
+	cachedPowers.clear();
+}
+
+void Systolic::Container::setCoef(const std::size_t index, const int coef)
+{
+	Systolic::Cell::PolynomialCell *cell = (index < cells.size()
+						? dynamic_cast<Systolic::Cell::PolynomialCell *>(cells[index].get()) : nullptr);
+
+	if (cell == nullptr) {
+		throw std::invalid_argument("No polynomial cell at index " + std::to_string(index) + ".");
+	}
+
+	// Unsigned arithmetic, as to wrap around as PolynomialCell does.
+	const std::uint32_t delta = static_cast<std::uint32_t>(coef) - static_cast<std::uint32_t>(cell->getCoef());
+	const std::size_t exponent = cells.size() - 1 - index;
+
+	cell->setCoef(coef);
+	pipelineId = nextPipelineId++; // Cached results belong to the previous coefficient.
+	if (cachedInputs.empty()) {
+		return;
+	}
+
+	std::vector<std::uint32_t> &powers = cachedPowers[exponent];
+
+	if (powers.empty()) {
+		for (int x : cachedInputs) { // Exponentiation by squaring.
+			std::uint32_t base = static_cast<std::uint32_t>(x);
+			std::uint32_t power = 1;
+
+			for (std::size_t e = exponent; e != 0; e >>= 1) {
+				if (e & 1) {
+					power *= base;
+				}
+				base *= base;
+			}
+			powers.push_back(power);
+		}
+	}
+	// Only the outputs of the kept batch still in the queue are updated, in place, the next checkpoint logging them again.
+	checkpoints.rewind(cachedFirst);
+	for (std::size_t i = 0; i != cachedOutputs.size(); i++) {
+		cachedOutputs[i] += delta * powers[i];
+		if (cachedFirst + i >= takenOutputs && cachedFirst + i - takenOutputs < outputs.size()) {
+			outputs.set(cachedFirst + i - takenOutputs, static_cast<int>(cachedOutputs[i]));
+		}
+	}
+}
+
+void Systolic::Container::setCache(std::shared_ptr<Systolic::ResultCache> cache)
+{
+	this->cache = cache;
+}
+
+std::uint64_t Systolic::Container::getPipelineId() const
+{
+	return pipelineId;
+}
+
+Systolic::ContainerStats Systolic::Container::getStats() const
+{
+	return stats;
+}
+
+std::vector<Systolic::CellCost> Systolic::Container::getCellCosts(const Systolic::CostModel &model) const
+{
+	std::vector<Systolic::CellCost> costs;
+
+	costs.reserve(cells.size());
+	for (const std::unique_ptr<Systolic::Cell::ICell> &cell : cells) {
+		costs.push_back(model.getCellCost(*cell));
+	}
+	return costs;
+}
+
+Systolic::CostReport Systolic::Container::estimateCost(const Systolic::CostModel &model) const
+{
+	return model.estimate(getCellCosts(model), inputs.size());
+}
+
+bool Systolic::Container::saveCheckpoint(const std::string &path) const
+{
+	const Systolic::CheckpointState state{tick, consumed, consumed + inputs.size(), {takenOutputs, takenAuxiliary}, {}, {}};
+
+	return checkpoints.save(path, cells, state, outputs.view(), auxiliaryOutputs.view());
+}
+
+bool Systolic::Container::loadCheckpoint(const std::string &path)
 {
-	std::queue<int> copy = outputs;
+	Systolic::CheckpointState state;
 
-	while (!copy.empty()) {
-		std::cout << copy.front() << (copy.size() > 1 ? "," : "");
-		copy.pop();
+	if (!checkpoints.load(path, cells, consumed, consumed + inputs.size(), state)) {
+		return false;
 	}
-	std::cout << std::endl;
+	inputs.pop(static_cast<std::size_t>(state.consumed - consumed));
+	consumed = static_cast<std::size_t>(state.consumed);
+	tick = static_cast<std::size_t>(state.tick);
+	for (std::size_t i = 0; i != cells.size(); i++) {
+		cells[i]->setRegisters(state.registers[i]);
+	}
+	outputs.clear();
+	auxiliaryOutputs.clear();
+	cachedInputs.clear(); // The kept batch does not match the restored outputs.
+	cachedOutputs.clear();
+	cachedPowers.clear();
+	outputs.reserve(state.outputs[0].size() + inputs.size());
+	for (int output : state.outputs[0]) {
+		outputs.push(output);
+	}
+	for (int output : state.outputs[1]) {
+		auxiliaryOutputs.push(output);
+	}
+	takenOutputs = static_cast<std::size_t>(state.taken[0]);
+	takenAuxiliary = static_cast<std::size_t>(state.taken[1]);
+	return true;
+}
+
+void Systolic::Container::setCheckpoints(const std::string &path, const std::size_t steps)
+{
+	checkpoints.setPeriodic(path, steps);
+}
+
+std::size_t Systolic::Container::getCheckpointFailures() const
+{
+	return checkpoints.getFailures();
+}
+
+void Systolic::Container::dumpOutputs() const
+{
+	Util::OutputWriter(Util::OutputFormat::Comma).write(outputs.view());
 }
 
 std::queue<int> Systolic::Container::getOutputs() const
 {
-	return outputs;
+	return outputs.toQueue();
+}
+
+Util::RingView<int> Systolic::Container::getOutputView() const
+{
+	return outputs.view();
+}
+
+std::queue<int> Systolic::Container::getAuxiliaryOutputs() const
+{
+	return auxiliaryOutputs.toQueue();
+}
+
+Util::RingView<int> Systolic::Container::getAuxiliaryOutputView() const
+{
+	return auxiliaryOutputs.view();
+}
+
+std::vector<int> Systolic::Container::takeOutputs()
+{
+	std::vector<int> taken = outputs.view().toVector();
+
+	takenOutputs += outputs.size();
+	takenAuxiliary += auxiliaryOutputs.size();
+	outputs.clear();
+	auxiliaryOutputs.clear();
+	return taken;
+}
+
+std::vector<int> Systolic::Container::takeOutputs(std::vector<int> &auxiliary)
+{
+	auxiliary = auxiliaryOutputs.view().toVector();
+	return takeOutputs();
 }
 
 std::string Systolic::Container::getCurrentStateLog() const
@@ -170,6 +505,167 @@ std::string Systolic::Container::getLog() const
 	return ss.str();
 }
 
+/* Privates functions. */
+
+bool Systolic::Container::runSteps(const Systolic::ProgressCallback &progress, const Systolic::CancellationToken &token)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const std::size_t first = outputs.size();
+	const std::size_t total = inputs.size() + getInFlight(); // Values in flight, as after loadCheckpoint, are outputs to come.
+	std::size_t reported = first;
+	std::size_t steps = 0;
+	auto report = [&]{
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		reportProgress(progress, {steps, outputs.size() - first, total, seconds, 0}, reported);
+	};
+
+	outputs.reserve(first + total);
+	do {
+		if (token.isCancelled()) {
+			report();
+			saveCheckpointIfDue(steps, true);
+			return false;
+		}
+		logs.push_back(makeLogEntry());
+		step();
+		if (++steps % progressTicks == 0) {
+			report();
+		}
+		saveCheckpointIfDue(steps, false);
+	} while (outputs.size() - first != total);
+	logs.push_back(makeLogEntry());
+	report();
+	return true;
+}
+
+bool Systolic::Container::runTiles(const Systolic::ProgressCallback &progress, const Systolic::CancellationToken &token,
+				   const std::size_t tileSize)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const std::size_t first = outputs.size();
+	const std::size_t total = inputs.size();
+	std::size_t reported = first;
+	std::size_t steps = 0;
+	std::vector<int> xs; // Inputs and outputs of every tile, kept for setCoef in incremental mode.
+	std::vector<int> results;
+	Systolic::BatchBackend backend = Systolic::BatchBackend::Cells;
+	auto report = [&]{
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		reportProgress(progress, {steps, outputs.size() - first, total, seconds, 0}, reported);
+	};
+
+	outputs.reserve(first + total);
+	flushInFlight();
+	for (; !inputs.empty(); steps++) {
+		if (token.isCancelled()) {
+			report();
+			saveCheckpointIfDue(steps, true);
+			return false;
+		}
+
+		// Each tile is a view over the first segment of the inputs, borrowed ones included.
+		const double tileStart = (trace != nullptr ? trace->now() : 0);
+		const Util::RingView<int> pending = inputs.view();
+		const Util::RingView<int> tile(pending.getFirstSegment(), std::min(tileSize, pending.getFirstSize()));
+		const std::vector<int> tileResults = evaluateInputs(tile, backend);
+
+		for (int output : tileResults) {
+			outputs.push(output);
+		}
+		if (incremental) {
+			xs.insert(xs.end(), tile.begin(), tile.end());
+			results.insert(results.end(), tileResults.begin(), tileResults.end());
+		}
+		if (trace != nullptr) {
+			trace->nameLane("container", 0, "steps");
+			trace->span("container", 0, std::string("computeAsync: ") + Systolic::BatchEvaluator::getBackendName(backend), tileStart, trace->now(),
+				    {{"inputs", tile.size()}, {"tile", steps}});
+		}
+		inputs.pop(tile.size());
+		consumed += tile.size();
+		report();
+		saveCheckpointIfDue(steps + 1, false);
+	}
+	if (incremental && backend == Systolic::BatchBackend::Polynomial) {
+		cachedInputs = xs;
+		cachedOutputs.assign(results.begin(), results.end());
+		cachedFirst = takenOutputs + outputs.size() - results.size();
+		cachedPowers.clear();
+	}
+	return true;
+}
+
+void Systolic::Container::checkBorrowedInputs() const
+{
+#ifndef NDEBUG
+	if (borrowedEntries != nullptr && inputs.isBorrowed() && checksumOf(borrowedEntries, borrowedCount) != borrowedChecksum) {
+		throw std::logic_error("Inputs borrowed by the container changed before going through.");
+	}
+#endif
+}
+
+std::size_t Systolic::Container::getInFlight() const
+{
+	std::size_t inFlight = 0;
+
+	// Between two steps, each value not output yet is the partial of one of the cells but the last.
+	for (std::size_t i = 0; i + 1 < cells.size(); i++) {
+		inFlight += std::get<0>(cells[i]->getPartial()).has_value();
+	}
+	return inFlight;
+}
+
+void Systolic::Container::flushInFlight()
+{
+	Util::RingBuffer<int> pending;
+
+	// The values in flight, as left by steps before a checkpoint, go out before any batch, through steps without inputs.
+	std::swap(inputs, pending);
+	while (getInFlight() != 0) {
+		step();
+	}
+	std::swap(inputs, pending);
+}
+
+void Systolic::Container::saveCheckpointIfDue(const std::size_t steps, const bool cancelled) const
+{
+	if (checkpoints.isDue(steps, cancelled) && !saveCheckpoint(checkpoints.getPath())) {
+		checkpoints.addFailure();
+	}
+}
+
+void Systolic::Container::reportProgress(const Systolic::ProgressCallback &progress, const Systolic::ComputeProgress &done,
+					 std::size_t &reported) const
+{
+	if (progress == nullptr) {
+		return;
+	}
+
+	Systolic::ComputeProgress current = done;
+	std::vector<int> produced;
+	const Util::RingView<int> view = outputs.view();
+
+	// Remaining outputs at the throughput measured so far.
+	current.eta = (current.outputs != 0 ? (current.total - current.outputs) * current.seconds / current.outputs : -1);
+	for (; reported < view.size(); reported++) {
+		produced.push_back(view[reported]);
+	}
+	progress(current, produced);
+}
+
+std::vector<int> Systolic::Container::evaluateInputs(const Util::RingView<int> &xs, Systolic::BatchBackend &backend)
+{
+	Systolic::BatchEvaluator evaluator(cells, auxiliaryOutputs);
+	const std::vector<int> results = evaluator.evaluate(xs, cache.get(), pipelineId);
+
+	backend = evaluator.getBackend();
+	stats.evaluated += evaluator.getEvaluated();
+	stats.inputs += xs.size();
+	return results;
+}
+
 std::string Systolic::Container::makeLogEntry() const
 {
 	std::stringstream ss;
@@ -185,9 +681,7 @@ std::string Systolic::Container::makeLogEntry() const
 
 	/* Displaying remaning values waiting in the input queue. */
 	ss << "inputs: ";
-	for (std::queue<int> iCopy = inputs; iCopy.size() > 0; iCopy.pop()) {
-		ss << iCopy.front() << (iCopy.size() != 1 ? ", " : "");
-	}
+	writeValues(ss, inputs.view());
 	ss << std::endl << std::endl;
 	
 	/* Displaying the inputs of the cells on the left side and its partials on the right. */
@@ -211,14 +705,19 @@ std::string Systolic::Container::makeLogEntry() const
 	ss << "outputs: ";
 	
 	/* Displaying the values stored in the outputs queue. */
-	for (std::queue<int> oCopy = outputs; oCopy.size() > 0; oCopy.pop()) {
-		ss << oCopy.front() << (oCopy.size() != 1 ? ", " : "");
-	}
+	writeValues(ss, outputs.view());
 	ss << std::endl;
 	
 	return ss.str();
 }
 
+void Systolic::Container::writeValues(std::stringstream &ss, const Util::RingView<int> &values) const
+{
+	for (std::size_t i = 0; i != values.size(); i++) {
+		ss << values[i] << (i + 1 != values.size() ? ", " : "");
+	}
+}
+
 std::string Systolic::Container::optionalToString(std::optional<int> value) const
 {
 	if (value.has_value()) {
@@ -0,0 +1,224 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file CostModel.cpp
+ * Implementation of CostModel.
+ */
+
+#include "Systolic/Container/CostModel.hpp"
+
+#include "Systolic/Cell/ContainerCell.hpp"
+#include "Systolic/Cell/ModularPolynomialCell.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+	/**
+	 * Types of the cells, by the name the pipeline descriptions give them.
+	 */
+	const std::unordered_map<std::string, Systolic::Cell::Types> typeNames = {
+		{"add", Systolic::Cell::Types::Addition},
+		{"mul", Systolic::Cell::Types::Multiplication},
+		{"div", Systolic::Cell::Types::Division},
+		{"square", Systolic::Cell::Types::Square},
+		{"pow", Systolic::Cell::Types::Power},
+		{"poly", Systolic::Cell::Types::Polynomial},
+		{"custom", Systolic::Cell::Types::Custom},
+		{"fir", Systolic::Cell::Types::Fir},
+		{"dual", Systolic::Cell::Types::DualPolynomial},
+	};
+
+	/**
+	 * Types of the cells, by their class.
+	 */
+	const std::unordered_map<std::type_index, Systolic::Cell::Types> typeClasses = {
+		{typeid(Systolic::Cell::AdditiveCell), Systolic::Cell::Types::Addition},
+		{typeid(Systolic::Cell::MultiplicativeCell), Systolic::Cell::Types::Multiplication},
+		{typeid(Systolic::Cell::DivisionCell), Systolic::Cell::Types::Division},
+		{typeid(Systolic::Cell::SquareCell), Systolic::Cell::Types::Square},
+		{typeid(Systolic::Cell::PowerCell), Systolic::Cell::Types::Power},
+		{typeid(Systolic::Cell::PolynomialCell), Systolic::Cell::Types::Polynomial},
+		{typeid(Systolic::Cell::CustomCell), Systolic::Cell::Types::Custom},
+		{typeid(Systolic::Cell::FirCell), Systolic::Cell::Types::Fir},
+		{typeid(Systolic::Cell::DualPolynomialCell), Systolic::Cell::Types::DualPolynomial},
+	};
+
+	/**
+	 * Read a positive number of cycles of an entry of a cost model description.
+	 * @throws std::invalid_argument If the text is not a positive integer.
+	 */
+	std::size_t parseCycles(const std::string &text, const std::string &entry)
+	{
+		if (text.empty() || text.size() > 9 || !std::all_of(text.begin(), text.end(), [](const char c) { return c >= '0' && c <= '9'; })
+		    || std::stoul(text) == 0) {
+			throw std::invalid_argument("Cost model entry \"" + entry + "\" needs a positive number of cycles.");
+		}
+		return std::stoul(text);
+	}
+}
+
+std::string Systolic::CostReport::getSummary(const std::size_t shown) const
+{
+	std::stringstream ss;
+
+	ss << "inputs: " << inputs << std::endl
+	   << "cycles: " << cycles << std::endl
+	   << "latency: " << latency << " cycles" << std::endl
+	   << "throughput: " << throughput << " X per cycle" << std::endl
+	   << "utilization: " << utilization << std::endl
+	   << "bottlenecks: " << bottlenecks.size() << " of " << cellUtilization.size() << " cells";
+	for (std::size_t i = 0; i != std::min(shown, bottlenecks.size()); i++) {
+		ss << (i == 0 ? " (" : ", ") << bottlenecks[i];
+	}
+	if (shown != 0 && !bottlenecks.empty()) {
+		ss << (bottlenecks.size() > shown ? ", …)" : ")");
+	}
+	ss << std::endl;
+	return ss.str();
+}
+
+Systolic::CostModel::CostModel()
+	: modular{1, 1}
+{
+	costs.fill({1, 1});
+}
+
+Systolic::CostModel Systolic::CostModel::fromDescription(const std::string &description)
+{
+	CostModel model;
+	std::stringstream entries(description);
+
+	for (std::string entry; std::getline(entries, entry, ',');) {
+		entry.erase(std::remove_if(entry.begin(), entry.end(), [](const char c) { return c == ' ' || c == '\t'; }), entry.end());
+
+		const std::size_t equal = entry.find('=');
+		const std::size_t slash = entry.find('/');
+
+		if (entry.empty()) {
+			continue;
+		}
+		if (equal == std::string::npos || (slash != std::string::npos && slash < equal)) {
+			throw std::invalid_argument("Cost model entry \"" + entry + "\" must be written type=latency[/interval].");
+		}
+
+		const std::string name = entry.substr(0, equal);
+		const std::size_t latency = parseCycles(entry.substr(equal + 1, slash == std::string::npos ? std::string::npos : slash - equal - 1), entry);
+		const std::size_t interval = (slash == std::string::npos ? latency : parseCycles(entry.substr(slash + 1), entry));
+
+		if (name == "mod") {
+			model.setModularCost({latency, interval});
+		} else if (typeNames.count(name) != 0) {
+			model.setCost(typeNames.at(name), {latency, interval});
+		} else {
+			throw std::invalid_argument("Cost model entry \"" + entry + "\" names no type of cell.");
+		}
+	}
+	return model;
+}
+
+void Systolic::CostModel::setCost(const Systolic::Cell::Types type, const Systolic::CellCost cost)
+{
+	checkCost(cost);
+	costs[static_cast<std::size_t>(type)] = cost;
+}
+
+Systolic::CellCost Systolic::CostModel::getCost(const Systolic::Cell::Types type) const
+{
+	return costs[static_cast<std::size_t>(type)];
+}
+
+void Systolic::CostModel::setModularCost(const Systolic::CellCost cost)
+{
+	checkCost(cost);
+	modular = cost;
+}
+
+Systolic::CellCost Systolic::CostModel::getModularCost() const
+{
+	return modular;
+}
+
+Systolic::CellCost Systolic::CostModel::getCellCost(const Systolic::Cell::ICell &cell) const
+{
+	const auto type = typeClasses.find(typeid(cell));
+
+	if (type != typeClasses.end()) {
+		return getCost(type->second);
+	}
+	if (typeid(cell) == typeid(Systolic::Cell::ModularPolynomialCell)) {
+		return modular;
+	}
+
+	const Systolic::Cell::ContainerCell *nested = dynamic_cast<const Systolic::Cell::ContainerCell *>(&cell);
+
+	if (nested != nullptr) {
+		return nested->getCost(*this);
+	}
+	return getCost(Systolic::Cell::Types::Custom);
+}
+
+Systolic::CostReport Systolic::CostModel::estimate(const std::vector<Systolic::CellCost> &costs, const std::size_t inputs) const
+{
+	CostReport report{inputs, 0, 0, 0, 0, std::vector<double>(costs.size(), 0), {}};
+	std::size_t interval = 1; // Largest interval of the chain, one X being offered per cycle.
+
+	for (const Systolic::CellCost &cost : costs) {
+		report.latency += cost.latency;
+		interval = std::max(interval, cost.interval);
+	}
+	report.throughput = 1.0 / interval;
+	if (costs.empty()) {
+		return report;
+	}
+	for (std::size_t i = 0; i != costs.size(); i++) {
+		if (costs[i].interval == interval) {
+			report.bottlenecks.push_back(i);
+		}
+	}
+	if (inputs == 0) {
+		return report;
+	}
+
+	// The last X leaves the last cell (inputs - 1) intervals of the bottleneck after the first one.
+	report.cycles = report.latency + (inputs - 1) * interval;
+
+	double busy = 0;
+
+	for (std::size_t i = 0; i != costs.size(); i++) {
+		report.cellUtilization[i] = std::min(1.0, static_cast<double>(inputs) * costs[i].interval / report.cycles);
+		busy += report.cellUtilization[i];
+	}
+	report.utilization = busy / costs.size();
+	return report;
+}
+
+/* Privates functions. */
+
+void Systolic::CostModel::checkCost(const Systolic::CellCost cost)
+{
+	if (cost.latency == 0 || cost.interval == 0) {
+		throw std::invalid_argument("Cells take at least one cycle of latency and of interval.");
+	}
+}
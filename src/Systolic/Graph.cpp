@@ -0,0 +1,428 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Graph.cpp
+ * Implementation of Graph.
+ */
+
+#include "Systolic/Container/Graph.hpp"
+
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+
+namespace {
+
+	/**
+	 * Order the nodes so that each one comes after its predecessors.
+	 * @throws std::invalid_argument If the nodes form a cycle.
+	 */
+	std::vector<std::size_t> topologicalOrder(const std::vector<Systolic::GraphNode> &nodes)
+	{
+		std::vector<std::vector<std::size_t>> successors(nodes.size());
+		std::vector<std::size_t> pending(nodes.size()); // Predecessors not ordered yet, by node.
+		std::vector<std::size_t> order;
+
+		for (std::size_t n = 0; n != nodes.size(); n++) {
+			for (std::size_t predecessor : nodes[n].predecessors) {
+				successors[predecessor].push_back(n);
+			}
+			pending[n] = nodes[n].predecessors.size();
+			if (pending[n] == 0) {
+				order.push_back(n);
+			}
+		}
+		for (std::size_t i = 0; i != order.size(); i++) {
+			for (std::size_t successor : successors[order[i]]) {
+				if (--pending[successor] == 0) {
+					order.push_back(successor);
+				}
+			}
+		}
+		if (order.size() != nodes.size()) {
+			throw std::invalid_argument("Nodes of the graph form a cycle.");
+		}
+		return order;
+	}
+}
+
+Systolic::Graph::Graph(const std::initializer_list<const int> entries)
+	: output(0), ownedEntries(entries.begin(), entries.end()), entries(ownedEntries.data()), count(ownedEntries.size()),
+	  injected(0), produced(0)
+{
+}
+
+Systolic::Graph::Graph(std::queue<int> entries)
+	: output(0), entries(nullptr), count(entries.size()), injected(0), produced(0)
+{
+	ownedEntries.reserve(entries.size());
+	for (; !entries.empty(); entries.pop()) {
+		ownedEntries.push_back(entries.front());
+	}
+	this->entries = ownedEntries.data();
+}
+
+Systolic::Graph::Graph(const int *entries, const std::size_t count)
+	: output(0), entries(entries), count(count), injected(0), produced(0)
+{
+}
+
+void Systolic::Graph::setNodes(std::vector<Systolic::GraphNode> nodes)
+{
+	if (nodes.size() < 2) {
+		throw std::invalid_argument("Graphs need at least one node besides the input.");
+	}
+	if (!nodes.front().cells.empty() || nodes.front().merge != nullptr || !nodes.front().predecessors.empty()) {
+		throw std::invalid_argument("Node 0 must be the input of the graph, without cells nor predecessors.");
+	}
+	for (std::size_t n = 1; n != nodes.size(); n++) {
+		const Systolic::GraphNode &node = nodes[n];
+		const bool chain = (!node.cells.empty() && node.merge == nullptr && node.predecessors.size() == 1);
+		const bool merge = (node.cells.empty() && node.merge != nullptr && node.predecessors.size() >= 2);
+
+		if (!chain && !merge) {
+			throw std::invalid_argument("Node " + std::to_string(n) + " must be either a chain of cells fed by a single node"
+						    + " or a merge of several ones.");
+		}
+		for (std::size_t predecessor : node.predecessors) {
+			if (predecessor >= nodes.size()) {
+				throw std::invalid_argument("Node " + std::to_string(n) + " is fed by a node that does not exist.");
+			}
+		}
+	}
+	topologicalOrder(nodes);
+
+	// Cells are moved to the container of their chain, the nodes keeping their edges.
+	chains.clear();
+	lengths.clear();
+	for (Systolic::GraphNode &node : nodes) {
+		chains.emplace_back();
+		lengths.push_back(node.cells.size());
+		if (!node.cells.empty()) {
+			chains.back() = std::make_unique<Systolic::Container>(std::queue<int>());
+			chains.back()->setCells(std::move(node.cells));
+			node.cells.clear();
+		}
+	}
+	this->nodes = std::move(nodes);
+	output = this->nodes.size() - 1;
+	schedule();
+}
+
+void Systolic::Graph::setNodes(std::shared_ptr<Systolic::GraphBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setNodes(builder->build());
+}
+
+void Systolic::Graph::setOutput(const std::size_t node)
+{
+	if (node == 0 || node >= nodes.size()) {
+		throw std::invalid_argument("No node but the input has the id " + std::to_string(node) + ".");
+	}
+	output = node;
+	schedule();
+}
+
+void Systolic::Graph::step()
+{
+	if (nodes.empty()) {
+		std::cerr << "Warn: Cannot compute graph step: No nodes available." << std::endl;
+		return;
+	}
+	tick(true);
+}
+
+void Systolic::Graph::compute()
+{
+	if (nodes.empty()) {
+		std::cerr << "Err: Cannot compute graph: No nodes available." << std::endl;
+		return;
+	}
+	while (!isDone()) {
+		logs.push_back(makeLogEntry());
+		tick(true);
+	}
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::Graph::computeBatch()
+{
+	if (nodes.empty()) {
+		std::cerr << "Err: Cannot compute graph: No nodes available." << std::endl;
+		return;
+	}
+	// Tokens in flight leave the graph first, as to keep the outputs in order.
+	while (produced != injected) {
+		tick(false);
+	}
+	if (injected == count) {
+		return;
+	}
+
+	std::vector<std::vector<int>> values(nodes.size()); // Outputs of each node over the batch, the inputs being read in place.
+	const std::size_t remaining = count - injected;
+	const auto valuesOf = [&](const std::size_t n) { return (n == 0 ? entries + injected : values[n].data()); };
+
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		const std::vector<std::size_t> &level = levels[l];
+
+		Systolic::Backend::Scheduler::getInstance().parallelFor(level.size(), [&](const std::size_t i){
+				const std::size_t n = level[i];
+				const std::vector<std::size_t> &predecessors = nodes[n].predecessors;
+
+				if (chains[n] != nullptr) {
+					chains[n]->setInputs(valuesOf(predecessors.front()), remaining);
+					chains[n]->computeBatch();
+					values[n] = chains[n]->takeOutputs();
+					return;
+				}
+				values[n].assign(valuesOf(predecessors.front()), valuesOf(predecessors.front()) + remaining);
+				for (std::size_t p = 1; p != predecessors.size(); p++) {
+					const int *operands = valuesOf(predecessors[p]);
+
+					for (std::size_t k = 0; k != remaining; k++) {
+						values[n][k] = nodes[n].merge(values[n][k], operands[k]);
+					}
+				}
+			});
+	}
+	outputs.reserve(outputs.size() + values[output].size());
+	for (int value : values[output]) {
+		outputs.push(value);
+	}
+	produced += remaining;
+	injected = count;
+}
+
+bool Systolic::Graph::isDone() const
+{
+	return !nodes.empty() && injected == count && produced == injected;
+}
+
+std::size_t Systolic::Graph::getLatency() const
+{
+	return ready[output];
+}
+
+std::vector<std::size_t> Systolic::Graph::getDelays(const std::size_t node) const
+{
+	if (node >= nodes.size()) {
+		throw std::invalid_argument("No node has the id " + std::to_string(node) + ".");
+	}
+	return delays[node];
+}
+
+std::vector<std::vector<std::size_t>> Systolic::Graph::getLevels() const
+{
+	return levels;
+}
+
+void Systolic::Graph::dumpOutputs() const
+{
+	Util::OutputWriter(Util::OutputFormat::Comma).write(outputs.view());
+}
+
+std::queue<int> Systolic::Graph::getOutputs() const
+{
+	return outputs.toQueue();
+}
+
+Util::RingView<int> Systolic::Graph::getOutputView() const
+{
+	return outputs.view();
+}
+
+std::string Systolic::Graph::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::Graph::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+void Systolic::Graph::schedule()
+{
+	const std::vector<std::size_t> order = topologicalOrder(nodes);
+	std::vector<bool> needed(nodes.size(), false); // Whether the node leads to the output.
+	std::vector<std::size_t> depth(nodes.size(), 0); // Level of each node.
+
+	needed[output] = true;
+	for (auto it = order.rbegin(); it != order.rend(); it++) {
+		for (std::size_t predecessor : nodes[*it].predecessors) {
+			needed[predecessor] = needed[predecessor] || needed[*it];
+		}
+	}
+
+	/*
+	 * A chain of k cells leaves the token of the first X k ticks after it
+	 * got it, a merge one tick after its latest input, the edges of its
+	 * other inputs delaying them by the difference.
+	 */
+	ready.assign(nodes.size(), 0);
+	delays.assign(nodes.size(), {});
+	lines.assign(nodes.size(), {});
+	levels.assign(1, {0});
+	for (std::size_t n : order) {
+		const std::vector<std::size_t> &predecessors = nodes[n].predecessors;
+
+		if (n == 0 || !needed[n]) {
+			continue;
+		}
+
+		std::size_t arrival = 0;
+
+		for (std::size_t predecessor : predecessors) {
+			arrival = std::max(arrival, ready[predecessor]);
+			depth[n] = std::max(depth[n], depth[predecessor] + 1);
+		}
+		for (std::size_t predecessor : predecessors) {
+			delays[n].push_back(arrival - ready[predecessor]);
+			lines[n].emplace_back(delays[n].back(), std::nullopt);
+		}
+		ready[n] = arrival + (chains[n] != nullptr ? lengths[n] : 1);
+		levels.resize(std::max(levels.size(), depth[n] + 1));
+		levels[depth[n]].push_back(n);
+	}
+	emitted.assign(nodes.size(), std::nullopt);
+	produced = injected; // Tokens in flight are dropped along with the previous schedule.
+}
+
+void Systolic::Graph::tick(const bool inject)
+{
+	std::vector<std::optional<int>> available = emitted; // Tokens left on the last tick, the input node giving its own at once.
+	std::vector<std::optional<int>> next(nodes.size());
+
+	if (inject && injected != count) {
+		available[0] = entries[injected];
+		injected++;
+	}
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		const std::vector<std::size_t> &level = levels[l];
+
+		Systolic::Backend::Scheduler::getInstance().parallelFor(level.size(), [&](const std::size_t i){
+				const std::size_t n = level[i];
+				std::vector<std::optional<int>> tokens;
+
+				// Tokens go through the delay buffer of their edge, if any.
+				for (std::size_t p = 0; p != nodes[n].predecessors.size(); p++) {
+					std::optional<int> token = available[nodes[n].predecessors[p]];
+
+					if (delays[n][p] != 0) {
+						lines[n][p].push_back(token);
+						token = lines[n][p].front();
+						lines[n][p].pop_front();
+					}
+					tokens.push_back(token);
+				}
+				if (chains[n] != nullptr) {
+					const int value = tokens.front().value_or(0);
+
+					chains[n]->setInputs(&value, tokens.front().has_value() ? 1 : 0);
+					chains[n]->step();
+					chains[n]->setInputs(nullptr, 0); // The token does not outlive the tick.
+
+					const std::vector<int> out = chains[n]->takeOutputs();
+
+					next[n] = (out.empty() ? std::nullopt : std::optional<int>(out.front()));
+					return;
+				}
+
+				const std::size_t present = std::count_if(tokens.begin(), tokens.end(),
+									  [](const std::optional<int> &token) { return token.has_value(); });
+
+				if (present == 0) {
+					return;
+				}
+				if (present != tokens.size()) {
+					throw std::logic_error("Tokens of node " + std::to_string(n) + " are not aligned.");
+				}
+
+				int value = tokens.front().value();
+
+				for (std::size_t p = 1; p != tokens.size(); p++) {
+					value = nodes[n].merge(value, tokens[p].value());
+				}
+				next[n] = value;
+			});
+	}
+	emitted = next;
+	if (next[output].has_value()) {
+		outputs.push(next[output].value());
+		produced++;
+	}
+}
+
+std::string Systolic::Graph::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying every node leading to the output as [id | predecessors | token left on the last tick]. */
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		for (std::size_t n : levels[l]) {
+			std::stringstream predecessors;
+
+			for (std::size_t p = 0; p != nodes[n].predecessors.size(); p++) {
+				predecessors << (p != 0 ? "," : "") << nodes[n].predecessors[p];
+				if (delays[n][p] != 0) {
+					predecessors << "+" << delays[n][p];
+				}
+			}
+			ss << "[" << std::setw(4) << n << " | " << std::setw(8) << predecessors.str()
+			   << " | " << (chains[n] != nullptr ? "chain" : "merge")
+			   << " | " << std::setw(6) << optionalToString(emitted[n]) << "]" << std::endl;
+		}
+	}
+	ss << "outputs: ";
+	for (std::size_t i = 0; i != outputs.size(); i++) {
+		ss << (i != 0 ? ", " : "") << outputs.view()[i];
+	}
+	ss << std::endl << std::endl;
+	return ss.str();
+}
+
+std::string Systolic::Graph::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
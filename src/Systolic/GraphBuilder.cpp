@@ -0,0 +1,160 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GraphBuilder.cpp
+ * Implementation of GraphBuilder.
+ */
+
+#include "Systolic/Container/GraphBuilder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+Systolic::GraphBuilder::GraphBuilder()
+	: nodes(1)
+{
+}
+
+std::shared_ptr<Systolic::GraphBuilder> Systolic::GraphBuilder::getNew()
+{
+	return std::make_shared<Systolic::GraphBuilder>();
+}
+
+std::function<int(const int, const int)> Systolic::GraphBuilder::getMergeOperation(const Merge merge)
+{
+	// Unsigned arithmetic, as to wrap around as the cells do.
+	switch (merge) {
+	case Merge::Sum:
+		return [](const int a, const int b) { return static_cast<int>(static_cast<std::uint32_t>(a) + static_cast<std::uint32_t>(b)); };
+	case Merge::Difference:
+		return [](const int a, const int b) { return static_cast<int>(static_cast<std::uint32_t>(a) - static_cast<std::uint32_t>(b)); };
+	case Merge::Product:
+		return [](const int a, const int b) { return static_cast<int>(static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(b)); };
+	case Merge::Min:
+		return [](const int a, const int b) { return std::min(a, b); };
+	case Merge::Max:
+		return [](const int a, const int b) { return std::max(a, b); };
+	default:
+		throw std::invalid_argument("Unknown merge operation.");
+	}
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::addChain(std::shared_ptr<Systolic::CellArrayBuilder> chain, const std::size_t from)
+{
+	if (chain == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	checkNode(from);
+
+	Systolic::GraphNode node;
+
+	node.cells = chain->build();
+	if (node.cells.empty()) {
+		throw std::invalid_argument("Chain nodes need at least one cell.");
+	}
+	node.predecessors.push_back(from);
+	nodes.push_back(std::move(node));
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::addMerge(const Merge merge, const std::vector<std::size_t> &from)
+{
+	return addMerge(getMergeOperation(merge), from);
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::addMerge(const std::function<int(const int, const int)> merge, const std::vector<std::size_t> &from)
+{
+	if (merge == nullptr || from.size() < 2) {
+		throw std::invalid_argument("Merge nodes need an operation and at least two predecessors.");
+	}
+	for (std::size_t id : from) {
+		checkNode(id);
+	}
+
+	Systolic::GraphNode node;
+
+	node.merge = merge;
+	node.predecessors = from;
+	nodes.push_back(std::move(node));
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::GraphBuilder> Systolic::GraphBuilder::then(std::shared_ptr<Systolic::CellArrayBuilder> chain)
+{
+	return addChain(chain, getLast());
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::parallel(const std::vector<std::shared_ptr<Systolic::CellArrayBuilder>> &branches, const Merge merge)
+{
+	return parallel(branches, getMergeOperation(merge));
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::parallel(const std::vector<std::shared_ptr<Systolic::CellArrayBuilder>> &branches,
+				 const std::function<int(const int, const int)> merge)
+{
+	const std::size_t from = getLast();
+	std::vector<std::size_t> ends;
+
+	if (branches.size() < 2) {
+		throw std::invalid_argument("Parallel branches need at least two branches.");
+	}
+	for (const std::shared_ptr<Systolic::CellArrayBuilder> &branch : branches) {
+		addChain(branch, from);
+		ends.push_back(getLast());
+	}
+	return addMerge(merge, ends);
+}
+
+std::shared_ptr<Systolic::GraphBuilder>
+Systolic::GraphBuilder::residual(std::shared_ptr<Systolic::CellArrayBuilder> chain, const Merge merge)
+{
+	const std::size_t from = getLast();
+
+	addChain(chain, from);
+	return addMerge(merge, {from, getLast()});
+}
+
+std::size_t Systolic::GraphBuilder::getLast() const
+{
+	return nodes.size() - 1;
+}
+
+std::vector<Systolic::GraphNode> Systolic::GraphBuilder::build()
+{
+	std::vector<Systolic::GraphNode> built = std::move(nodes);
+
+	nodes.clear();
+	nodes.resize(1);
+	return built;
+}
+
+/* Privates functions. */
+
+void Systolic::GraphBuilder::checkNode(const std::size_t id) const
+{
+	if (id >= nodes.size()) {
+		throw std::invalid_argument("No node has the id " + std::to_string(id) + ".");
+	}
+}
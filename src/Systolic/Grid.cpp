@@ -0,0 +1,319 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Grid.cpp
+ * Implementation of Grid.
+ */
+
+#include "Systolic/Container/Grid.hpp"
+
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+Systolic::Grid::Grid(const std::vector<std::vector<int>> lhs, const std::vector<std::vector<int>> rhs)
+	: lhs(lhs), rhs(rhs), tick(0)
+{
+}
+
+void Systolic::Grid::setCells(std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> cells)
+{
+	for (const std::vector<std::unique_ptr<Systolic::Cell::GridCell>> &row : cells) {
+		if (row.empty() || row.size() != cells.front().size()) {
+			throw std::invalid_argument("Every row of the grid must have the same, non-zero, size.");
+		}
+		for (const std::unique_ptr<Systolic::Cell::GridCell> &cell : row) {
+			if (cell == nullptr || cell->getDataflow() != cells.front().front()->getDataflow()) {
+				throw std::invalid_argument("Every cell of the grid must have the same dataflow.");
+			}
+		}
+	}
+	this->cells = std::move(cells);
+	tick = 0;
+	result.clear();
+}
+
+void Systolic::Grid::setCells(std::shared_ptr<Systolic::GridBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setCells(builder->build());
+}
+
+void Systolic::Grid::step()
+{
+	using Systolic::Cell::Dataflow;
+
+	if (cells.size() == 0) {
+		std::cerr << "Warn: Cannot compute grid step: No cells available." << std::endl;
+		return;
+	}
+	checkOperands();
+	if (isDone()) {
+		return;
+	}
+
+	const Dataflow dataflow = getDataflow();
+	const std::size_t t = tick;
+
+	if (result.empty()) {
+		result.assign(dataflow == Dataflow::OutputStationary ? cells.size() : lhs.size(),
+			      std::vector<int>(cells.front().size(), 0));
+	}
+
+	// Feeds the edges with the skewed operands and every other cell with its neighbours' partials.
+	for (std::size_t i = 0; i != cells.size(); i++) {
+		for (std::size_t j = 0; j != cells[i].size(); j++) {
+			std::optional<int> west;
+			std::optional<int> north;
+
+			if (j != 0) {
+				west = std::get<0>(cells[i][j - 1]->getPartial());
+			} else if (dataflow == Dataflow::OutputStationary && t >= i && t - i < lhs[i].size()) {
+				west = lhs[i][t - i]; // Row i of lhs, delayed by i steps.
+			} else if (dataflow == Dataflow::WeightStationary && t >= i && t - i < lhs.size()) {
+				west = lhs[t - i][i]; // Column i of lhs, delayed by i steps.
+			}
+			if (i != 0) {
+				north = std::get<1>(cells[i - 1][j]->getPartial());
+			} else if (dataflow == Dataflow::OutputStationary && t >= j && t - j < rhs.size()) {
+				north = rhs[t - j][j]; // Column j of rhs, delayed by j steps.
+			}
+			cells[i][j]->feed(west, north);
+		}
+	}
+
+	// Compute the current value of each row of cells, the rows being spread over the scheduler.
+	Systolic::Backend::Scheduler::getInstance().parallelFor(cells.size(), [this](const std::size_t i){
+			for (std::unique_ptr<Systolic::Cell::GridCell> &cell : cells[i]) {
+				cell->compute();
+			}
+		});
+	tick++;
+
+	// Collects the sums leaving the bottom row, or the accumulators once every product is done.
+	if (dataflow == Dataflow::WeightStationary) {
+		for (std::size_t j = 0; j != cells.back().size(); j++) {
+			std::optional<int> south = std::get<1>(cells.back()[j]->getPartial());
+
+			if (south.has_value()) {
+				result[t - (cells.size() - 1) - j][j] = south.value();
+			}
+		}
+	} else if (isDone()) {
+		for (std::size_t i = 0; i != cells.size(); i++) {
+			for (std::size_t j = 0; j != cells[i].size(); j++) {
+				result[i][j] = cells[i][j]->getAccumulator();
+			}
+		}
+	}
+}
+
+void Systolic::Grid::compute()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute grid: No cells available." << std::endl;
+		return;
+	}
+	checkOperands();
+	while (!isDone()) {
+		logs.push_back(makeLogEntry());
+		step();
+	}
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::Grid::computeBatch()
+{
+	using Systolic::Cell::Dataflow;
+
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute grid: No cells available." << std::endl;
+		return;
+	}
+	checkOperands();
+
+	const std::size_t m = lhs.size();
+	const std::size_t k = lhs.front().size();
+	const std::size_t n = cells.front().size();
+	const bool stationaryWeights = (getDataflow() == Dataflow::WeightStationary);
+	/* Operands are flattened in row-major order, with unsigned values as to wrap around as the cells do. */
+	std::vector<std::uint32_t> a(m * k);
+	std::vector<std::uint32_t> b(k * n);
+	std::vector<std::uint32_t> c(m * n, 0);
+
+	for (std::size_t i = 0; i != m; i++) {
+		std::copy(lhs[i].begin(), lhs[i].end(), a.begin() + i * k);
+	}
+	for (std::size_t i = 0; i != k; i++) {
+		for (std::size_t j = 0; j != n; j++) {
+			b[i * n + j] = (stationaryWeights ? cells[i][j]->getWeight() : rhs[i][j]);
+		}
+	}
+
+	/* Tiles of rows are spread over the scheduler, each tile being blocked over k and n for the cache. */
+	constexpr std::size_t tileRows = 32;
+	constexpr std::size_t blockK = 128;
+	constexpr std::size_t blockN = 512;
+	const std::size_t tiles = (m + tileRows - 1) / tileRows;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(tiles, [&](const std::size_t tile){
+			const std::size_t rowEnd = std::min(m, (tile + 1) * tileRows);
+
+			for (std::size_t kk = 0; kk < k; kk += blockK) {
+				for (std::size_t jj = 0; jj < n; jj += blockN) {
+					const std::size_t kEnd = std::min(k, kk + blockK);
+					const std::size_t jEnd = std::min(n, jj + blockN);
+
+					for (std::size_t i = tile * tileRows; i != rowEnd; i++) {
+						std::uint32_t *row = c.data() + i * n;
+
+						for (std::size_t p = kk; p != kEnd; p++) {
+							const std::uint32_t value = a[i * k + p];
+							const std::uint32_t *weights = b.data() + p * n;
+
+							for (std::size_t j = jj; j != jEnd; j++) {
+								row[j] += value * weights[j];
+							}
+						}
+					}
+				}
+			}
+		});
+	result.assign(m, std::vector<int>(n));
+	for (std::size_t i = 0; i != m; i++) {
+		std::copy(c.begin() + i * n, c.begin() + (i + 1) * n, result[i].begin());
+	}
+	tick = getStepCount();
+}
+
+bool Systolic::Grid::isDone() const
+{
+	return !cells.empty() && tick >= getStepCount();
+}
+
+std::vector<std::vector<int>> Systolic::Grid::getResult() const
+{
+	return result;
+}
+
+void Systolic::Grid::dumpResult() const
+{
+	for (const std::vector<int> &row : result) {
+		for (std::size_t j = 0; j != row.size(); j++) {
+			std::cout << row[j] << (j + 1 != row.size() ? "," : "");
+		}
+		std::cout << std::endl;
+	}
+}
+
+std::string Systolic::Grid::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::Grid::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+Systolic::Cell::Dataflow Systolic::Grid::getDataflow() const
+{
+	return cells.front().front()->getDataflow();
+}
+
+std::size_t Systolic::Grid::getStepCount() const
+{
+	// The last element of lhs reaches the bottom right cell after m + k + n - 2 steps.
+	return lhs.size() + lhs.front().size() + cells.front().size() - 2;
+}
+
+void Systolic::Grid::checkOperands() const
+{
+	if (lhs.empty() || lhs.front().empty()) {
+		throw std::invalid_argument("Left operand of the grid is empty.");
+	}
+	for (const std::vector<int> &row : lhs) {
+		if (row.size() != lhs.front().size()) {
+			throw std::invalid_argument("Every row of the left operand must have the same size.");
+		}
+	}
+	if (getDataflow() == Systolic::Cell::Dataflow::WeightStationary) {
+		if (lhs.front().size() != cells.size()) {
+			throw std::invalid_argument("Left operand must have as many columns as the grid has rows.");
+		}
+		return;
+	}
+	if (lhs.size() != cells.size()) {
+		throw std::invalid_argument("Left operand must have as many rows as the grid.");
+	}
+	if (rhs.size() != lhs.front().size()) {
+		throw std::invalid_argument("Right operand must have as many rows as the left operand has columns.");
+	}
+	for (const std::vector<int> &row : rhs) {
+		if (row.size() != cells.front().size()) {
+			throw std::invalid_argument("Right operand must have as many columns as the grid.");
+		}
+	}
+}
+
+std::string Systolic::Grid::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying every cell as [west, north | description]. */
+	for (const std::vector<std::unique_ptr<Systolic::Cell::GridCell>> &row : cells) {
+		for (const std::unique_ptr<Systolic::Cell::GridCell> &cell : row) {
+			ss << "[" << std::setw(6) << optionalToString(std::get<0>(cell->getInputs()))
+			   << "," << std::setw(6) << optionalToString(std::get<1>(cell->getInputs()))
+			   << " | " << std::setw(10) << std::left << cell->getCellDescription() << std::right << "] ";
+		}
+		ss << std::endl;
+	}
+	ss << std::endl;
+	return ss.str();
+}
+
+std::string Systolic::Grid::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file GridBuilder.cpp
+ * Implementation of GridBuilder.
+ */
+
+#include "Systolic/Container/GridBuilder.hpp"
+
+std::shared_ptr<Systolic::GridBuilder> Systolic::GridBuilder::getNew()
+{
+	return std::make_shared<Systolic::GridBuilder>();
+}
+
+std::shared_ptr<Systolic::GridBuilder>
+Systolic::GridBuilder::outputStationary(const std::size_t rows, const std::size_t cols)
+{
+	if (rows == 0 || cols == 0) {
+		throw std::invalid_argument("Cannot declare an empty grid.");
+	}
+	grid.clear();
+	for (std::size_t i = 0; i != rows; i++) {
+		grid.emplace_back();
+		for (std::size_t j = 0; j != cols; j++) {
+			grid.back().push_back(std::make_unique<Systolic::Cell::GridCell>());
+		}
+	}
+	return shared_from_this();
+}
+
+std::shared_ptr<Systolic::GridBuilder>
+Systolic::GridBuilder::weightStationary(const std::vector<std::vector<int>> &weights)
+{
+	if (weights.empty() || weights.front().empty()) {
+		throw std::invalid_argument("Cannot declare an empty grid.");
+	}
+	for (const std::vector<int> &row : weights) {
+		if (row.size() != weights.front().size()) {
+			throw std::invalid_argument("Every row of weights must have the same size.");
+		}
+	}
+	grid.clear();
+	for (const std::vector<int> &row : weights) {
+		grid.emplace_back();
+		for (int weight : row) {
+			grid.back().push_back(std::make_unique<Systolic::Cell::GridCell>(weight));
+		}
+	}
+	return shared_from_this();
+}
+
+std::vector<std::vector<std::unique_ptr<Systolic::Cell::GridCell>>> Systolic::GridBuilder::build()
+{
+	return std::move(grid);
+}
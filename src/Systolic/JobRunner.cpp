@@ -0,0 +1,65 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file JobRunner.cpp
+ * Implementation of JobRunner.
+ */
+
+#include "Systolic/Container/JobRunner.hpp"
+
+#include <chrono>
+
+Systolic::JobRunner::JobRunner(Systolic::Backend::Scheduler &scheduler)
+	: scheduler(scheduler)
+{
+}
+
+std::vector<Systolic::JobResult> Systolic::JobRunner::run(const std::vector<Systolic::Job> &jobs) const
+{
+	std::vector<Systolic::JobResult> results(jobs.size());
+
+	scheduler.parallelFor(jobs.size(), [&](const std::size_t j){
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			Systolic::JobResult &result = results[j];
+
+			try {
+				std::shared_ptr<Systolic::CellArrayBuilder> builder = Systolic::CellArrayBuilder::getNew();
+				Systolic::Container container(jobs[j].inputs);
+
+				if (jobs[j].equation.empty()) {
+					builder->fromPolynomialCoefs(jobs[j].coefs);
+				} else {
+					builder->fromPolynomialEquation(jobs[j].equation);
+				}
+				container.setCells(builder);
+				container.computeBatch();
+				result.outputs = container.getOutputView().toVector();
+			} catch (const std::exception &e) {
+				result.error = e.what();
+			}
+			result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		});
+	return results;
+}
+
+std::size_t Systolic::JobRunner::getWorkers() const
+{
+	return scheduler.getWorkers() + 1;
+}
@@ -0,0 +1,277 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Pipeline.cpp
+ * Implementation of Pipeline.
+ */
+
+#include "Systolic/Container/Pipeline.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+	/**
+	 * Bounded buffer of blocks shared by two stages.
+	 * The previous stage pushes its outputs, waiting while the buffer
+	 * is full, and the next one pops them as its inputs, waiting while
+	 * the buffer is empty.
+	 */
+	class BlockChannel {
+	public:
+		BlockChannel(const std::size_t depth)
+			: depth(depth), finished(false), aborted(false)
+		{
+		}
+
+		/** Push a block, unless the channel was aborted. */
+		bool push(std::vector<int> block)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			notFull.wait(lock, [this]{ return aborted || blocks.size() < depth; });
+			if (aborted) {
+				return false;
+			}
+			blocks.push_back(std::move(block));
+			notEmpty.notify_one();
+			return true;
+		}
+
+		/** Pop the oldest block, unless every block was popped after finish or the channel was aborted. */
+		bool pop(std::vector<int> &block)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			notEmpty.wait(lock, [this]{ return aborted || finished || !blocks.empty(); });
+			if (aborted || blocks.empty()) {
+				return false;
+			}
+			block = std::move(blocks.front());
+			blocks.pop_front();
+			notFull.notify_one();
+			return true;
+		}
+
+		/** Tell that no more block will be pushed. */
+		void finish()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			finished = true;
+			notEmpty.notify_all();
+		}
+
+		/** Wake up both stages, as to stop them. */
+		void abort()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			aborted = true;
+			notEmpty.notify_all();
+			notFull.notify_all();
+		}
+	private:
+		const std::size_t depth;
+		std::deque<std::vector<int>> blocks;
+		std::mutex mutex;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+		bool finished;
+		bool aborted;
+	};
+}
+
+Systolic::Pipeline::Pipeline(const std::initializer_list<const int> entries)
+	: ownedEntries(entries.begin(), entries.end()), entries(ownedEntries.data()), count(ownedEntries.size()),
+	  blockSize(4096), depth(4)
+{
+}
+
+Systolic::Pipeline::Pipeline(std::queue<int> entries)
+	: entries(nullptr), count(entries.size()), blockSize(4096), depth(4)
+{
+	ownedEntries.reserve(entries.size());
+	for (; !entries.empty(); entries.pop()) {
+		ownedEntries.push_back(entries.front());
+	}
+	this->entries = ownedEntries.data();
+}
+
+Systolic::Pipeline::Pipeline(const int *entries, const std::size_t count)
+	: entries(entries), count(count), blockSize(4096), depth(4)
+{
+}
+
+void Systolic::Pipeline::addStage(std::vector<std::unique_ptr<Systolic::Cell::ICell>> cells)
+{
+	if (cells.empty()) {
+		throw std::invalid_argument("Pipeline stages need at least one cell.");
+	}
+	stages.push_back(std::make_unique<Systolic::Container>(std::queue<int>()));
+	stages.back()->setCells(std::move(cells));
+	stageSeconds.push_back(0);
+}
+
+void Systolic::Pipeline::addStage(std::shared_ptr<Systolic::CellArrayBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	addStage(builder->build());
+}
+
+void Systolic::Pipeline::setBlockSize(const std::size_t blockSize)
+{
+	if (blockSize == 0) {
+		throw std::invalid_argument("Pipeline blocks need at least one input.");
+	}
+	this->blockSize = blockSize;
+}
+
+void Systolic::Pipeline::setDepth(const std::size_t depth)
+{
+	if (depth == 0) {
+		throw std::invalid_argument("Pipeline buffers need room for at least one block.");
+	}
+	this->depth = depth;
+}
+
+void Systolic::Pipeline::compute()
+{
+	if (stages.empty()) {
+		std::cerr << "Err: Cannot compute pipeline: No stages available." << std::endl;
+		return;
+	}
+	if (count == 0) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+
+	std::vector<std::unique_ptr<BlockChannel>> channels; // Channel k links stage k to stage k + 1.
+	std::vector<std::thread> threads;
+	std::exception_ptr failure;
+	std::mutex failureMutex;
+
+	for (std::size_t k = 0; k + 1 < stages.size(); k++) {
+		channels.push_back(std::make_unique<BlockChannel>(depth));
+	}
+	outputs.reserve(outputs.size() + count);
+
+	// Each stage evaluates its blocks in order, the first one reading them straight from the inputs.
+	auto runStage = [&](const std::size_t k) {
+		try {
+			std::vector<int> block;
+			std::size_t offset = 0;
+
+			while (true) {
+				if (k == 0 && offset != count) {
+					const std::size_t size = std::min(blockSize, count - offset);
+
+					stages[k]->setInputs(entries + offset, size);
+					offset += size;
+				} else if (k != 0 && channels[k - 1]->pop(block)) {
+					stages[k]->setInputs(block.data(), block.size());
+				} else {
+					break;
+				}
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				stages[k]->computeBatch();
+				stageSeconds[k] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				if (k + 1 != stages.size()) {
+					if (!channels[k]->push(stages[k]->takeOutputs())) {
+						break;
+					}
+					continue;
+				}
+
+				std::vector<int> auxiliary;
+
+				for (int output : stages[k]->takeOutputs(auxiliary)) {
+					outputs.push(output);
+				}
+				for (int value : auxiliary) {
+					auxiliaryOutputs.push(value);
+				}
+			}
+			if (k + 1 != stages.size()) {
+				channels[k]->finish();
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(failureMutex);
+
+			if (failure == nullptr) {
+				failure = std::current_exception();
+			}
+			for (std::unique_ptr<BlockChannel> &channel : channels) {
+				channel->abort();
+			}
+		}
+	};
+
+	for (std::size_t k = 0; k + 1 < stages.size(); k++) {
+		threads.emplace_back(runStage, k);
+	}
+	runStage(stages.size() - 1);
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+	count = 0;
+	if (failure != nullptr) {
+		std::rethrow_exception(failure);
+	}
+}
+
+std::size_t Systolic::Pipeline::getStageCount() const
+{
+	return stages.size();
+}
+
+std::vector<double> Systolic::Pipeline::getStageSeconds() const
+{
+	return stageSeconds;
+}
+
+void Systolic::Pipeline::dumpOutputs() const
+{
+	Util::OutputWriter(Util::OutputFormat::Comma).write(outputs.view());
+}
+
+std::queue<int> Systolic::Pipeline::getOutputs() const
+{
+	return outputs.toQueue();
+}
+
+Util::RingView<int> Systolic::Pipeline::getOutputView() const
+{
+	return outputs.view();
+}
+
+std::queue<int> Systolic::Pipeline::getAuxiliaryOutputs() const
+{
+	return auxiliaryOutputs.toQueue();
+}
@@ -0,0 +1,109 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file ResultCache.cpp
+ * Implementation of ResultCache.
+ */
+
+#include "Systolic/Container/ResultCache.hpp"
+
+#include <stdexcept>
+
+Systolic::ResultCache::ResultCache(const std::size_t capacity)
+	: size(0)
+{
+	std::size_t rounded = window;
+
+	if (capacity == 0) {
+		throw std::invalid_argument("Cannot declare a cache without capacity.");
+	}
+	while (rounded < capacity) {
+		rounded *= 2;
+	}
+	slots.assign(rounded, Slot{0, 0, 0, false});
+}
+
+std::optional<int> Systolic::ResultCache::find(const std::uint64_t pipeline, const int x) const
+{
+	const std::uint64_t home = hash(pipeline, x);
+
+	// Slots are never emptied but by clear, so that the first free slot ends the search.
+	for (std::size_t i = 0; i != window; i++) {
+		const Slot &slot = slots[(home + i) & (slots.size() - 1)];
+
+		if (!slot.used) {
+			break;
+		}
+		if (slot.pipeline == pipeline && slot.x == x) {
+			return slot.result;
+		}
+	}
+	return std::nullopt;
+}
+
+void Systolic::ResultCache::insert(const std::uint64_t pipeline, const int x, const int result)
+{
+	const std::uint64_t home = hash(pipeline, x);
+
+	for (std::size_t i = 0; i != window; i++) {
+		Slot &slot = slots[(home + i) & (slots.size() - 1)];
+
+		if (!slot.used || (slot.pipeline == pipeline && slot.x == x)) {
+			size += !slot.used;
+			slot = Slot{pipeline, x, result, true};
+			return;
+		}
+	}
+	// The window is full: one of its entries, chosen from the upper bits of the hash, is replaced.
+	slots[(home + (home >> 40) % window) & (slots.size() - 1)] = Slot{pipeline, x, result, true};
+}
+
+void Systolic::ResultCache::clear()
+{
+	for (Slot &slot : slots) {
+		slot.used = false;
+	}
+	size = 0;
+}
+
+std::size_t Systolic::ResultCache::getSize() const
+{
+	return size;
+}
+
+std::size_t Systolic::ResultCache::getCapacity() const
+{
+	return slots.size();
+}
+
+/* Privates functions. */
+
+std::uint64_t Systolic::ResultCache::hash(const std::uint64_t pipeline, const int x) const
+{
+	// 64-bit finalizer of MurmurHash3 over both parts of the key.
+	std::uint64_t h = (pipeline * 0x9e3779b97f4a7c15ULL) ^ static_cast<std::uint32_t>(x);
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb3d03c3fdd5bULL;
+	h ^= h >> 33;
+	return h;
+}
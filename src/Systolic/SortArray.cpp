@@ -0,0 +1,283 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file SortArray.cpp
+ * Implementation of SortArray.
+ */
+
+#include "Systolic/Container/SortArray.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+
+	constexpr std::size_t minBlockSize = 4096; /** Smallest block given to a thread by computeBatch. */
+}
+
+Systolic::SortArray::SortArray(const std::initializer_list<const int> entries, const Systolic::Sorting sorting,
+			       const std::size_t limit)
+	: entries(entries.begin(), entries.end()), sorting(sorting), limit(limit), tick(0)
+{
+	init();
+}
+
+Systolic::SortArray::SortArray(const std::queue<int> entries, const Systolic::Sorting sorting, const std::size_t limit)
+	: sorting(sorting), limit(limit), tick(0)
+{
+	for (std::queue<int> copy = entries; !copy.empty(); copy.pop()) {
+		this->entries.push_back(copy.front());
+	}
+	init();
+}
+
+void Systolic::SortArray::step()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Warn: Cannot compute sort array step: No entries available." << std::endl;
+		return;
+	}
+	if (isDone()) {
+		return;
+	}
+	if (tick < getLatency()) {
+		sortStep();
+	} else {
+		// The first cell outputs its value, every other value moving one cell to the left.
+		std::optional<int> output = cells.front()->shift(cells.size() > 1 ? cells[1]->getValue() : std::nullopt);
+
+		for (std::size_t i = 1; i != cells.size(); i++) {
+			cells[i]->shift(i + 1 != cells.size() ? cells[i + 1]->getValue() : std::nullopt);
+		}
+		outputs.push(output.value());
+	}
+	tick++;
+}
+
+void Systolic::SortArray::compute()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute sort array: No entries available." << std::endl;
+		return;
+	}
+	while (!isDone()) {
+		logs.push_back(makeLogEntry());
+		step();
+	}
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::SortArray::computeBatch()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute sort array: No entries available." << std::endl;
+		return;
+	}
+
+	Systolic::Backend::Scheduler &scheduler = Systolic::Backend::Scheduler::getInstance();
+	std::vector<int> values = entries;
+	/* One block per thread of the scheduler, the calling one included. */
+	const std::size_t blocks = std::max<std::size_t>(1, std::min<std::size_t>(scheduler.getWorkers() + 1,
+										   values.size() / minBlockSize));
+	const std::size_t blockSize = (values.size() + blocks - 1) / blocks;
+	auto begin = [&](std::size_t b) { return values.begin() + b * blockSize; };
+
+	// Blocks must have the same size for the merge-splits to sort, the padding sorting last.
+	values.resize(blocks * blockSize, std::numeric_limits<int>::max());
+
+	if (limit < entries.size()) {
+		// Each block selects its smallest values through a heap, the candidates being selected again.
+		std::vector<std::vector<int>> candidates(blocks);
+
+		scheduler.parallelFor(blocks, [&](std::size_t b) {
+				const std::size_t count = std::min(limit, blockSize);
+
+				std::partial_sort(begin(b), begin(b) + count, begin(b + 1));
+				candidates[b].assign(begin(b), begin(b) + count);
+			});
+		values.clear();
+		for (const std::vector<int> &candidate : candidates) {
+			values.insert(values.end(), candidate.begin(), candidate.end());
+		}
+		std::partial_sort(values.begin(), values.begin() + limit, values.end());
+	} else {
+		// Sorted blocks are ordered by an odd-even transposition, each exchange being a merge-split.
+		scheduler.parallelFor(blocks, [&](std::size_t b) { std::sort(begin(b), begin(b + 1)); });
+		for (std::size_t phase = 0; phase != blocks; phase++) {
+			const std::size_t first = phase % 2;
+
+			scheduler.parallelFor((blocks - first) / 2, [&](std::size_t pair) {
+					const std::size_t b = first + 2 * pair;
+					std::vector<int> merged(begin(b + 2) - begin(b));
+
+					std::merge(begin(b), begin(b + 1), begin(b + 1), begin(b + 2), merged.begin());
+					std::copy(merged.begin(), merged.end(), begin(b));
+				});
+		}
+	}
+	outputs = std::queue<int>();
+	for (std::size_t i = 0; i != limit; i++) {
+		outputs.push(values[i]);
+	}
+	tick = getLatency() + limit;
+}
+
+bool Systolic::SortArray::isDone() const
+{
+	return !cells.empty() && tick >= getLatency() + limit;
+}
+
+std::size_t Systolic::SortArray::getLatency() const
+{
+	if (sorting == Systolic::Sorting::OddEvenTransposition) {
+		return entries.size();
+	}
+	// The last entry may go through every cell before the queue is settled.
+	return entries.size() + cells.size() - 1;
+}
+
+void Systolic::SortArray::dumpOutputs() const
+{
+	std::queue<int> copy = outputs;
+
+	while (!copy.empty()) {
+		std::cout << copy.front() << (copy.size() > 1 ? "," : "");
+		copy.pop();
+	}
+	std::cout << std::endl;
+}
+
+std::queue<int> Systolic::SortArray::getOutputs() const
+{
+	return outputs;
+}
+
+std::string Systolic::SortArray::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::SortArray::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+void Systolic::SortArray::init()
+{
+	if (limit == 0 || limit > entries.size()) {
+		limit = entries.size();
+	}
+	if (sorting == Systolic::Sorting::OddEvenTransposition) {
+		for (int entry : entries) {
+			cells.push_back(std::make_unique<Systolic::Cell::CompareExchangeCell>());
+			cells.back()->shift(entry);
+		}
+		return;
+	}
+	for (std::size_t i = 0; i != limit; i++) {
+		cells.push_back(std::make_unique<Systolic::Cell::CompareExchangeCell>());
+	}
+	for (int entry : entries) {
+		inputs.push(entry);
+	}
+}
+
+void Systolic::SortArray::sortStep()
+{
+	Systolic::Backend::Scheduler &scheduler = Systolic::Backend::Scheduler::getInstance();
+
+	if (sorting == Systolic::Sorting::OddEvenTransposition) {
+		// Even steps order the pairs starting on an even cell, odd steps the other ones.
+		const std::size_t first = tick % 2;
+
+		if (first + 1 < cells.size()) {
+			scheduler.parallelFor((cells.size() - first) / 2, [this, first](const std::size_t p){
+					const std::size_t i = first + 2 * p;
+
+					cells[i]->exchange(*cells[i + 1]);
+				});
+		}
+	} else {
+		// Feeds the first cell with the next entry and every other cell with the value forwarded by its left neighbour.
+		if (!inputs.empty()) {
+			cells.front()->feed(inputs.front());
+			inputs.pop();
+		} else {
+			cells.front()->feed(std::nullopt);
+		}
+		for (std::size_t i = cells.size() - 1; i != 0; i--) {
+			cells[i]->feed(cells[i - 1]->getPartial());
+		}
+		scheduler.parallelFor(cells.size(), [this](const std::size_t i){ cells[i]->compute(); });
+	}
+}
+
+std::string Systolic::SortArray::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying remaning values waiting in the input queue. */
+	ss << "inputs: ";
+	for (std::queue<int> iCopy = inputs; iCopy.size() > 0; iCopy.pop()) {
+		ss << iCopy.front() << (iCopy.size() != 1 ? ", " : "");
+	}
+	ss << std::endl;
+
+	/* Displaying every cell as [input | held value]. */
+	for (const std::unique_ptr<Systolic::Cell::CompareExchangeCell> &cell : cells) {
+		ss << "[" << std::setw(6) << optionalToString(cell->getInputs())
+		   << " | " << std::setw(6) << optionalToString(cell->getValue()) << "] ";
+	}
+	ss << std::endl << "outputs: ";
+
+	/* Displaying the values stored in the outputs queue. */
+	for (std::queue<int> oCopy = outputs; oCopy.size() > 0; oCopy.pop()) {
+		ss << oCopy.front() << (oCopy.size() != 1 ? ", " : "");
+	}
+	ss << std::endl << std::endl;
+	return ss.str();
+}
+
+std::string Systolic::SortArray::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
@@ -0,0 +1,190 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file Trace.cpp
+ * Implementation of Trace.
+ */
+
+#include "Systolic/Container/Trace.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+	/* Quotes and escapes a string for JSON. */
+	std::string quote(const std::string &str)
+	{
+		std::stringstream ss;
+
+		ss << '"';
+		for (char c : str) {
+			if (c == '"' || c == '\\') {
+				ss << '\\' << c;
+			} else if (static_cast<unsigned char>(c) < 0x20) {
+				ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+				   << std::dec << std::setfill(' ');
+			} else {
+				ss << c;
+			}
+		}
+		ss << '"';
+		return ss.str();
+	}
+}
+
+Systolic::Trace::Trace()
+	: start(std::chrono::steady_clock::now())
+{
+}
+
+double Systolic::Trace::now() const
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::size_t Systolic::Trace::getThreadLane()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = threadLanes.find(std::this_thread::get_id());
+
+	if (it != threadLanes.end()) {
+		return it->second;
+	}
+
+	const std::size_t lane = threadLanes.size();
+
+	threadLanes[std::this_thread::get_id()] = lane;
+	laneNames[std::make_pair(getGroup("threads"), lane)] = "thread " + std::to_string(lane);
+	return lane;
+}
+
+void Systolic::Trace::nameLane(const std::string &group, const std::size_t lane, const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	laneNames[std::make_pair(getGroup(group), lane)] = name;
+}
+
+void Systolic::Trace::span(const std::string &group, const std::size_t lane, const std::string &name,
+			   const double start, const double end, const Args &args)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	events.push_back(Event{'X', name, getGroup(group), lane, start, end - start, args});
+}
+
+void Systolic::Trace::instant(const std::string &group, const std::size_t lane, const std::string &name,
+			      const double timestamp, const Args &args)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	events.push_back(Event{'i', name, getGroup(group), lane, timestamp, 0, args});
+}
+
+void Systolic::Trace::counter(const std::string &name, const double timestamp, const Args &values)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	events.push_back(Event{'C', name, getGroup("container"), 0, timestamp, 0, values});
+}
+
+std::size_t Systolic::Trace::getEventCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return events.size();
+}
+
+void Systolic::Trace::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	events.clear();
+	groups.clear();
+	laneNames.clear();
+	threadLanes.clear();
+}
+
+std::string Systolic::Trace::toJson() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::stringstream ss;
+	const char *separator = "\n";
+
+	ss << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	/* Metadata events naming the processes (groups) and threads (lanes). */
+	for (std::size_t pid = 0; pid != groups.size(); pid++) {
+		ss << separator << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+		   << ",\"tid\":0,\"args\":{\"name\":" << quote(groups[pid]) << "}}";
+		separator = ",\n";
+	}
+	for (const auto &laneName : laneNames) {
+		ss << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << laneName.first.first
+		   << ",\"tid\":" << laneName.first.second << ",\"args\":{\"name\":" << quote(laneName.second) << "}}"
+		   << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":" << laneName.first.first
+		   << ",\"tid\":" << laneName.first.second << ",\"args\":{\"sort_index\":" << laneName.first.second << "}}";
+	}
+	for (const Event &event : events) {
+		ss << separator << "{\"name\":" << quote(event.name) << ",\"ph\":\"" << event.phase
+		   << "\",\"pid\":" << event.group << ",\"tid\":" << event.lane << ",\"ts\":" << event.timestamp;
+		if (event.phase == 'X') {
+			ss << ",\"dur\":" << event.duration;
+		} else if (event.phase == 'i') {
+			ss << ",\"s\":\"t\"";
+		}
+		ss << ",\"args\":{";
+		for (std::size_t i = 0; i != event.args.size(); i++) {
+			ss << (i != 0 ? "," : "") << quote(event.args[i].first) << ":" << event.args[i].second;
+		}
+		ss << "}}";
+		separator = ",\n";
+	}
+	ss << "\n]}\n";
+	return ss.str();
+}
+
+bool Systolic::Trace::save(const std::string &path) const
+{
+	std::ofstream file(path);
+
+	if (!file) {
+		std::cerr << "Err: Cannot open trace file " << path << "." << std::endl;
+		return false;
+	}
+	file << toJson();
+	return static_cast<bool>(file);
+}
+
+/* Privates functions. */
+
+std::size_t Systolic::Trace::getGroup(const std::string &group)
+{
+	for (std::size_t pid = 0; pid != groups.size(); pid++) {
+		if (groups[pid] == group) {
+			return pid;
+		}
+	}
+	groups.push_back(group);
+	return groups.size() - 1;
+}
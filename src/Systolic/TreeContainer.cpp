@@ -0,0 +1,276 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file TreeContainer.cpp
+ * Implementation of TreeContainer.
+ */
+
+#include "Systolic/Container/TreeContainer.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+Systolic::TreeContainer::TreeContainer(const std::queue<int> entries)
+	: tick(0)
+{
+	inputs.reserve(entries.size());
+	for (std::queue<int> copy = entries; !copy.empty(); copy.pop()) {
+		inputs.push(copy.front());
+	}
+}
+
+Systolic::TreeContainer::TreeContainer(const std::initializer_list<const int> entries)
+	: tick(0)
+{
+	inputs.reserve(entries.size());
+	for (int entry : entries) {
+		inputs.push(entry);
+	}
+}
+
+void Systolic::TreeContainer::setCells(std::vector<std::vector<std::unique_ptr<Systolic::Cell::MultiplyAddCell>>> levels)
+{
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		if (levels[l - 1].size() != levels[l].size() * 2) {
+			throw std::invalid_argument("Each level of the tree must have half the cells of the previous one.");
+		}
+	}
+	if (!levels.empty() && levels.back().size() != 1) {
+		throw std::invalid_argument("The last level of the tree must be a single root cell.");
+	}
+	this->levels = std::move(levels);
+	powers.assign(this->levels.size(), std::nullopt);
+}
+
+void Systolic::TreeContainer::setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setCells(builder->buildTree());
+}
+
+void Systolic::TreeContainer::setTrace(std::shared_ptr<Systolic::Trace> trace)
+{
+	this->trace = trace;
+}
+
+void Systolic::TreeContainer::step()
+{
+	if (levels.size() == 0) {
+		std::cerr << "Warn: Cannot compute container step: No cells available." << std::endl;
+		return;
+	}
+
+	const double stepStart = (trace != nullptr ? trace->now() : 0);
+
+	// Moves the powers of X one level up, squaring them (X^(2^l) becomes X^(2^(l+1))).
+	for (std::size_t l = levels.size() - 1; l != 0; l--) {
+		if (powers[l - 1].has_value()) {
+			powers[l] = powers[l - 1].value() * powers[l - 1].value();
+		} else {
+			powers[l] = std::nullopt;
+		}
+	}
+
+	// Feed the inner nodes with the partials (results) of their two children.
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		for (std::size_t i = 0; i != levels[l].size(); i++) {
+			levels[l][i]->feed(levels[l - 1][2 * i]->getPartial(),
+					   levels[l - 1][2 * i + 1]->getPartial(),
+					   powers[l]);
+		}
+	}
+
+	// Feeds the leaves with a value from the inputs queue.
+	if (!inputs.empty()) {
+		if (trace != nullptr) {
+			trace->instant("cells", 0, "inject", stepStart, {{"value", inputs.front()}, {"tick", tick}});
+		}
+		powers[0] = inputs.front();
+		inputs.pop();
+	} else {
+		powers[0] = std::nullopt; // Feeds empty value.
+	}
+	for (std::unique_ptr<Systolic::Cell::MultiplyAddCell> &leaf : levels[0]) {
+		leaf->feed(std::nullopt, std::nullopt, powers[0]);
+	}
+
+	// Cells are traced on lanes numbered level by level, from the first leaf to the root.
+	std::vector<std::size_t> firstLanes(levels.size(), 0);
+
+	for (std::size_t l = 1; l < levels.size(); l++) {
+		firstLanes[l] = firstLanes[l - 1] + levels[l - 1].size();
+	}
+	if (trace != nullptr) {
+		long long active = 0;
+
+		for (std::size_t l = 0; l != levels.size(); l++) {
+			for (std::size_t i = 0; i != levels[l].size(); i++) {
+				trace->nameLane("cells", firstLanes[l] + i, "level " + std::to_string(l) + " cell " + std::to_string(i));
+				active += std::get<2>(levels[l][i]->getInputs()).has_value();
+			}
+		}
+		trace->counter("active cells", stepStart, {{"active", active}, {"idle", firstLanes.back() + 1 - active}});
+		trace->counter("queue depth", stepStart, {{"inputs", inputs.size()}, {"outputs", outputs.size()}});
+	}
+
+	// Compute the current value of each level, the levels being spread over the scheduler.
+	Systolic::Backend::Scheduler::getInstance().parallelFor(levels.size(), [this, &firstLanes](const std::size_t l){
+			for (std::size_t i = 0; i != levels[l].size(); i++) {
+				const double start = (trace != nullptr ? trace->now() : 0);
+
+				levels[l][i]->compute();
+				if (trace != nullptr) {
+					const double end = trace->now();
+					const bool busy = std::get<2>(levels[l][i]->getInputs()).has_value();
+
+					trace->span("cells", firstLanes[l] + i, (busy ? "compute" : "idle"), start, end, {{"tick", tick}});
+					trace->span("threads", trace->getThreadLane(), "level " + std::to_string(l),
+						    start, end, {{"tick", tick}});
+				}
+			}
+		});
+
+	// Add the root partial (final result) to the output queue if available.
+	std::optional<int> rootOutput = levels.back().front()->getPartial();
+
+	if (rootOutput.has_value()) {
+		outputs.push(rootOutput.value());
+	}
+	if (trace != nullptr) {
+		const double stepEnd = trace->now();
+
+		if (rootOutput.has_value()) {
+			trace->instant("cells", firstLanes.back(), "output", stepEnd, {{"value", rootOutput.value()}, {"tick", tick}});
+		}
+		trace->nameLane("container", 0, "steps");
+		trace->span("container", 0, "step " + std::to_string(tick), stepStart, stepEnd, {{"tick", tick}});
+	}
+	tick++;
+}
+
+void Systolic::TreeContainer::compute()
+{
+	std::size_t ioSize = inputs.size();
+
+	if (levels.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (ioSize == 0) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	outputs.reserve(outputs.size() + ioSize);
+	do {
+		logs.push_back(makeLogEntry());
+		step();
+	} while (outputs.size() != ioSize);
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::TreeContainer::dumpOutputs() const
+{
+	Util::OutputWriter(Util::OutputFormat::Comma).write(outputs.view());
+}
+
+std::queue<int> Systolic::TreeContainer::getOutputs() const
+{
+	return outputs.toQueue();
+}
+
+Util::RingView<int> Systolic::TreeContainer::getOutputView() const
+{
+	return outputs.view();
+}
+
+std::size_t Systolic::TreeContainer::getDepth() const
+{
+	return levels.size();
+}
+
+std::string Systolic::TreeContainer::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::TreeContainer::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+std::string Systolic::TreeContainer::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying remaning values waiting in the input queue. */
+	ss << "inputs: ";
+	writeValues(ss, inputs.view());
+	ss << std::endl << std::endl;
+
+	/* Displaying each level with its power of X, then every cell as (L, H) | description | partial. */
+	for (std::size_t l = 0; l != levels.size(); l++) {
+		ss << "level " << l << " (P = " << optionalToString(powers[l]) << ")" << std::endl;
+		for (const std::unique_ptr<Systolic::Cell::MultiplyAddCell> &cell : levels[l]) {
+			ss << std::setw(8) << optionalToString(std::get<0>(cell->getInputs())) << ", "
+			   << std::setw(8) << std::left << optionalToString(std::get<1>(cell->getInputs())) << std::right
+			   << " -- | " << std::setw(16) << std::left << cell->getCellDescription() << std::right
+			   << " | -- " << optionalToString(cell->getPartial())
+			   << std::endl;
+		}
+		ss << std::endl;
+	}
+	ss << "outputs: ";
+
+	/* Displaying the values stored in the outputs queue. */
+	writeValues(ss, outputs.view());
+	ss << std::endl;
+
+	return ss.str();
+}
+
+void Systolic::TreeContainer::writeValues(std::stringstream &ss, const Util::RingView<int> &values) const
+{
+	for (std::size_t i = 0; i != values.size(); i++) {
+		ss << values[i] << (i + 1 != values.size() ? ", " : "");
+	}
+}
+
+std::string Systolic::TreeContainer::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
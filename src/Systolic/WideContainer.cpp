@@ -0,0 +1,267 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file WideContainer.cpp
+ * Implementation of WideContainer.
+ */
+
+#include "Systolic/Container/WideContainer.hpp"
+#include "Systolic/Backend/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+Systolic::WideContainer::WideContainer(const std::queue<int> entries)
+	: tick(0)
+{
+	inputs = entries;
+}
+
+Systolic::WideContainer::WideContainer(const std::initializer_list<const int> entries)
+	: tick(0)
+{
+	for (int entry : entries) {
+		inputs.push(entry);
+	}
+}
+
+void Systolic::WideContainer::setCells(std::vector<std::unique_ptr<Systolic::Cell::WidePolynomialCell>> cells)
+{
+	for (const std::unique_ptr<Systolic::Cell::WidePolynomialCell> &cell : cells) {
+		if (cell == nullptr || cell->getWidth() != cells.front()->getWidth()) {
+			throw std::invalid_argument("Every wide cell must hold as many polynomials.");
+		}
+	}
+	this->cells = std::move(cells);
+	outputs.assign(this->cells.empty() ? 0 : this->cells.front()->getWidth(), std::queue<int>());
+}
+
+void Systolic::WideContainer::setCells(std::shared_ptr<Systolic::CellArrayBuilder> builder)
+{
+	if (builder == nullptr) {
+		throw std::invalid_argument("Builder is NULL.");
+	}
+	setCells(builder->buildWide());
+}
+
+void Systolic::WideContainer::step()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Warn: Cannot compute container step: No cells available." << std::endl;
+		return;
+	}
+
+	// Feed all cells but the first with the X and sums of the previous cell, from the last one.
+	for (std::size_t i = cells.size() - 1; i != 0; i--) {
+		cells[i]->feed(cells[i - 1]->getPartial(), cells[i - 1]->getSums());
+	}
+
+	// Feeds the first cell with a value from the inputs queue.
+	if (!inputs.empty()) {
+		cells[0]->feed(inputs.front(), {});
+		inputs.pop();
+	} else {
+		cells[0]->feed(std::nullopt, {}); // Feeds empty value.
+	}
+
+	// Compute the current values of each cell, spread over the scheduler.
+	Systolic::Backend::Scheduler::getInstance().parallelFor(cells.size(), [this](const std::size_t i){
+			cells[i]->compute();
+		});
+
+	// Add the sums of the last cell (final results) to the output queue of each polynomial.
+	if (cells.back()->getPartial().has_value()) {
+		const std::vector<int> &sums = cells.back()->getSums();
+
+		for (std::size_t m = 0; m != sums.size(); m++) {
+			outputs[m].push(sums[m]);
+		}
+	}
+	tick++;
+}
+
+void Systolic::WideContainer::compute()
+{
+	std::size_t ioSize = inputs.size() + (outputs.empty() ? 0 : outputs.front().size());
+
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (inputs.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+	do {
+		logs.push_back(makeLogEntry());
+		step();
+	} while (outputs.front().size() != ioSize);
+	logs.push_back(makeLogEntry());
+}
+
+void Systolic::WideContainer::computeBatch()
+{
+	if (cells.size() == 0) {
+		std::cerr << "Err: Cannot compute container: No cells available." << std::endl;
+		return;
+	}
+	if (inputs.empty()) {
+		std::cerr << "Err: No inputs available." << std::endl;
+		return;
+	}
+
+	const std::size_t width = cells.front()->getWidth();
+	std::vector<std::uint32_t> xs;
+	/* Coefficients by degree then by polynomial, and results by polynomial then by X, as unsigned values to wrap around. */
+	std::vector<std::uint32_t> coefs;
+	std::vector<std::uint32_t> results;
+
+	for (; !inputs.empty(); inputs.pop()) {
+		xs.push_back(static_cast<std::uint32_t>(inputs.front()));
+	}
+	for (const std::unique_ptr<Systolic::Cell::WidePolynomialCell> &cell : cells) {
+		coefs.insert(coefs.end(), cell->getCoefs().begin(), cell->getCoefs().end());
+	}
+	results.resize(width * xs.size());
+
+	/* Blocks of X are spread over the scheduler, each with the sums of its X laid out next to each other. */
+	constexpr std::size_t blockSize = 64;
+	const std::size_t blocks = (xs.size() + blockSize - 1) / blockSize;
+
+	Systolic::Backend::Scheduler::getInstance().parallelFor(blocks, [&](const std::size_t b){
+			std::vector<std::uint32_t> sums(blockSize * width, 0);
+			const std::size_t start = b * blockSize;
+			const std::size_t count = std::min(blockSize, xs.size() - start);
+
+			for (std::size_t k = 0; k != cells.size(); k++) {
+				const std::uint32_t *c = coefs.data() + k * width;
+
+				for (std::size_t i = 0; i != count; i++) {
+					const std::uint32_t x = xs[start + i];
+					std::uint32_t *s = sums.data() + i * width;
+
+					for (std::size_t m = 0; m != width; m++) {
+						s[m] = s[m] * x + c[m];
+					}
+				}
+			}
+			for (std::size_t i = 0; i != count; i++) {
+				for (std::size_t m = 0; m != width; m++) {
+					results[m * xs.size() + start + i] = sums[i * width + m];
+				}
+			}
+		});
+	for (std::size_t m = 0; m != width; m++) {
+		for (std::size_t i = 0; i != xs.size(); i++) {
+			outputs[m].push(static_cast<int>(results[m * xs.size() + i]));
+		}
+	}
+}
+
+void Systolic::WideContainer::dumpOutputs() const
+{
+	for (std::queue<int> copy : outputs) {
+		while (!copy.empty()) {
+			std::cout << copy.front() << (copy.size() > 1 ? "," : "");
+			copy.pop();
+		}
+		std::cout << std::endl;
+	}
+}
+
+std::vector<std::queue<int>> Systolic::WideContainer::getOutputs() const
+{
+	return outputs;
+}
+
+std::size_t Systolic::WideContainer::getWidth() const
+{
+	return outputs.size();
+}
+
+std::string Systolic::WideContainer::getCurrentStateLog() const
+{
+	return logs.back();
+}
+
+std::string Systolic::WideContainer::getLog() const
+{
+	std::stringstream ss;
+
+	for (std::string entry : logs) {
+		ss << entry;
+	}
+	return ss.str();
+}
+
+/* Privates functions. */
+
+std::string Systolic::WideContainer::makeLogEntry() const
+{
+	std::stringstream ss;
+
+	/* Step header. */
+	ss << "###################"
+	   << std::endl
+	   << "# Step No. "
+	   << std::setw(6) << std::right << logs.size() << " #"
+	   << std::endl
+	   << "###################"
+	   << std::endl;
+
+	/* Displaying remaning values waiting in the input queue. */
+	ss << "inputs: ";
+	for (std::queue<int> iCopy = inputs; iCopy.size() > 0; iCopy.pop()) {
+		ss << iCopy.front() << (iCopy.size() != 1 ? ", " : "");
+	}
+	ss << std::endl << std::endl;
+
+	/* Displaying every cell as X -- | description | -- X [sums]. */
+	for (const std::unique_ptr<Systolic::Cell::WidePolynomialCell> &cell : cells) {
+		ss << std::setw(8) << optionalToString(cell->getInput())
+		   << " -- | " << std::setw(16) << std::left << cell->getCellDescription() << std::right
+		   << " | -- " << optionalToString(cell->getPartial()) << " [";
+		for (std::size_t m = 0; m != cell->getSums().size(); m++) {
+			ss << cell->getSums()[m] << (m + 1 != cell->getSums().size() ? ", " : "");
+		}
+		ss << "]" << std::endl;
+	}
+	ss << std::endl;
+
+	/* Displaying the values stored in the outputs queue of each polynomial. */
+	for (std::size_t m = 0; m != outputs.size(); m++) {
+		ss << "outputs " << m << ": ";
+		for (std::queue<int> oCopy = outputs[m]; oCopy.size() > 0; oCopy.pop()) {
+			ss << oCopy.front() << (oCopy.size() != 1 ? ", " : "");
+		}
+		ss << std::endl;
+	}
+
+	return ss.str();
+}
+
+std::string Systolic::WideContainer::optionalToString(std::optional<int> value) const
+{
+	if (value.has_value()) {
+		return std::to_string(value.value());
+	} else {
+		return "{}";
+	}
+}
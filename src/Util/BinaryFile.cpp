@@ -0,0 +1,193 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file BinaryFile.cpp
+ * Implementation of BinaryWriter and BinaryReader.
+ */
+
+#include "Util/BinaryFile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+# include <fcntl.h>
+# include <io.h>
+# include <sys/stat.h>
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+void Util::BinaryWriter::putBytes(const void *bytes, const std::size_t size)
+{
+	const unsigned char *begin = static_cast<const unsigned char *>(bytes);
+
+	buffer.insert(buffer.end(), begin, begin + size);
+}
+
+void Util::BinaryWriter::putString(const std::string &value)
+{
+	put(static_cast<std::uint32_t>(value.size()));
+	putBytes(value.data(), value.size());
+}
+
+std::size_t Util::BinaryWriter::getSize() const
+{
+	return buffer.size();
+}
+
+bool Util::BinaryWriter::commit(const std::string &path) const
+{
+	const std::string temporary = path + ".tmp";
+	std::size_t done = 0;
+
+#ifdef _WIN32
+	const int fd = ::_open(temporary.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+
+	if (fd == -1) {
+		std::cerr << "Err: Cannot open file " << temporary << "." << std::endl;
+		return false;
+	}
+	while (done != buffer.size()) {
+#ifdef _WIN32
+		const int count = ::_write(fd, buffer.data() + done, static_cast<unsigned>(std::min<std::size_t>(buffer.size() - done, 1 << 30)));
+#else
+		const ssize_t count = ::write(fd, buffer.data() + done, buffer.size() - done);
+#endif
+
+		if (count <= 0) {
+			break;
+		}
+		done += static_cast<std::size_t>(count);
+	}
+
+	// The data must reach the disk before the rename does, or a crash could leave an empty file behind.
+#ifdef _WIN32
+	const bool synced = (::_commit(fd) == 0);
+
+	::_close(fd);
+#else
+	const bool synced = (::fsync(fd) == 0);
+
+	::close(fd);
+#endif
+	if (done != buffer.size() || !synced) {
+		std::cerr << "Err: Cannot write file " << temporary << "." << std::endl;
+		std::remove(temporary.c_str());
+		return false;
+	}
+#ifdef _WIN32
+	const bool renamed = MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	const bool renamed = (std::rename(temporary.c_str(), path.c_str()) == 0);
+#endif
+	if (!renamed) {
+		std::cerr << "Err: Cannot replace file " << path << "." << std::endl;
+		std::remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool Util::BinaryWriter::writeAt(const std::string &path, const std::uint64_t offset) const
+{
+	std::size_t done = 0;
+
+#ifdef _WIN32
+	const int fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+#endif
+
+	if (fd == -1) {
+		std::cerr << "Err: Cannot open file " << path << "." << std::endl;
+		return false;
+	}
+
+	// Bytes past the offset were written after the last size recorded, by a process killed meanwhile.
+#ifdef _WIN32
+	bool positioned = (::_chsize_s(fd, static_cast<__int64>(offset)) == 0 && ::_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) != -1);
+#else
+	bool positioned = (::ftruncate(fd, static_cast<off_t>(offset)) == 0 && ::lseek(fd, static_cast<off_t>(offset), SEEK_SET) != -1);
+#endif
+
+	while (positioned && done != buffer.size()) {
+#ifdef _WIN32
+		const int count = ::_write(fd, buffer.data() + done, static_cast<unsigned>(std::min<std::size_t>(buffer.size() - done, 1 << 30)));
+#else
+		const ssize_t count = ::write(fd, buffer.data() + done, buffer.size() - done);
+#endif
+
+		if (count <= 0) {
+			break;
+		}
+		done += static_cast<std::size_t>(count);
+	}
+#ifdef _WIN32
+	const bool synced = (::_commit(fd) == 0);
+
+	::_close(fd);
+#else
+	const bool synced = (::fsync(fd) == 0);
+
+	::close(fd);
+#endif
+	if (!positioned || done != buffer.size() || !synced) {
+		std::cerr << "Err: Cannot write file " << path << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+Util::BinaryReader::BinaryReader(const unsigned char *data, const std::size_t size)
+	: data(data), size(size), offset(0)
+{
+}
+
+std::string Util::BinaryReader::getString()
+{
+	const std::uint32_t length = get<std::uint32_t>();
+	const unsigned char *bytes = skip(length);
+
+	return std::string(reinterpret_cast<const char *>(bytes), length);
+}
+
+const unsigned char *Util::BinaryReader::skip(const std::size_t size)
+{
+	if (size > this->size - offset) {
+		throw std::runtime_error("Truncated file.");
+	}
+
+	const unsigned char *bytes = data + offset;
+
+	offset += size;
+	return bytes;
+}
+
+std::size_t Util::BinaryReader::getRemaining() const
+{
+	return size - offset;
+}
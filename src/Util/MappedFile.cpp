@@ -0,0 +1,124 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file MappedFile.cpp
+ * Implementation of MappedFile.
+ */
+
+#include "Util/MappedFile.hpp"
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#ifdef _WIN32
+Util::MappedFile::MappedFile(const std::string &path)
+	: data(nullptr), size(0), open(false)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+				  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	LARGE_INTEGER fileSize;
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	if (GetFileSizeEx(file, &fileSize)) {
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+		if (size == 0) {
+			open = true;
+		} else {
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (mapping != nullptr) {
+				data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				open = (data != nullptr);
+				CloseHandle(mapping); // The view holds its own reference to the mapping.
+			}
+		}
+	}
+	CloseHandle(file);
+	if (!open) {
+		size = 0;
+	}
+}
+
+Util::MappedFile::~MappedFile()
+{
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+}
+#else
+Util::MappedFile::MappedFile(const std::string &path)
+	: data(nullptr), size(0), open(false)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat status;
+
+	if (fd == -1) {
+		return;
+	}
+	if (::fstat(fd, &status) == 0) {
+		size = static_cast<std::size_t>(status.st_size);
+		if (size == 0) {
+			open = true;
+		} else {
+			void *address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (address != MAP_FAILED) {
+				::madvise(address, size, MADV_SEQUENTIAL); // Read ahead, the file being scanned in order.
+				data = static_cast<const unsigned char *>(address);
+				open = true;
+			}
+		}
+	}
+	::close(fd); // The mapping holds its own reference to the file.
+	if (!open) {
+		size = 0;
+	}
+}
+
+Util::MappedFile::~MappedFile()
+{
+	if (data != nullptr) {
+		::munmap(const_cast<unsigned char *>(data), size);
+	}
+}
+#endif
+
+bool Util::MappedFile::isOpen() const
+{
+	return open;
+}
+
+const unsigned char *Util::MappedFile::getData() const
+{
+	return data;
+}
+
+std::size_t Util::MappedFile::getSize() const
+{
+	return size;
+}
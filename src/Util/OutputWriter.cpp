@@ -0,0 +1,201 @@
+// Copyright 2019 Régis Berthelot
+
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+/**
+ * @file OutputWriter.cpp
+ * Implementation of OutputWriter.
+ */
+
+#include "Util/OutputWriter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+# include <fcntl.h>
+# include <io.h>
+# include <sys/stat.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+Util::OutputFormat Util::OutputWriter::parseFormat(const std::string &name)
+{
+	if (name == "comma") {
+		return OutputFormat::Comma;
+	} else if (name == "newline") {
+		return OutputFormat::Newline;
+	} else if (name == "csv") {
+		return OutputFormat::Csv;
+	} else if (name == "binary") {
+		return OutputFormat::Binary;
+	}
+	throw std::invalid_argument("Unknown output format: " + name + ".");
+}
+
+Util::OutputWriter::OutputWriter(const OutputFormat format, const int fd)
+	: format(format), fd(fd), owned(false), failed(false), buffer(bufferSize), used(0), written(0)
+{
+}
+
+Util::OutputWriter::OutputWriter(const OutputFormat format, const std::string &path)
+	: format(format), fd(-1), owned(true), failed(false), buffer(bufferSize), used(0), written(0)
+{
+#ifdef _WIN32
+	fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+}
+
+Util::OutputWriter::~OutputWriter()
+{
+	if (fd != -1) {
+		flush();
+	}
+	if (owned && fd != -1) {
+#ifdef _WIN32
+		::_close(fd);
+#else
+		::close(fd);
+#endif
+	}
+}
+
+bool Util::OutputWriter::isOpen() const
+{
+	return fd != -1;
+}
+
+void Util::OutputWriter::write(const Util::RingView<int> &outputs, const Util::RingView<int> &inputs)
+{
+	switch (format) {
+	case OutputFormat::Comma:
+		for (std::size_t i = 0; i != outputs.size(); i++) {
+			reserve(maxValueSize);
+			append(outputs[i]);
+			if (i + 1 != outputs.size()) {
+				append(',');
+			}
+		}
+		reserve(1);
+		append('\n');
+		break;
+	case OutputFormat::Newline:
+		for (std::size_t i = 0; i != outputs.size(); i++) {
+			reserve(maxValueSize);
+			append(outputs[i]);
+			append('\n');
+		}
+		break;
+	case OutputFormat::Csv:
+		reserve(4);
+		std::memcpy(buffer.data() + used, "x,y\n", 4);
+		used += 4;
+		for (std::size_t i = 0; i != outputs.size(); i++) {
+			reserve(2 * maxValueSize);
+			if (i < inputs.size()) {
+				append(inputs[i]);
+			}
+			append(',');
+			append(outputs[i]);
+			append('\n');
+		}
+		break;
+	case OutputFormat::Binary:
+		/* Each segment of the view is contiguous, and so copied as a whole. */
+		for (const auto &segment : {std::make_pair(outputs.getFirstSegment(), outputs.getFirstSize()),
+					    std::make_pair(outputs.getSecondSegment(), outputs.getSecondSize())}) {
+			const char *bytes = reinterpret_cast<const char *>(segment.first);
+			std::size_t size = segment.second * sizeof(int);
+
+			while (size != 0) {
+				reserve(std::min(size, bufferSize));
+
+				const std::size_t chunk = std::min(size, buffer.size() - used);
+
+				std::memcpy(buffer.data() + used, bytes, chunk);
+				used += chunk;
+				bytes += chunk;
+				size -= chunk;
+			}
+		}
+		break;
+	}
+}
+
+bool Util::OutputWriter::flush()
+{
+	if (fd == 1) {
+		std::cout.flush();
+	}
+
+	std::size_t offset = 0;
+
+	while (offset != used && !failed) {
+#ifdef _WIN32
+		const int count = ::_write(fd, buffer.data() + offset, static_cast<unsigned int>(used - offset));
+#else
+		const ssize_t count = ::write(fd, buffer.data() + offset, used - offset);
+#endif
+
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+		if (count <= 0) {
+			std::cerr << "Err: Cannot write outputs: " << std::strerror(errno) << "." << std::endl;
+			failed = true;
+			break;
+		}
+		offset += static_cast<std::size_t>(count);
+	}
+	written += offset;
+	used = 0;
+	return !failed;
+}
+
+std::size_t Util::OutputWriter::getWrittenBytes() const
+{
+	return written + used;
+}
+
+/* Privates functions. */
+
+void Util::OutputWriter::reserve(const std::size_t bytes)
+{
+	if (buffer.size() - used < bytes) {
+		flush();
+	}
+}
+
+void Util::OutputWriter::append(const int value)
+{
+	used = static_cast<std::size_t>(std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data());
+}
+
+void Util::OutputWriter::append(const char c)
+{
+	buffer[used++] = c;
+}
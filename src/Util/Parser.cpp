@@ -24,10 +24,23 @@
 
 #include "Util/Parser.hpp"
 
+#include <algorithm>
+#include <array>
+
+namespace {
+
+	const char *intListPattern = "^-?[0-9]+((,-?[0-9]+)?)+$"; // Matches list of (possibly negative) integers separated by comme.
+	const char *equationPattern = "^[\\dxX\\-]((\\d+)?[\\*+\\-]?[xX]?(\\^\\d)?)+$";
+	const std::array<const char *, 5> pipelineSources = {"--coefs", "--equation", "--pipeline", "--pipeline-file",
+							     "--load-pipeline"}; // Options giving the cells, one at most.
+}
+
 bool Util::Parser::setArgs(std::unordered_map<std::string, std::string> &map, char **args)
 {
-	std::regex intListRegex("^-?[0-9]+((,-?[0-9]+)?)+$"); // Matches list of (possibly negative) integers separated by comme.
-	std::regex equationRegex("^[\\dxX\\-]((\\d+)?[\\*+\\-]?[xX]?(\\^\\d)?)+$");
+	std::regex intListRegex(intListPattern);
+	std::regex decimalListRegex("^-?[0-9]+(\\.[0-9]+)?(,-?[0-9]+(\\.[0-9]+)?)*$"); // Same, with optional decimals.
+	std::regex equationRegex(equationPattern);
+	std::regex unsignedRegex("^[0-9]+$");
 	
 	for (unsigned int i = 1; args[i] != nullptr; i++) {
 		std::string arg = args[i];
@@ -39,26 +52,65 @@ bool Util::Parser::setArgs(std::unordered_map<std::string, std::string> &map, ch
 			return false;
 		} else if (token != value) { // token == value when the option is standalone, like --help.
 			if ((token == "--coefs" || token == "--with-x")
-			    && !std::regex_match(value, intListRegex)) {
-				throw std::invalid_argument(std::string("Value of ") + token + " is not a valid list of interger.");
+			    && !std::regex_match(value, decimalListRegex)) {
+				throw std::invalid_argument(std::string("Value of ") + token + " is not a valid list of numbers.");
 			} else if (token == "--equation" && !std::regex_match(value, equationRegex)) {
 				throw std::invalid_argument("Value of --equation does not match the /^[\\dxX\\-]((\\d+)?[\\*+\\-]?[xX]?(\\^\\d)?)+$/ regex.");
+			} else if (token == "--topology" && value != "linear" && value != "tree") {
+				throw std::invalid_argument("Value of --topology must be either linear or tree.");
+			} else if ((token == "--hash-window" || token == "--hash-base" || token == "--hash-modulus"
+				    || token == "--cost-inputs")
+				   && !std::regex_match(value, unsignedRegex)) {
+				throw std::invalid_argument(std::string("Value of ") + token + " is not a valid unsigned integer.");
+			} else if (token == "--reduction" && value != "montgomery" && value != "barrett") {
+				throw std::invalid_argument("Value of --reduction must be either montgomery or barrett.");
+			} else if (token == "--type" && value != "int32" && value != "int64" && value != "double" && value != "fixed") {
+				throw std::invalid_argument("Value of --type must be one of int32, int64, double or fixed.");
+			} else if (token == "--progress" && value != "true" && value != "false") {
+				throw std::invalid_argument("Value of --progress must be either true or false.");
+			} else if (token == "--checkpoint-steps" && (!std::regex_match(value, unsignedRegex) || std::stoull(value) == 0)) {
+				throw std::invalid_argument("Value of --checkpoint-steps must be a positive integer.");
+			} else if (token == "--output-format" && value != "comma" && value != "newline" && value != "csv"
+				   && value != "binary") {
+				throw std::invalid_argument("Value of --output-format must be one of comma, newline, csv or binary.");
 			}
 			map[token] = value;
 		}
 	}
-	if (map["--coefs"].empty() && map["--equation"].empty()) {
-		std::cerr << "Error: Missing --coefs or --equation options." << std::endl;
-		return false;
+	if (!map["--hash-file"].empty() || !map["--jobs-file"].empty()) { // Hashing a file or running jobs needs no polynomial.
+		return true;
 	}
-	if (map["--with-x"].empty()) {
-		std::cerr << "Error: Missing --with-x option." << std::endl;
+	const std::size_t sources = std::count_if(pipelineSources.begin(), pipelineSources.end(),
+						  [&map](const char *token) { return !map[token].empty(); });
+
+	if (sources == 0) {
+		std::cerr << "Error: Missing --coefs, --equation, --pipeline, --pipeline-file or --load-pipeline options." << std::endl;
 		return false;
 	}
 	if (!map["--coefs"].empty() && !map["--equation"].empty()) {
 		std::cerr << "Error: Cannot use both --coefs and --equation options at the same time." << std::endl;
 		return false;
 	}
+	if (sources > 1) {
+		std::cerr << "Error: Cannot use more than one of --coefs, --equation, --pipeline, --pipeline-file and --load-pipeline."
+			  << std::endl;
+		return false;
+	}
+	if (map["--with-x"].empty() && map["--save-pipeline"].empty() && map["--cost-inputs"].empty()) { // Saving a pipeline, or modeling its cost, needs no X.
+		std::cerr << "Error: Missing --with-x option." << std::endl;
+		return false;
+	}
+	if (!map["--type"].empty() && map["--type"] != "int32" && !map["--equation"].empty()) { // Typed containers only take coefficients.
+		std::cerr << "Error: --equation is only available with --type=int32." << std::endl;
+		return false;
+	}
+	if (map["--type"].empty() || map["--type"] == "int32" || map["--type"] == "int64") { // Decimals are only known once the type is.
+		for (const std::string token : {"--coefs", "--with-x"}) {
+			if (!map[token].empty() && !std::regex_match(map[token], intListRegex)) {
+				throw std::invalid_argument(std::string("Value of ") + token + " is not a valid list of interger.");
+			}
+		}
+	}
 	return true;
 }
 
@@ -79,13 +131,100 @@ bool Util::Parser::displayInfo(std::unordered_map<std::string, std::string> &map
 
 std::queue<int> Util::Parser::listToQueue(std::string strList)
 {
-	std::size_t pos = 0;
 	std::queue<int> res;
 
+	for (const std::string &item : splitList(strList)) {
+		res.push(std::atoi(item.c_str()));
+	}
+	return res;
+}
+
+std::vector<std::string> Util::Parser::splitList(std::string strList)
+{
+	std::size_t pos = 0;
+	std::vector<std::string> res;
+
 	while ((pos = strList.find(',')) != std::string::npos) {
-		res.push(std::atoi(strList.substr(0, pos).c_str()));
+		res.push_back(strList.substr(0, pos));
 		strList.erase(0, pos + 1);
 	}
-	res.push(std::atoi(strList.c_str()));
+	res.push_back(strList);
 	return res;
 }
+
+bool Util::Parser::readJobs(const std::string &path, std::vector<std::unordered_map<std::string, std::string>> &jobs)
+{
+	std::regex intListRegex(intListPattern);
+	std::regex equationRegex(equationPattern);
+	std::ifstream file(path);
+	std::string line;
+
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot open jobs file " << path << "." << std::endl;
+		return false;
+	}
+	for (std::size_t lineNo = 1; std::getline(file, line); lineNo++) {
+		const std::size_t first = line.find_first_not_of(" \t\r");
+		std::istringstream words(line);
+		std::unordered_map<std::string, std::string> job;
+		std::string arg;
+
+		if (first == std::string::npos || line[first] == '#') { // Blank lines and comments.
+			continue;
+		}
+		while (words >> arg) {
+			const std::string token = arg.substr(0, arg.find('='));
+			const std::string value = (arg.find('=') != std::string::npos ? arg.substr(arg.find('=') + 1) : "");
+			std::string error;
+
+			if (token != "--coefs" && token != "--equation" && token != "--with-x" && token != "--with-x-file") {
+				error = "Unknown option: " + token;
+			} else if ((token == "--coefs" || token == "--with-x") && !std::regex_match(value, intListRegex)) {
+				error = "Value of " + token + " is not a valid list of interger.";
+			} else if (token == "--equation" && !std::regex_match(value, equationRegex)) {
+				error = "Value of --equation is not a valid equation.";
+			} else if (token == "--with-x-file" && value.empty()) {
+				error = "Value of --with-x-file is empty.";
+			}
+			if (!error.empty()) {
+				std::cerr << "Error: " << path << ":" << lineNo << ": " << error << std::endl;
+				return false;
+			}
+			job[token] = value;
+		}
+		if (job.count("--coefs") == job.count("--equation") || job.count("--with-x") == job.count("--with-x-file")) {
+			std::cerr << "Error: " << path << ":" << lineNo
+				  << ": A job needs either --coefs or --equation, and either --with-x or --with-x-file." << std::endl;
+			return false;
+		}
+		jobs.push_back(job);
+	}
+	return true;
+}
+
+bool Util::Parser::readValues(const std::string &path, std::queue<int> &values)
+{
+	std::ifstream file(path);
+	std::string word;
+
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot open input file " << path << "." << std::endl;
+		return false;
+	}
+	while (file >> word) {
+		for (const std::string &item : splitList(word)) {
+			char *end = nullptr;
+			const long value = std::strtol(item.c_str(), &end, 10);
+
+			if (item.empty()) {
+				continue; // Trailing commas.
+			}
+			if (*end != '\0' || value < INT_MIN || value > INT_MAX) {
+				std::cerr << "Error: " << path << ": " << item << " is not a valid integer." << std::endl;
+				return false;
+			}
+			values.push(static_cast<int>(value));
+		}
+	}
+	return true;
+}
@@ -19,8 +19,152 @@
 
 #include "Systolic/Systolic.hpp"
 #include "Util/Parser.hpp"
+#include "Util/MappedFile.hpp"
+#include "Util/OutputWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <initializer_list>
+#include <memory>
 #include <unordered_map>
 
+/** Token cancelled on SIGINT while a computation reports its progress. */
+static Systolic::CancellationToken interruption;
+
+static void interrupt(int)
+{
+	interruption.cancel();
+}
+
+/**
+ * Reject the options a mode does not use, rather than silently ignoring them.
+ * @param defaults Values of the options before parsing the arguments.
+ * @param mode Option selecting the mode, as shown by the error.
+ * @param used Options used by the mode.
+ * @return false, after reporting it, if an option out of used was given a value other than its default.
+ */
+static bool checkOptions(const std::unordered_map<std::string, std::string> &args,
+			 const std::unordered_map<std::string, std::string> &defaults, const std::string &mode,
+			 const std::initializer_list<std::string> used)
+{
+	for (const std::pair<const std::string, std::string> &option : args) {
+		const auto found = defaults.find(option.first);
+
+		if (option.second != (found == defaults.end() ? "" : found->second)
+		    && std::find(used.begin(), used.end(), option.first) == used.end()) {
+			std::cerr << "Err: " << option.first << " is not available with " << mode << "." << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Evaluate the polynomial of the --coefs option over values of type T.
+ * @return The exit status of the program.
+ */
+template <typename T>
+static int computeTyped(std::unordered_map<std::string, std::string> &args, const std::unordered_map<std::string, std::string> &defaults)
+{
+	std::queue<T> xs;
+	std::queue<T> coefs;
+
+	if (!checkOptions(args, defaults, "--type=" + args["--type"], {"--type", "--coefs", "--with-x", "--verbose"})) {
+		return EXIT_FAILURE;
+	}
+	for (const std::string &x : Util::Parser::splitList(args["--with-x"])) {
+		xs.push(Systolic::Backend::ValueTraits<T>::parse(x));
+	}
+	for (const std::string &coef : Util::Parser::splitList(args["--coefs"])) {
+		coefs.push(Systolic::Backend::ValueTraits<T>::parse(coef));
+	}
+
+	Systolic::BasicContainer<T> container(xs);
+
+	container.setCells(Systolic::BasicCellArrayBuilder<T>::getNew()->fromPolynomialCoefs(coefs));
+	if (args["--verbose"] == "true") {
+		container.compute();
+		std::cout << container.getLog();
+	} else {
+		container.computeBatch();
+		container.dumpOutputs();
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * Run every job of the --jobs-file option, each on its own container.
+ * Writes the results in the order of the jobs, then the timing of each
+ * job on the error output.
+ * @return The exit status of the program.
+ */
+static int runJobs(std::unordered_map<std::string, std::string> &args)
+{
+	std::vector<std::unordered_map<std::string, std::string>> specs;
+	std::vector<Systolic::Job> jobs;
+
+	if (!Util::Parser::readJobs(args["--jobs-file"], specs)) {
+		return EXIT_FAILURE;
+	}
+	for (std::unordered_map<std::string, std::string> &spec : specs) {
+		Systolic::Job job;
+
+		if (!spec["--coefs"].empty()) {
+			job.coefs = Util::Parser::listToQueue(spec["--coefs"]);
+		} else {
+			job.equation = spec["--equation"];
+		}
+		if (spec["--with-x-file"].empty()) {
+			job.inputs = Util::Parser::listToQueue(spec["--with-x"]);
+		} else if (!Util::Parser::readValues(spec["--with-x-file"], job.inputs)) {
+			return EXIT_FAILURE;
+		}
+		jobs.push_back(std::move(job));
+	}
+
+	const Systolic::JobRunner runner;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const std::vector<Systolic::JobResult> results = runner.run(jobs);
+	const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	Util::OutputWriter writer(Util::OutputWriter::parseFormat(args["--output-format"]));
+	bool failed = false;
+	double total = 0;
+
+	for (std::size_t j = 0; j != results.size(); j++) {
+		std::vector<int> inputs;
+
+		for (std::queue<int> copy = jobs[j].inputs; !copy.empty(); copy.pop()) {
+			inputs.push_back(copy.front());
+		}
+		if (!results[j].error.empty()) {
+			writer.flush();
+			std::cerr << "Err: Job " << j + 1 << ": " << results[j].error << std::endl;
+			failed = true;
+		}
+		writer.write(Util::RingView<int>(results[j].outputs.data(), results[j].outputs.size(), nullptr, 0),
+			     Util::RingView<int>(inputs.data(), inputs.size(), nullptr, 0));
+	}
+	writer.flush();
+
+	/* Timing summary. */
+	std::cerr << std::setw(8) << "job" << std::setw(12) << "inputs" << std::setw(14) << "seconds" << std::endl;
+	for (std::size_t j = 0; j != results.size(); j++) {
+		std::cerr << std::setw(8) << j + 1 << std::setw(12) << jobs[j].inputs.size()
+			  << std::setw(14) << std::fixed << std::setprecision(6) << results[j].seconds << std::endl;
+		total += results[j].seconds;
+	}
+	const Systolic::Backend::SchedulerStats stats = Systolic::Backend::Scheduler::getInstance().getStats();
+
+	std::cerr << "jobs: " << results.size() << ", workers: " << runner.getWorkers()
+		  << ", job seconds: " << total << ", wall seconds: " << wall << std::endl
+		  << "tasks: " << stats.submitted << ", stolen: " << stats.stolen << ", withdrawn: " << stats.withdrawn
+		  << ", max queue depth: " << stats.maxQueueDepth << std::endl;
+	return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
 int main(int ac, char **av)
 {
 	(void) ac;
@@ -31,45 +175,279 @@ int main(int ac, char **av)
 		"OPTIONS:\r\n"
 		"  --with-x=[0-9]+(,[0-9]+, …)\r\n"
 		"  [--coefs=[0-9]+(,[0-9]+, …) | --equation=Cn*X^N(+Cn-1*X^N-1+…)\r\n"
+		"  --topology=[linear|tree] (linear by default)\r\n"
 		"  --verbose=[true|false] (false by default)\r\n"
+		"  --trace=file.json\r\n"
+		"  --type=[int32|int64|double|fixed] (int32 by default)\r\n"
+		"  --output-format=[comma|newline|csv|binary] (comma by default)\r\n"
+		"  --progress=[true|false] (false by default)\r\n"
+		"  --checkpoint=path [--checkpoint-steps=[0-9]+ (16 by default)]\r\n"
+		"  --pipeline=\"add N | mul N | div N | square | pow N | poly C… | dual C… | fir H… | mod M C…\"\r\n"
+		"  --pipeline-file=path, holding such stages, one per line or separated by |\r\n"
+		"  --save-pipeline=path, --load-pipeline=path instead of --coefs or --equation\r\n"
+		"  --cost-model=\"div=16, pow=4/1, …\" [--cost-inputs=[0-9]+ (the number of X by default)]\r\n"
+		"   analytic estimate of the cycles of the cells as hardware, the steps still taking one tick per cell\r\n"
+		"  --jobs-file=path, each line holding [--coefs=… | --equation=…] [--with-x=… | --with-x-file=path]\r\n"
+		"  --hash-file=path [--hash-window=[0-9]+ (64 by default) --hash-base=[0-9]+ (257 by default)\r\n"
+		"   --hash-modulus=[0-9]+ (2^61-1 by default) --reduction=[montgomery|barrett] (montgomery by default)]\r\n"
 		"  --about\r\n"
 		"  --help";
 	args["--about"] = "Systolic Simulator, made by Régis Berthelot, under the Apache 2.0 lisence.";
 	args["--coefs"] = "";
 	args["--equation"] = "";
 	args["--with-x"] = "";
+	args["--topology"] = "linear";
 	args["--verbose"] = "false";
+	args["--trace"] = "";
+	args["--type"] = "int32";
+	args["--output-format"] = "comma";
+	args["--progress"] = "false";
+	args["--checkpoint"] = "";
+	args["--checkpoint-steps"] = "16";
+	args["--pipeline"] = "";
+	args["--pipeline-file"] = "";
+	args["--save-pipeline"] = "";
+	args["--load-pipeline"] = "";
+	args["--cost-model"] = "";
+	args["--cost-inputs"] = "";
+	args["--jobs-file"] = "";
+	args["--hash-file"] = "";
+	args["--hash-window"] = "64";
+	args["--hash-base"] = "257";
+	args["--hash-modulus"] = "2305843009213693951";
+	args["--reduction"] = "montgomery";
 
 	/* Display info. Exit program if --help or --about was used. */
 	if (Util::Parser::displayInfo(args, av)) {
 		return EXIT_SUCCESS;
 	}
 
+	/* Default values, telling which options were given. */
+	const std::unordered_map<std::string, std::string> defaults = args;
+
 	/* Bad arguments were given. Reason printed by the setArgs function. */
 	if (!Util::Parser::setArgs(args, av)) { // Bad arguments were given.
 		return EXIT_FAILURE;
 	}
 
-	/* Declaring the container and settings its input to be the one given by the --with-x option. */
-	Systolic::Container sc3(Util::Parser::listToQueue(args["--with-x"]));
+	/* Hashing every window of a file, mapped in memory, when --hash-file is given. */
+	if (!args["--hash-file"].empty()) {
+		std::unique_ptr<Systolic::Backend::RollingHash> hash;
 
-	/* Using the builder to generate the polynomial cells from either the --coefs or --equation option. */
-	if (!args["--coefs"].empty()) {
-		sc3.setCells(Systolic::CellArrayBuilder::getNew()
-			     ->fromPolynomialCoefs(Util::Parser::listToQueue(args["--coefs"])));
+		if (!checkOptions(args, defaults, "--hash-file",
+				  {"--hash-file", "--hash-window", "--hash-base", "--hash-modulus", "--reduction", "--verbose"})) {
+			return EXIT_FAILURE;
+		}
+		try {
+			hash = std::make_unique<Systolic::Backend::RollingHash>(std::stoull(args["--hash-base"]), std::stoull(args["--hash-modulus"]),
+										std::stoull(args["--hash-window"]),
+										(args["--reduction"] == "barrett" ? Systolic::Backend::Reduction::Barrett
+										 : Systolic::Backend::Reduction::Montgomery));
+		} catch (const std::out_of_range &) {
+			std::cerr << "Err: --hash-window, --hash-base or --hash-modulus is out of range." << std::endl;
+			return EXIT_FAILURE;
+		} catch (const std::invalid_argument &e) { // Empty windows, or a modulus the reduction cannot use.
+			std::cerr << "Err: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		/* Displaying either the fingerprint of the whole file or the hash of every window depending on the --verbose option. */
+		if (args["--verbose"] == "true") {
+			return (hash->scanFile(args["--hash-file"], [](const std::size_t, const std::uint64_t *hashes, const std::size_t count) {
+						for (std::size_t i = 0; i != count; i++) {
+							std::cout << hashes[i] << std::endl;
+						}
+					}) ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+
+		Util::MappedFile file(args["--hash-file"]);
+
+		if (!file.isOpen()) {
+			std::cerr << "Err: Cannot map file " << args["--hash-file"] << "." << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::cout << "windows: " << hash->getHashCount(file.getSize()) << std::endl
+			  << "fingerprint: " << hash->fingerprint(file.getData(), file.getSize()) << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	/* Running every job of a file, several at once, when --jobs-file is given. */
+	if (!args["--jobs-file"].empty()) {
+		return (checkOptions(args, defaults, "--jobs-file", {"--jobs-file", "--output-format"}) ? runJobs(args) : EXIT_FAILURE);
+	}
+
+	/* Evaluating over wider integers, floating point or fixed-point numbers when --type is given. */
+	if (args["--type"] == "int64") {
+		return computeTyped<std::int64_t>(args, defaults);
+	} else if (args["--type"] == "double") {
+		return computeTyped<double>(args, defaults);
+	} else if (args["--type"] == "fixed") {
+		return computeTyped<Systolic::Backend::Q16>(args, defaults);
+	}
+
+	/* Using the builder to generate the cells from either the --coefs, --equation, --pipeline, --pipeline-file or --load-pipeline option. */
+	std::shared_ptr<Systolic::CellArrayBuilder> builder = Systolic::CellArrayBuilder::getNew();
+
+	if (!args["--pipeline-file"].empty()) {
+		Util::MappedFile file(args["--pipeline-file"]);
+
+		if (!file.isOpen()) {
+			std::cerr << "Err: Cannot map file " << args["--pipeline-file"] << "." << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (file.getSize() != 0) {
+			args["--pipeline"].assign(reinterpret_cast<const char *>(file.getData()), file.getSize());
+		}
+	}
+	if (!args["--pipeline"].empty() || !args["--pipeline-file"].empty()) {
+		try {
+			builder->fromPipelineDescription(args["--pipeline"]);
+		} catch (const std::invalid_argument &e) {
+			std::cerr << "Err: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+	} else if (!args["--load-pipeline"].empty()) {
+		try {
+			builder->fromPipelineFile(args["--load-pipeline"]);
+		} catch (const std::exception &e) { // Unreadable file, or cells it describes that cannot be built.
+			std::cerr << "Err: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+	} else if (!args["--coefs"].empty()) {
+		builder->fromPolynomialCoefs(Util::Parser::listToQueue(args["--coefs"]));
 	} else {
-		sc3.setCells(Systolic::CellArrayBuilder::getNew()
-			     ->fromPolynomialEquation(args["--equation"]));
+		builder->fromPolynomialEquation(args["--equation"]);
+	}
+
+	/* Saving the cells for later runs when --save-pipeline is given, which is all there is to do without --with-x. */
+	if (!args["--save-pipeline"].empty()) {
+		if (!builder->savePipeline(args["--save-pipeline"])) {
+			return EXIT_FAILURE;
+		}
+		if (args["--with-x"].empty() && args["--cost-model"].empty()) {
+			return EXIT_SUCCESS;
+		}
 	}
 
-	/* Running the systolic array until completion (output is filled and all cells are empty). */
-	sc3.compute();
+	/* Recording the activity of the cells on each step when --trace is given. */
+	std::shared_ptr<Systolic::Trace> trace = (args["--trace"].empty() ? nullptr : std::make_shared<Systolic::Trace>());
+
+	/* Writing the results in the layout given by --output-format, the values of X being kept for the CSV one. */
+	const std::queue<int> xs = Util::Parser::listToQueue(args["--with-x"]);
+	std::vector<int> xsList;
+	Util::OutputWriter writer(Util::OutputWriter::parseFormat(args["--output-format"]));
+
+	for (std::queue<int> copy = xs; !copy.empty(); copy.pop()) {
+		xsList.push_back(copy.front());
+	}
+
+	const Util::RingView<int> xsView(xsList.data(), xsList.size(), nullptr, 0);
+
+	/* Evaluating with an Estrin's scheme tree, which have a logarithmic latency. */
+	if (args["--topology"] == "tree") {
+		Systolic::TreeContainer tree(xs);
 
-	/* Displaying either only the result or the full graphic log depending on the --verbose option. */
+		if (!args["--checkpoint"].empty() || !args["--cost-model"].empty()) {
+			std::cerr << "Err: --checkpoint and --cost-model are only available with --topology=linear." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		try {
+			tree.setCells(builder);
+		} catch (const std::invalid_argument &e) { // Pipelines may hold other cells than polynomial ones.
+			std::cerr << "Err: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		tree.setTrace(trace);
+		tree.compute();
+		if (args["--verbose"] == "true") {
+			std::cout << tree.getLog();
+		} else {
+			writer.write(tree.getOutputView(), xsView);
+		}
+		return (trace == nullptr || trace->save(args["--trace"]) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	/* Declaring the container and settings its input to be the one given by the --with-x option. */
+	Systolic::Container sc3(xs);
+
+	sc3.setCells(builder);
+	sc3.setTrace(trace);
+
+	/* Estimating the cycles the cells would take as hardware, given the costs of --cost-model, instead of computing the outputs. */
+	if (!args["--cost-model"].empty()) {
+		try {
+			const Systolic::CostModel model = Systolic::CostModel::fromDescription(args["--cost-model"]);
+			const std::size_t inputs = (args["--cost-inputs"].empty() ? xs.size() : std::stoull(args["--cost-inputs"]));
+
+			std::cout << model.estimate(sc3.getCellCosts(model), inputs).getSummary();
+		} catch (const std::out_of_range &) {
+			std::cerr << "Err: --cost-inputs is out of range." << std::endl;
+			return EXIT_FAILURE;
+		} catch (const std::invalid_argument &e) {
+			std::cerr << "Err: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	/* Resuming from the checkpoint of --checkpoint if a previous run left one, then saving new ones as the run goes. */
+	const std::string checkpoint = args["--checkpoint"];
+
+	if (!checkpoint.empty()) {
+		if (std::ifstream(checkpoint).good()) {
+			if (!sc3.loadCheckpoint(checkpoint)) {
+				return EXIT_FAILURE;
+			}
+			std::cerr << "Resuming from checkpoint " << checkpoint << "." << std::endl;
+		}
+		sc3.setCheckpoints(checkpoint, std::stoull(args["--checkpoint-steps"]));
+	}
+
+	/*
+	 * Displaying either only the result or the full graphic log depending on the --verbose option.
+	 * Only the log and the trace need the systolic array to be run step by step until completion.
+	 */
 	if (args["--verbose"] == "true") {
+		sc3.compute();
 		std::cout << sc3.getLog();
+	} else if (trace != nullptr) {
+		sc3.compute();
+		writer.write(sc3.getOutputView(), xsView);
+	} else if (args["--progress"] == "true" || !checkpoint.empty()) {
+		/* Evaluating by tiles on the scheduler, reporting on the error output if asked, until done or interrupted. */
+		constexpr std::size_t tileSize = 1 << 16;
+		Systolic::ProgressCallback progress = nullptr;
+
+		if (args["--progress"] == "true") {
+			progress = [](const Systolic::ComputeProgress &progress, const std::vector<int> &) {
+				std::cerr << "\rProgress: " << progress.outputs << "/" << progress.total << " outputs, "
+					  << std::fixed << std::setprecision(3) << progress.seconds << " s, "
+					  << std::max(progress.eta, 0.0) << " s left" << std::flush;
+			};
+		}
+		std::signal(SIGINT, interrupt);
+
+		const bool done = sc3.computeAsync(progress, interruption, tileSize).get();
+
+		if (progress != nullptr) {
+			std::cerr << std::endl;
+		}
+		writer.write(sc3.getOutputView(), xsView);
+		if (!done) {
+			const std::string saved = (sc3.getCheckpointFailures() == 0 ? "" : ", as of the last one saved,");
+
+			std::cerr << "Err: Interrupted, only the outputs computed so far were written"
+				  << (checkpoint.empty() ? "." : ", the run resuming from " + checkpoint + saved + " next time.") << std::endl;
+			return EXIT_FAILURE;
+		}
 	} else {
-		sc3.dumpOutputs();
+		sc3.computeBatch();
+		writer.write(sc3.getOutputView(), xsView);
 	}
-	return EXIT_SUCCESS;
+	if (!checkpoint.empty()) { // The run is complete, so that the next one must start over.
+		std::remove(checkpoint.c_str());
+		std::remove((checkpoint + ".out").c_str());
+	}
+	return (trace == nullptr || trace->save(args["--trace"]) ? EXIT_SUCCESS : EXIT_FAILURE);
 }